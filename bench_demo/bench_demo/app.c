@@ -0,0 +1,506 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <los_task.h>
+#include <los_sem.h>
+#include <los_queue.h>
+#include <los_interrupt.h>
+#include <los_tick.h>
+
+#include <ohos_init.h>
+#include <ohos_types.h>
+
+#include <hiview_log.h>
+
+#include "cycle_prof.h"
+#if TELINK_BENCH_GPIO_ENABLE
+#include <board_config.h>
+#include <drivers.h>
+#include <gpio_if.h>
+
+#include "gpio_evt.h"
+#include "gpio_fast.h"
+#endif /* TELINK_BENCH_GPIO_ENABLE */
+#if TELINK_BENCH_TOKEN_ENABLE
+#include "token_flash_b91.h"
+#include "token_store.h"
+#endif /* TELINK_BENCH_TOKEN_ENABLE */
+
+#define BENCH_TASK_PRIORITY (OS_TASK_PRIORITY_LOWEST - 2)
+/* Peers run one level above the bench task, so waking one switches to it immediately */
+#define PEER_TASK_PRIORITY  (BENCH_TASK_PRIORITY - 1)
+
+#define BENCH_ITERATIONS       TELINK_BENCH_ITERATIONS
+/* Delays and log lines take real time, they get fewer samples to keep the run short */
+#define BENCH_DELAY_ITERATIONS 100
+#define BENCH_LOG_ITERATIONS   100
+#define BENCH_TOKEN_LOAD_ITERATIONS  100
+/* Every token write erases a flash sector */
+#define BENCH_TOKEN_WRITE_ITERATIONS 8
+#define BENCH_TOKEN_LEN        151
+
+#define BENCH_NO_TASK 0xFFFFFFFF
+
+typedef enum {
+    BENCH_EMPTY,
+    BENCH_YIELD_SWITCH,
+    BENCH_SEM_WAKE_SWITCH,
+    BENCH_SEM_ROUND_TRIP,
+    BENCH_QUEUE_ROUND_TRIP,
+    BENCH_TASK_DELAY_1,
+    BENCH_TASK_DELAY_10,
+    BENCH_MSLEEP_1,
+    BENCH_MSLEEP_10,
+    BENCH_HILOG,
+    BENCH_GPIO_WRITE,
+    BENCH_GPIO_FAST_WRITE,
+    BENCH_GPIO_FAST_TOGGLE,
+    BENCH_GPIO_EVT_ISR,
+    BENCH_GPIO_EVT_EDGE,
+    BENCH_TOKEN_LOAD,
+    BENCH_TOKEN_READ,
+    BENCH_TOKEN_WRITE,
+    BENCH_COUNT,
+} BenchId;
+
+static CycleProfPoint g_bench[BENCH_COUNT] = {
+    [BENCH_EMPTY] = {.name = "empty"},
+    [BENCH_YIELD_SWITCH] = {.name = "yield_switch"},
+    [BENCH_SEM_WAKE_SWITCH] = {.name = "sem_wake_switch"},
+    [BENCH_SEM_ROUND_TRIP] = {.name = "sem_round_trip"},
+    [BENCH_QUEUE_ROUND_TRIP] = {.name = "queue_round_trip"},
+    [BENCH_TASK_DELAY_1] = {.name = "task_delay_1"},
+    [BENCH_TASK_DELAY_10] = {.name = "task_delay_10"},
+    [BENCH_MSLEEP_1] = {.name = "msleep_1"},
+    [BENCH_MSLEEP_10] = {.name = "msleep_10"},
+    [BENCH_HILOG] = {.name = "hilog"},
+    [BENCH_GPIO_WRITE] = {.name = "gpio_write"},
+    [BENCH_GPIO_FAST_WRITE] = {.name = "gpio_fast_write"},
+    [BENCH_GPIO_FAST_TOGGLE] = {.name = "gpio_fast_toggle"},
+    [BENCH_GPIO_EVT_ISR] = {.name = "gpio_evt_isr"},
+    [BENCH_GPIO_EVT_EDGE] = {.name = "gpio_evt_edge"},
+    [BENCH_TOKEN_LOAD] = {.name = "token_load"},
+    [BENCH_TOKEN_READ] = {.name = "token_read"},
+    [BENCH_TOKEN_WRITE] = {.name = "token_write"},
+};
+
+static struct {
+    UINT32 request;
+    UINT32 response;
+    volatile UINT32 stamp;
+    volatile UINT32 stampTask;
+    volatile BOOL stop;
+} g_benchCtx;
+
+static UINT32 BenchTaskCreate(TSK_ENTRY_FUNC entry, CHAR *name, UINT16 prio)
+{
+    UINT32 taskId = 0;
+    TSK_INIT_PARAM_S taskParam = {0};
+    taskParam.pfnTaskEntry = entry;
+    taskParam.uwArg = 0;
+    taskParam.uwStackSize = LOSCFG_BASE_CORE_TSK_DEFAULT_STACK_SIZE;
+    taskParam.pcName = name;
+    taskParam.usTaskPrio = prio;
+
+    UINT32 ret = LOS_TaskCreate(&taskId, &taskParam);
+    if (ret != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "ret of LOS_TaskCreate(%s) = %#x", name, ret);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Cost of the measurement itself, to be subtracted from the other results
+ */
+static void BenchEmpty(void)
+{
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        CycleProfRecord(&g_bench[BENCH_EMPTY], CycleProfNow() - start);
+    }
+}
+
+/**
+ * @brief       Run by two tasks of the same priority, each measures the switch from the other one
+ */
+STATIC VOID BenchYieldLoop(VOID)
+{
+    UINT32 self = LOS_CurTaskIDGet();
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        UINT32 now = CycleProfNow();
+        /* A yield with no other task ready returns to the caller, only a stamp of the other task is a switch */
+        if (g_benchCtx.stampTask != self && g_benchCtx.stampTask != BENCH_NO_TASK) {
+            CycleProfRecord(&g_bench[BENCH_YIELD_SWITCH], now - g_benchCtx.stamp);
+        }
+
+        g_benchCtx.stampTask = self;
+        g_benchCtx.stamp = CycleProfNow();
+        LOS_TaskYield();
+    }
+}
+
+STATIC VOID BenchYieldPeer(VOID)
+{
+    BenchYieldLoop();
+    LOS_SemPost(g_benchCtx.response);
+}
+
+static void BenchYield(void)
+{
+    if (LOS_SemCreate(0, &g_benchCtx.response) != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "LOS_SemCreate() failed");
+        return;
+    }
+
+    g_benchCtx.stampTask = BENCH_NO_TASK;
+    if (BenchTaskCreate((TSK_ENTRY_FUNC)BenchYieldPeer, "BenchYieldPeer", BENCH_TASK_PRIORITY) == LOS_OK) {
+        BenchYieldLoop();
+        LOS_SemPend(g_benchCtx.response, LOS_WAIT_FOREVER);
+    }
+
+    LOS_SemDelete(g_benchCtx.response);
+}
+
+STATIC VOID BenchSemPeer(VOID)
+{
+    while (LOS_SemPend(g_benchCtx.request, LOS_WAIT_FOREVER) == LOS_OK && !g_benchCtx.stop) {
+        CycleProfRecord(&g_bench[BENCH_SEM_WAKE_SWITCH], CycleProfNow() - g_benchCtx.stamp);
+        LOS_SemPost(g_benchCtx.response);
+    }
+}
+
+/**
+ * @brief       Post to a higher priority peer and wait for its answer. The peer measures
+ *              the wake-up switch, the bench task the whole round trip.
+ */
+static void BenchSem(void)
+{
+    if (LOS_SemCreate(0, &g_benchCtx.request) != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "LOS_SemCreate() failed");
+        return;
+    }
+
+    if (LOS_SemCreate(0, &g_benchCtx.response) != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "LOS_SemCreate() failed");
+        LOS_SemDelete(g_benchCtx.request);
+        return;
+    }
+
+    g_benchCtx.stop = FALSE;
+    if (BenchTaskCreate((TSK_ENTRY_FUNC)BenchSemPeer, "BenchSemPeer", PEER_TASK_PRIORITY) == LOS_OK) {
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            UINT32 start = CycleProfNow();
+            g_benchCtx.stamp = start;
+            LOS_SemPost(g_benchCtx.request);
+            LOS_SemPend(g_benchCtx.response, LOS_WAIT_FOREVER);
+            CycleProfRecord(&g_bench[BENCH_SEM_ROUND_TRIP], CycleProfNow() - start);
+        }
+
+        /* The peer has the higher priority, it is gone when the post returns */
+        g_benchCtx.stop = TRUE;
+        LOS_SemPost(g_benchCtx.request);
+    }
+
+    LOS_SemDelete(g_benchCtx.response);
+    LOS_SemDelete(g_benchCtx.request);
+}
+
+STATIC VOID BenchQueuePeer(VOID)
+{
+    UINT32 msg;
+    UINT32 size = sizeof(msg);
+
+    while (LOS_QueueReadCopy(g_benchCtx.request, &msg, &size, LOS_WAIT_FOREVER) == LOS_OK && !g_benchCtx.stop) {
+        LOS_QueueWriteCopy(g_benchCtx.response, &msg, sizeof(msg), 0);
+        size = sizeof(msg);
+    }
+}
+
+/**
+ * @brief       Same as BenchSem() with a 4 byte message copied through two queues
+ */
+static void BenchQueue(void)
+{
+    if (LOS_QueueCreate("BenchRequest", 1, &g_benchCtx.request, 0, sizeof(UINT32)) != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "LOS_QueueCreate() failed");
+        return;
+    }
+
+    if (LOS_QueueCreate("BenchResponse", 1, &g_benchCtx.response, 0, sizeof(UINT32)) != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "LOS_QueueCreate() failed");
+        LOS_QueueDelete(g_benchCtx.request);
+        return;
+    }
+
+    g_benchCtx.stop = FALSE;
+    if (BenchTaskCreate((TSK_ENTRY_FUNC)BenchQueuePeer, "BenchQueuePeer", PEER_TASK_PRIORITY) == LOS_OK) {
+        for (UINT32 i = 0; i < BENCH_ITERATIONS; i++) {
+            UINT32 msg = i;
+            UINT32 size = sizeof(msg);
+            UINT32 start = CycleProfNow();
+            LOS_QueueWriteCopy(g_benchCtx.request, &msg, sizeof(msg), LOS_WAIT_FOREVER);
+            LOS_QueueReadCopy(g_benchCtx.response, &msg, &size, LOS_WAIT_FOREVER);
+            CycleProfRecord(&g_bench[BENCH_QUEUE_ROUND_TRIP], CycleProfNow() - start);
+        }
+
+        g_benchCtx.stop = TRUE;
+        UINT32 msg = 0;
+        LOS_QueueWriteCopy(g_benchCtx.request, &msg, sizeof(msg), LOS_WAIT_FOREVER);
+    }
+
+    LOS_QueueDelete(g_benchCtx.response);
+    LOS_QueueDelete(g_benchCtx.request);
+}
+
+/**
+ * @brief       Time blocking delays. They start anywhere within a tick, so the spread
+ *              between min and max is the tick granularity plus the wake-up jitter.
+ */
+static void BenchDelays(void)
+{
+    for (int i = 0; i < BENCH_DELAY_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        LOS_TaskDelay(1);
+        CycleProfRecord(&g_bench[BENCH_TASK_DELAY_1], CycleProfNow() - start);
+
+        start = CycleProfNow();
+        LOS_TaskDelay(10);
+        CycleProfRecord(&g_bench[BENCH_TASK_DELAY_10], CycleProfNow() - start);
+
+        start = CycleProfNow();
+        LOS_Msleep(1);
+        CycleProfRecord(&g_bench[BENCH_MSLEEP_1], CycleProfNow() - start);
+
+        start = CycleProfNow();
+        LOS_Msleep(10);
+        CycleProfRecord(&g_bench[BENCH_MSLEEP_10], CycleProfNow() - start);
+    }
+}
+
+static void BenchHilog(void)
+{
+    for (int i = 0; i < BENCH_LOG_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        HILOG_INFO(HILOG_MODULE_APP, "bench %d", i);
+        CycleProfRecord(&g_bench[BENCH_HILOG], CycleProfNow() - start);
+    }
+}
+
+#if TELINK_BENCH_GPIO_ENABLE
+static void BenchGpio(void)
+{
+    GpioSetDir(LED_BLUE_HDF, GPIO_DIR_OUT);
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        GpioWrite(LED_BLUE_HDF, (i & 1) ? GPIO_VAL_HIGH : GPIO_VAL_LOW);
+        CycleProfRecord(&g_bench[BENCH_GPIO_WRITE], CycleProfNow() - start);
+    }
+
+    /* Same pin through the resolved register, per toggle against the HDF dispatch above */
+    GpioFast led;
+    if (!GpioFastInit(&led, LED_BLUE_HDF)) {
+        HILOG_WARN(HILOG_MODULE_APP, "LED_BLUE_HDF has no register mapping, gpio_fast falls back to HDF");
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        GpioFastWrite(&led, (i & 1) ? GPIO_VAL_HIGH : GPIO_VAL_LOW);
+        CycleProfRecord(&g_bench[BENCH_GPIO_FAST_WRITE], CycleProfNow() - start);
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        GpioFastToggle(&led);
+        CycleProfRecord(&g_bench[BENCH_GPIO_FAST_TOGGLE], CycleProfNow() - start);
+    }
+}
+
+/**
+ * @brief       GPIO event capture with the consumer task running, so every edge takes the real wake
+ *              path: gpio_evt_isr is the interrupt handler called with interrupts locked, as in IRQ
+ *              context, including the LOS_EventWrite() to the consumer. gpio_evt_edge is one whole
+ *              edge, from the handler until the consumer has taken the edge from the ring and gone
+ *              back to sleep. The sustained maximum edge rate is then measured by pushing edges back
+ *              to back for one second.
+ */
+static void BenchGpioEvt(void)
+{
+    GpioEvtStats before;
+    GpioEvtStats after;
+
+    GpioEvtInit();
+    if (GpioEvtAddPin(SW1_3_GPIO_HDF, 0) != 0) {
+        HILOG_ERROR(HILOG_MODULE_APP, "GpioEvtAddPin(SW1_3_GPIO_HDF) failed");
+        return;
+    }
+    /* Above the bench task: the wake switches to the consumer as soon as interrupts are restored */
+    if (GpioEvtStart(PEER_TASK_PRIORITY, LOSCFG_BASE_CORE_TSK_DEFAULT_STACK_SIZE) != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "GpioEvtStart() failed");
+        return;
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        UINT32 intSave = LOS_IntLock();
+        (void)GpioEvtIsr(SW1_3_GPIO_HDF, NULL);
+        CycleProfRecord(&g_bench[BENCH_GPIO_EVT_ISR], CycleProfNow() - start);
+        LOS_IntRestore(intSave);
+        CycleProfRecord(&g_bench[BENCH_GPIO_EVT_EDGE], CycleProfNow() - start);
+    }
+
+    GpioEvtGetStats(&before);
+    UINT32 edges = 0;
+    UINT64 end = LOS_TickCountGet() + LOSCFG_BASE_CORE_TICK_PER_SECOND;
+    while (LOS_TickCountGet() < end) {
+        UINT32 intSave = LOS_IntLock();
+        (void)GpioEvtIsr(SW1_3_GPIO_HDF, NULL);
+        LOS_IntRestore(intSave);
+        edges++;
+    }
+    GpioEvtGetStats(&after);
+
+    /* Only edges the consumer really took from the ring count towards the rate */
+    UINT32 consumed = after.edges - before.edges;
+    UINT32 dropped = after.drops - before.drops;
+    HILOG_INFO(HILOG_MODULE_APP, "gpio_evt: %u edges/s sustained, %u injected, %u dropped",
+               (unsigned)consumed, (unsigned)edges, (unsigned)dropped);
+    if (consumed != edges) {
+        HILOG_WARN(HILOG_MODULE_APP, "gpio_evt: %u edges/s injected, more than the consumer can take",
+                   (unsigned)edges);
+    }
+}
+#endif /* TELINK_BENCH_GPIO_ENABLE */
+
+#if TELINK_BENCH_TOKEN_ENABLE
+/**
+ * @brief       Token store latency on a scratch store in the bench sectors, so the provisioned token
+ *              is never touched: token_write is TokenStoreWrite(), i.e. erase, program and verify of a
+ *              sector, token_load reads both sectors back and token_read is served from the RAM copy.
+ */
+static void BenchToken(void)
+{
+    static char token[BENCH_TOKEN_LEN];
+    static TokenFlash flash;
+    static TokenStore store;
+
+    if (TokenFlashB91Init(&flash, TELINK_BENCH_TOKEN_FLASH_ADDR_A, TELINK_BENCH_TOKEN_FLASH_ADDR_B) != 0 ||
+        TokenStoreInit(&store, &flash) != TOKEN_STORE_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "bench token sectors rejected, token benches skipped");
+        return;
+    }
+
+    for (int i = 0; i < BENCH_TOKEN_LEN; i++) {
+        token[i] = (char)('a' + i % 26);
+    }
+
+    for (int i = 0; i < BENCH_TOKEN_WRITE_ITERATIONS; i++) {
+        token[0] = (char)('A' + i);
+        UINT32 start = CycleProfNow();
+        int ret = TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, token, sizeof(token));
+        CycleProfRecord(&g_bench[BENCH_TOKEN_WRITE], CycleProfNow() - start);
+        if (ret != TOKEN_STORE_OK) {
+            HILOG_ERROR(HILOG_MODULE_APP, "ret of TokenStoreWrite() = %d", ret);
+            return;
+        }
+    }
+
+    for (int i = 0; i < BENCH_TOKEN_LOAD_ITERATIONS; i++) {
+        TokenStoreInvalidate(&store);
+        UINT32 start = CycleProfNow();
+        (void)TokenStoreRead(&store, TOKEN_SLOT_TOKEN, token, sizeof(token));
+        CycleProfRecord(&g_bench[BENCH_TOKEN_LOAD], CycleProfNow() - start);
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        UINT32 start = CycleProfNow();
+        (void)TokenStoreRead(&store, TOKEN_SLOT_TOKEN, token, sizeof(token));
+        CycleProfRecord(&g_bench[BENCH_TOKEN_READ], CycleProfNow() - start);
+    }
+}
+#endif /* TELINK_BENCH_TOKEN_ENABLE */
+
+/**
+ * @brief       Cycles of one kernel tick, relates the cycle counts to time
+ */
+static UINT32 BenchCyclesPerTick(void)
+{
+    /* Start on a tick boundary */
+    LOS_TaskDelay(1);
+
+    UINT32 start = CycleProfNow();
+    LOS_TaskDelay(LOSCFG_BASE_CORE_TICK_PER_SECOND);
+
+    return (CycleProfNow() - start) / LOSCFG_BASE_CORE_TICK_PER_SECOND;
+}
+
+/**
+ * @brief       Print the results for bench_compare.py:
+ *              BENCH,begin,<ticks per second>,<cycles per tick>
+ *              BENCH,<name>,<count>,<min>,<avg>,<max>   all in CPU cycles
+ *              BENCH,end
+ */
+static void BenchReport(UINT32 cyclesPerTick)
+{
+    printf("BENCH,begin,%u,%" PRIu32 "\r\n", (unsigned)LOSCFG_BASE_CORE_TICK_PER_SECOND, (uint32_t)cyclesPerTick);
+
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        const CycleProfPoint *point = &g_bench[i];
+        printf("BENCH,%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\r\n", point->name, point->count,
+               point->min, CycleProfAvg(point), point->max);
+    }
+
+    printf("BENCH,end\r\n");
+}
+
+STATIC VOID BenchTask(VOID)
+{
+    /* Let the boot output finish, it would otherwise land in the first measurements */
+    LOS_TaskDelay(LOSCFG_BASE_CORE_TICK_PER_SECOND);
+
+    UINT32 cyclesPerTick = BenchCyclesPerTick();
+
+    BenchEmpty();
+    BenchYield();
+    BenchSem();
+    BenchQueue();
+    BenchDelays();
+    BenchHilog();
+#if TELINK_BENCH_GPIO_ENABLE
+    BenchGpio();
+    BenchGpioEvt();
+#endif /* TELINK_BENCH_GPIO_ENABLE */
+#if TELINK_BENCH_TOKEN_ENABLE
+    BenchToken();
+#endif /* TELINK_BENCH_TOKEN_ENABLE */
+
+    BenchReport(cyclesPerTick);
+}
+
+void AppMain(void)
+{
+    BenchTaskCreate((TSK_ENTRY_FUNC)BenchTask, "BenchTask", BENCH_TASK_PRIORITY);
+}
+
+SYS_RUN(AppMain);
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+# All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Compare bench_demo results against a baseline run.
+
+The bench_demo firmware prints one BENCH line per measurement and stops after
+"BENCH,end". Save the output of a known good kernel as the baseline, for example
+from QEMU, with the image of the bench_demo_qemu product:
+
+    qemu-system-riscv32 -machine virt -nographic -kernel <image> | tee baseline.log
+
+and later compare a new run with it, reading from a file or straight from QEMU:
+
+    qemu-system-riscv32 ... | python3 bench_compare.py baseline.log
+
+Average cycles are compared. The exit status is 1 when any result got slower
+by more than the threshold. Only the standard library is used.
+"""
+
+import argparse
+import re
+import sys
+
+BEGIN_LINE = re.compile(r"BENCH,begin,(\d+),(\d+)")
+RESULT_LINE = re.compile(r"BENCH,(\w+),(\d+),(\d+),(\d+),(\d+)")
+END_LINE = "BENCH,end"
+
+
+def parse(lines):
+    """Return (cycles per microsecond, {name: (count, min, avg, max)}) of the last complete run."""
+    run = None
+    cycles_per_us = 0.0
+    results = {}
+    for line in lines:
+        match = BEGIN_LINE.search(line)
+        if match:
+            cycles_per_us = int(match.group(1)) * int(match.group(2)) / 1e6
+            results = {}
+            continue
+        if END_LINE in line:
+            run = (cycles_per_us, results)
+            # stdin may be a QEMU that never exits
+            if lines is sys.stdin:
+                break
+            continue
+        match = RESULT_LINE.search(line)
+        if match:
+            results[match.group(1)] = tuple(int(v) for v in match.groups()[1:])
+    if run is None:
+        sys.exit("no complete BENCH run found")
+    return run
+
+
+def read(path):
+    if path is None or path == "-":
+        return parse(sys.stdin)
+    with open(path, errors="replace") as f:
+        return parse(f)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="log of the reference run")
+    parser.add_argument("current", nargs="?", help="log of the run to check, stdin if omitted")
+    parser.add_argument("-t", "--threshold", type=float, default=10.0, help="allowed slowdown in percent")
+    args = parser.parse_args()
+
+    _, base = read(args.baseline)
+    cycles_per_us, current = read(args.current)
+    us_per_cycle = 1.0 / cycles_per_us if cycles_per_us else 0.0
+
+    regressions = 0
+    print("%-18s %10s %10s %10s %8s" % ("name", "base avg", "avg", "avg us", "change"))
+    for name, (count, _, avg, _) in current.items():
+        if count == 0:
+            continue
+        line = "%-18s %10s %10d %10.2f" % (name, "-", avg, avg * us_per_cycle)
+        if name in base and base[name][2]:
+            change = (avg - base[name][2]) * 100.0 / base[name][2]
+            line = "%-18s %10d %10d %10.2f %+7.1f%%" % (name, base[name][2], avg, avg * us_per_cycle, change)
+            if change > args.threshold:
+                line += "  REGRESSION"
+                regressions += 1
+        print(line)
+
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -27,26 +27,36 @@
 
 #include <board_config.h>
 
+#include "gpio_fast.h"
+
 #include "app_config.h"
 #include "app.h"
+#include "app_adv.h"
 #include "app_att.h"
+#include "app_buffer.h"
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+#include "app_bench.h"
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+#include "ble_log.h"
+#include "ble_trace.h"
 
 #include "uni_ble.h"
-
-#define ACL_CONN_MAX_RX_OCTETS    27
-#define ACL_CONN_MAX_TX_OCTETS    27
-#define ACL_TX_FIFO_SIZE          48
-#define ACL_TX_FIFO_NUM           17
-#define ACL_RX_FIFO_SIZE          48
-#define ACL_RX_FIFO_NUM           8
-
-#define ATT_MTU_SLAVE_RX_MAX_SIZE   23
-#define	MTU_S_BUFF_SIZE_MAX			CAL_MTU_BUFF_SIZE(ATT_MTU_SLAVE_RX_MAX_SIZE)
-
-#if TELINK_SDK_B91_BLE_SINGLE
-#undef SLAVE_MAX_NUM
-#define SLAVE_MAX_NUM 1
-#endif /* TELINK_SDK_B91_BLE_SINGLE */
+#include "uni_ble_conn_param.h"
+#include "uni_ble_phy.h"
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+#include "uni_ble_notify.h"
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE
+#include "uni_ble_diag.h"
+#endif /* TELINK_BLE_DIAG_ENABLE */
+#include "uni_ble_prof.h"
+
+/* Wake-to-advertising latency of the last boot or wake-up, see AppWakeLatencyReport() */
+static struct {
+    u32 wakeTick;
+    u8 retention;
+    u8 reported;
+} g_app_wake;
 
 /**
  * @brief  This function do initialization of BLE advertisement
@@ -68,16 +78,6 @@ static ble_sts_t AppBleAdvInit(void)
         0x08, 0x09, 'e', 'S', 'a', 'm', 'p', 'l', 'e',
     };
 
-    status = uni_ble_ll_setAdvParam(ADV_INTERVAL_30MS, ADV_INTERVAL_35MS,
-                                    ADV_TYPE_CONNECTABLE_UNDIRECTED, OWN_ADDRESS_PUBLIC,
-                                    0,  NULL,
-                                    BLT_ENABLE_ADV_ALL,
-                                    ADV_FP_NONE);
-    if (status != BLE_SUCCESS) {
-        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_setAdvParam(): %d", status);
-        return status;
-    }
-
     status = uni_ble_ll_setAdvData((u8 *)tbl_advData, sizeof(tbl_advData));
     if (status != BLE_SUCCESS) {
         HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_setAdvData(): %d", status);
@@ -90,23 +90,80 @@ static ble_sts_t AppBleAdvInit(void)
         return status;
     }
 
-    status = uni_ble_ll_setAdvEnable(BLC_ADV_ENABLE); // Advertising enable
+    /* Advertising parameters and enable are handled by the advertising scheduler */
+    status = AppAdvInit(sizeof(tbl_advData), sizeof(tbl_scanRsp));
     if (status != BLE_SUCCESS) {
-        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_setAdvEnable(): %d", status);
+        HILOG_ERROR(HILOG_MODULE_APP, "AppAdvInit(): %d", status);
         return status;
     }
 
     return status;
 }
 
-static void connect(void)
+/**
+ * @brief  Start Data Length and ATT MTU exchange with the peer, so that a notification
+ *         can carry up to (ATT_MTU_SLAVE_RX_MAX_SIZE - 3) bytes in a single LL packet
+ * @param  connHandle connection handle
+ * @return none
+ */
+static void AppBleStartThroughputExchange(u16 connHandle)
 {
-    GpioWrite(LED_WHITE_HDF, GPIO_VAL_HIGH);
+#if TELINK_BLE_HIGH_THROUGHPUT_ENABLE
+    ble_sts_t status = uni_ble_ll_exchangeDataLength(connHandle, ACL_CONN_MAX_TX_OCTETS);
+    if (status != BLE_SUCCESS) {
+        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_exchangeDataLength(): %d", status);
+    }
+
+    status = uni_ble_att_requestMtuSizeExchange(connHandle, ATT_MTU_SLAVE_RX_MAX_SIZE);
+    if (status != BLE_SUCCESS) {
+        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_att_requestMtuSizeExchange(): %d", status);
+    }
+#else
+    UNUSED(connHandle);
+#endif /* TELINK_BLE_HIGH_THROUGHPUT_ENABLE */
 }
 
-static void disconnect(void)
+/* Connection LED, written from the connect and disconnect callbacks */
+UNI_BLE_RETENTION_DATA static GpioFast g_ledWhite;
+
+static void connect(const uni_ble_conn_info_t *conn)
 {
-    GpioWrite(LED_WHITE_HDF, GPIO_VAL_LOW);
+    BLE_LOG(BLE_LOG_CONNECT, conn->connHandle, conn->role, conn->interval);
+
+    GpioFastWrite(&g_ledWhite, GPIO_VAL_HIGH);
+
+    AppBleStartThroughputExchange(conn->connHandle);
+
+    AppAdvOnConnect();
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+    AppBenchOnConnect(conn->connHandle);
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+}
+
+static void disconnect(const uni_ble_conn_info_t *conn, u8 reason)
+{
+    BLE_LOG(BLE_LOG_DISCONNECT, conn->connHandle, reason);
+
+    /* LED stays on while any link is up */
+    if (uni_ble_get_conn_count() == 0) {
+        GpioFastWrite(&g_ledWhite, GPIO_VAL_LOW);
+    }
+
+    AppAdvOnDisconnect();
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+    AppBenchOnDisconnect(conn->connHandle);
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+}
+
+static void conn_update(const uni_ble_conn_info_t *conn)
+{
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+    AppBenchOnConnUpdate(conn->connHandle);
+#else
+    UNUSED(conn);
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
 }
 
 /**
@@ -117,10 +174,16 @@ static void disconnect(void)
 static ble_sts_t AppBleConnInit(void)
 {
     ble_sts_t status = BLE_SUCCESS;
-    static u8 rxFufoBuff[ACL_RX_FIFO_SIZE * ACL_RX_FIFO_NUM] = {0};
-    static u8 txFifoBuff[ACL_TX_FIFO_SIZE * ACL_TX_FIFO_NUM * SLAVE_MAX_NUM] = {0};
+    UNI_BLE_RETENTION_DATA static u8 rxFufoBuff[APP_BLE_RX_FIFO_RAM] = {0};
+    UNI_BLE_RETENTION_DATA static u8 txFifoBuff[APP_BLE_TX_FIFO_RAM] = {0};
+
+    status = uni_ble_ll_setAclConnMaxOctetsNumber(ACL_CONN_MAX_RX_OCTETS, ACL_CONN_MAX_TX_OCTETS);
+    if (status != BLE_SUCCESS) {
+        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_setAclConnMaxOctetsNumber(): %d", status);
+        return status;
+    }
 
-    status = uni_ble_ll_initAclConnTxFifo(txFifoBuff, ACL_TX_FIFO_SIZE, ACL_TX_FIFO_NUM, SLAVE_MAX_NUM);
+    status = uni_ble_ll_initAclConnTxFifo(txFifoBuff, ACL_TX_FIFO_SIZE, ACL_TX_FIFO_NUM, UNI_BLE_MAX_CONN);
     if (status != BLE_SUCCESS) {
         HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_initAclConnTxFifo(): %d", status);
         return status;
@@ -139,7 +202,7 @@ static ble_sts_t AppBleConnInit(void)
     }
 
 #if TELINK_SDK_B91_BLE_MULTI
-    status = blc_ll_setMaxConnectionNumber(MASTER_MAX_NUM, SLAVE_MAX_NUM);
+    status = blc_ll_setMaxConnectionNumber(MASTER_MAX_NUM, UNI_BLE_MAX_CONN);
     if (status != BLE_SUCCESS) {
         HILOG_ERROR(HILOG_MODULE_APP, "blc_ll_setMaxConnectionNumber(): %d", status);
         return status;
@@ -149,23 +212,79 @@ static ble_sts_t AppBleConnInit(void)
     /* GAP initialization must be done before any other host feature initialization !!! */
     uni_ble_init();
 
-#if TELINK_SDK_B91_BLE_MULTI
+    status = uni_ble_att_setRxMtuSize(ATT_MTU_SLAVE_RX_MAX_SIZE);
+    if (status != BLE_SUCCESS) {
+        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_att_setRxMtuSize(): %d", status);
+        return status;
+    }
+
     /* ACL connection L2CAP layer MTU TX & RX data FIFO allocation, Begin */
-    static u8 mtu_s_rx_fifo[SLAVE_MAX_NUM * MTU_S_BUFF_SIZE_MAX];
-    static u8 mtu_s_tx_fifo[SLAVE_MAX_NUM * MTU_S_BUFF_SIZE_MAX];
+    UNI_BLE_RETENTION_DATA static u8 mtu_s_rx_fifo[UNI_BLE_MAX_CONN * MTU_S_BUFF_SIZE_MAX];
+    UNI_BLE_RETENTION_DATA static u8 mtu_s_tx_fifo[UNI_BLE_MAX_CONN * MTU_S_BUFF_SIZE_MAX];
     /* ACL connection L2CAP layer MTU TX & RX data FIFO allocation, End */
 
     /* L2CAP buffer initialization */
-    blc_l2cap_initAclConnSlaveMtuBuffer(mtu_s_rx_fifo, MTU_S_BUFF_SIZE_MAX, mtu_s_tx_fifo, MTU_S_BUFF_SIZE_MAX);
-#endif /* TELINK_SDK_B91_BLE_MULTI */
+    uni_ble_l2cap_initMtuBuffer(mtu_s_rx_fifo, MTU_S_BUFF_SIZE_MAX, mtu_s_tx_fifo, MTU_S_BUFF_SIZE_MAX);
+
+    HILOG_INFO(HILOG_MODULE_APP, "BLE RAM: rx fifo %u, tx fifo %u, mtu %u, total %u bytes for %u links",
+               (unsigned)APP_BLE_RX_FIFO_RAM, (unsigned)APP_BLE_TX_FIFO_RAM, (unsigned)APP_BLE_MTU_RAM,
+               (unsigned)APP_BLE_RAM_TOTAL, (unsigned)UNI_BLE_MAX_CONN);
 
     AppBleGattInit();
 
     uni_ble_l2cap_register_data_handler();
 
     GpioSetDir(LED_WHITE_HDF, GPIO_DIR_OUT);
+    GpioFastInit(&g_ledWhite, LED_WHITE_HDF);
 
     uni_ble_register_connect_disconnect_cb(connect, disconnect);
+    uni_ble_register_conn_update_cb(conn_update);
+
+#if TELINK_BLE_CONN_POLICY_ENABLE
+    static const uni_ble_conn_policy_t connPolicy = {
+        .activeIntervalMin = 6,     // 7.5 ms
+        .activeIntervalMax = 12,    // 15 ms
+        .activeLatency = 0,
+        .idleIntervalMin = 80,      // 100 ms
+        .idleIntervalMax = 100,     // 125 ms
+        .idleLatency = 4,
+        .timeout = 400,             // 4 s
+        .idleAfterMs = TELINK_BLE_CONN_IDLE_AFTER_MS,
+        .retryMs = 5000,
+    };
+    uni_ble_conn_policy_init(&connPolicy);
+#endif /* TELINK_BLE_CONN_POLICY_ENABLE */
+
+#if TELINK_BLE_PHY_POLICY_ENABLE
+    static const uni_ble_phy_policy_t phyPolicy = {
+        .codedBelowDbm = -85,
+        .codedExitAboveDbm = -75,
+        .fastAboveDbm = -70,
+        .sampleMs = 500,
+        .retryMs = 5000,
+    };
+    uni_ble_phy_policy_init(&phyPolicy);
+#endif /* TELINK_BLE_PHY_POLICY_ENABLE */
+
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+    static const uni_ble_notify_cfg_t notifyCfg = {
+        .batching = true,
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+        .backpressure = AppBenchOnBackpressure,
+        .sent = AppBenchOnNotifySent,
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+    };
+    uni_ble_notify_init(&notifyCfg);
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+#if TELINK_BLE_DIAG_ENABLE
+    static const uni_ble_diag_cfg_t diagCfg = {
+        .txFifoNum = ACL_TX_FIFO_NUM,
+        .rxFifoNum = ACL_RX_FIFO_NUM,
+        .reportMs = TELINK_BLE_DIAG_REPORT_MS,
+    };
+    uni_ble_diag_init(&diagCfg);
+#endif /* TELINK_BLE_DIAG_ENABLE */
 
     return status;
 }
@@ -189,6 +308,10 @@ static void AppBleInit(void)
     uni_ble_ll_initConnection_module();
     uni_ble_ll_initSlaveRole_module();
 
+#if TELINK_BLE_PHY_POLICY_ENABLE
+    uni_ble_ll_init2MPhyCodedPhy_feature();
+#endif /* TELINK_BLE_PHY_POLICY_ENABLE */
+
     status = AppBleAdvInit();
     HILOG_INFO(HILOG_MODULE_APP, "AppBleAdvInit(): %d", status);
     assert(status == BLE_SUCCESS);
@@ -196,6 +319,27 @@ static void AppBleInit(void)
     status = AppBleConnInit();
     HILOG_INFO(HILOG_MODULE_APP, "AppBleConnInit(): %d", status);
     assert(status == BLE_SUCCESS);
+
+#if TELINK_BLE_DEEP_RETENTION_ENABLE
+    uni_ble_pm_initDeepRetention();
+#endif /* TELINK_BLE_DEEP_RETENTION_ENABLE */
+}
+
+/**
+ * @brief       Report once per boot the time from reset or deepSleep retention wake-up to the first
+ *              main loop pass, which is when the stack schedules the first advertising event
+ * @param[in]   none
+ * @return      none
+ */
+static void AppWakeLatencyReport(void)
+{
+    if (g_app_wake.reported) {
+        return;
+    }
+
+    g_app_wake.reported = 1;
+    HILOG_INFO(HILOG_MODULE_APP, "wake-to-advertising (%s): %u us", g_app_wake.retention ? "retention" : "normal",
+               (unsigned)((clock_time() - g_app_wake.wakeTick) / SYSTEM_TIMER_TICK_1US));
 }
 
 /**
@@ -205,6 +349,11 @@ static void AppBleInit(void)
  */
 void UserInitNormal(void)
 {
+    /* The system timer counts from 0 at reset, so the boot before user initialization is included */
+    g_app_wake.wakeTick = 0;
+    g_app_wake.retention = 0;
+    g_app_wake.reported = 0;
+
     /*
      * Random number generator must be initiated here( in the beginning of user_init_nromal).
      * when deepSleep retention wakeUp, no need initialize again
@@ -215,6 +364,32 @@ void UserInitNormal(void)
     AppBleInit();
 }
 
+/**
+ * @brief       This function re-arms only the radio and timers after deepSleep retention wakeup
+ * @param[in]   none
+ * @return      none
+ */
+void UserInitDeepRetention(void)
+{
+#if TELINK_BLE_DEEP_RETENTION_ENABLE
+    /*
+     * The system timer is restored across retention, the wake-up the stack scheduled before sleeping
+     * is when the MCU came back up
+     */
+    g_app_wake.wakeTick = bls_pm_getSystemWakeupTick();
+    g_app_wake.retention = 1;
+    g_app_wake.reported = 0;
+
+    blc_ll_initBasicMCU();                       // Mandatory
+    uni_ble_ll_recoverDeepRetention();
+
+    /* GPIO registers are not retained */
+    GpioSetDir(LED_WHITE_HDF, GPIO_DIR_OUT);
+#else
+    UserInitNormal();
+#endif /* TELINK_BLE_DEEP_RETENTION_ENABLE */
+}
+
 /**
  * @brief       This is main_loop function
  * @param[in]   none
@@ -223,4 +398,36 @@ void UserInitNormal(void)
 _attribute_no_inline_ void MainLoop(void)
 {
     uni_ble_sdk_main_loop();
+
+    UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_APP_LOOP);
+
+    /* application callbacks run here, outside of BLE stack context */
+    uni_ble_process_events();
+
+    uni_ble_conn_policy_tick();
+
+    uni_ble_phy_policy_tick();
+
+    AppAdvTick();
+
+    AppWakeLatencyReport();
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+    AppBenchTask();
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+    uni_ble_notify_tick();
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+#if TELINK_BLE_DIAG_ENABLE
+    uni_ble_diag_tick();
+#endif /* TELINK_BLE_DIAG_ENABLE */
+
+    UNI_BLE_PROF_END(UNI_BLE_PROF_APP_LOOP);
+
+#if TELINK_BLE_TRACE_ENABLE
+    /* outside of the profiled section, the dump blocks for the whole UART output */
+    BleTraceTick();
+#endif /* TELINK_BLE_TRACE_ENABLE */
 }
@@ -30,6 +30,14 @@ extern "C" {
  */
 void UserInitNormal(void);
 
+/**
+ * @brief		fast user initialization when MCU wakes up from deepSleep retention mode,
+ *              BLE buffers, GATT table and application state are kept in retention SRAM
+ * @param[in]	none
+ * @return      none
+ */
+void UserInitDeepRetention(void);
+
 /**
  * @brief     BLE main loop
  * @param[in]  none.
@@ -0,0 +1,325 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <hiview_log.h>
+
+#include <tl_common.h>
+#include <drivers.h>
+#include <stack/ble/ble.h>
+
+#include "app_adv.h"
+#include "ble_log.h"
+#include "uni_ble.h"
+
+#define US_PER_MS               1000
+#define PERMILLE                1000
+#define ADV_INTERVAL_UNIT_US    625
+#define ADV_INTERVAL_MAX        0x4000    // 10.24 s
+/* Average of the 0..10 ms pseudo-random advDelay added to every advertising event */
+#define ADV_DELAY_AVG_US        5000
+#define ADV_CHANNEL_NUM         3
+/* Preamble, access address, PDU header, AdvA and CRC */
+#define ADV_PDU_OVERHEAD_BYTES  16
+#define ADV_BYTE_US             8
+/* T_IFS plus receive window for SCAN_REQ/CONNECT_IND after each ADV_IND */
+#define ADV_RX_WINDOW_US        250
+/* Radio on-time is accounted and the duty budget enforced per window */
+#define ADV_BUDGET_WINDOW_MS    10000
+/* Delay before retrying a phase the controller refused */
+#define ADV_RETRY_MS            1000
+
+#define ADV_MS(ms)              ((ms) * US_PER_MS / ADV_INTERVAL_UNIT_US)
+
+typedef struct {
+    u16 intervalMin;    // 0.625 ms units
+    u16 intervalMax;    // 0.625 ms units
+    u32 durationMs;     // 0 means the phase never ends
+} AppAdvPhase;
+
+#if TELINK_BLE_ADV_SCHEDULER_ENABLE
+static const AppAdvPhase g_advPhases[] = {
+    {ADV_INTERVAL_30MS, ADV_INTERVAL_35MS, TELINK_BLE_ADV_FAST_MS},
+    {ADV_MS(100), ADV_MS(105), 60000},
+    {ADV_MS(500), ADV_MS(505), 300000},
+    {ADV_MS(1000), ADV_MS(1010), 0},
+};
+#else
+static const AppAdvPhase g_advPhases[] = {
+    {ADV_INTERVAL_30MS, ADV_INTERVAL_35MS, 0},
+};
+#endif /* TELINK_BLE_ADV_SCHEDULER_ENABLE */
+
+_Static_assert(ARRAY_SIZE(g_advPhases) <= APP_ADV_MAX_PHASES, "too many advertising phases");
+
+/* Why advertising that should run is off */
+typedef enum {
+    ADV_HOLD_NONE,
+    ADV_HOLD_BUDGET,    // radio on-time of the budget window used up, resumes with the next window
+    ADV_HOLD_ERROR,     // the controller refused the parameters, retried after ADV_RETRY_MS
+} AppAdvHold;
+
+UNI_BLE_RETENTION_DATA static struct {
+    AppAdvStats stats;
+    u32 eventRadioUs;
+    /** Average advertising event period of the applied interval, advDelay included */
+    u32 eventPeriodUs;
+    u32 advStartTick;
+    u32 phaseStartTick;
+    u32 holdTick;
+    /** Radio on-time accounting of the current budget window */
+    u32 windowStartTick;
+    u32 windowOnUs;
+    u32 accountTick;
+    u32 accountRem;
+    u8 phase;
+    u8 advertising;
+    u8 hold;
+} g_app_adv;
+
+/**
+ * @brief      Whether the controller can take another connection, i.e. advertising may run
+ */
+static bool AppAdvSlotFree(void)
+{
+    return uni_ble_get_conn_count() < UNI_BLE_MAX_CONN;
+}
+
+/**
+ * @brief      Stretch the interval so that the estimated radio on-time stays within the duty-cycle budget
+ */
+static void AppAdvApplyBudget(u16 *intervalMin, u16 *intervalMax)
+{
+#if TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE
+    u32 minPeriodUs = g_app_adv.eventRadioUs * PERMILLE / TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE;
+    u32 minIntervalUs = (minPeriodUs > ADV_DELAY_AVG_US) ? (minPeriodUs - ADV_DELAY_AVG_US) : 0;
+    u32 minInterval = (minIntervalUs + ADV_INTERVAL_UNIT_US - 1) / ADV_INTERVAL_UNIT_US;
+
+    if (minInterval > ADV_INTERVAL_MAX) {
+        minInterval = ADV_INTERVAL_MAX;
+    }
+    if (*intervalMin < minInterval) {
+        *intervalMin = minInterval;
+    }
+    if (*intervalMax < *intervalMin) {
+        *intervalMax = *intervalMin;
+    }
+#else
+    UNUSED(intervalMin);
+    UNUSED(intervalMax);
+#endif /* TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE */
+}
+
+/**
+ * @brief      Account the radio on-time of the advertising events run since the last call. The
+ *             controller runs one event when advertising is enabled and then one per event period,
+ *             so restarts (reconnects, phase changes) count as well.
+ */
+static void AppAdvAccount(void)
+{
+    u32 now = clock_time();
+
+    if (g_app_adv.advertising) {
+        u64 num = (u64)((now - g_app_adv.accountTick) / SYSTEM_TIMER_TICK_1US) * g_app_adv.eventRadioUs +
+                  g_app_adv.accountRem;
+        g_app_adv.windowOnUs += (u32)(num / g_app_adv.eventPeriodUs);
+        g_app_adv.accountRem = (u32)(num % g_app_adv.eventPeriodUs);
+    }
+    g_app_adv.accountTick = now;
+}
+
+static ble_sts_t AppAdvApplyPhase(u8 phase)
+{
+    u16 intervalMin = g_advPhases[phase].intervalMin;
+    u16 intervalMax = g_advPhases[phase].intervalMax;
+
+    AppAdvApplyBudget(&intervalMin, &intervalMax);
+
+    /* Parameters can only be changed while advertising is disabled */
+    AppAdvAccount();
+    (void)uni_ble_ll_setAdvEnable(BLC_ADV_DISABLE);
+    g_app_adv.advertising = 0;
+    g_app_adv.phase = phase;
+
+    ble_sts_t status = uni_ble_ll_setAdvParam(intervalMin, intervalMax,
+                                              ADV_TYPE_CONNECTABLE_UNDIRECTED, OWN_ADDRESS_PUBLIC,
+                                              0,  NULL,
+                                              BLT_ENABLE_ADV_ALL,
+                                              ADV_FP_NONE);
+    if (status != BLE_SUCCESS) {
+        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_setAdvParam(): %d", status);
+    } else {
+        status = uni_ble_ll_setAdvEnable(BLC_ADV_ENABLE);
+        if (status != BLE_SUCCESS) {
+            HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_setAdvEnable(): %d", status);
+        }
+    }
+    if (status != BLE_SUCCESS) {
+        g_app_adv.hold = ADV_HOLD_ERROR;
+        g_app_adv.holdTick = clock_time();
+        return status;
+    }
+
+    g_app_adv.phaseStartTick = clock_time();
+    g_app_adv.advertising = 1;
+    g_app_adv.hold = ADV_HOLD_NONE;
+    g_app_adv.eventPeriodUs = intervalMin * ADV_INTERVAL_UNIT_US + ADV_DELAY_AVG_US;
+    g_app_adv.windowOnUs += g_app_adv.eventRadioUs;
+
+    BLE_LOG(BLE_LOG_ADV_PHASE, phase, intervalMin, intervalMax);
+
+    return status;
+}
+
+static ble_sts_t AppAdvStartFast(void)
+{
+    g_app_adv.advStartTick = clock_time();
+
+    /* The budget window decides when advertising may go on */
+    if (g_app_adv.hold == ADV_HOLD_BUDGET) {
+        g_app_adv.phase = 0;
+        g_app_adv.phaseStartTick = g_app_adv.advStartTick;
+        return BLE_SUCCESS;
+    }
+
+    return AppAdvApplyPhase(0);
+}
+
+/**
+ * @brief      Start a new budget window when the current one is over, hold advertising for the rest of
+ *             the window once its radio on-time reached the budget
+ */
+static void AppAdvBudgetTick(void)
+{
+#if TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE
+    AppAdvAccount();
+
+    u32 elapsedMs = (clock_time() - g_app_adv.windowStartTick) / SYSTEM_TIMER_TICK_1MS;
+    if (elapsedMs >= ADV_BUDGET_WINDOW_MS) {
+        g_app_adv.windowStartTick = clock_time();
+        g_app_adv.windowOnUs = 0;
+        if (g_app_adv.hold == ADV_HOLD_BUDGET && AppAdvSlotFree()) {
+            (void)AppAdvApplyPhase(g_app_adv.phase);
+        }
+        return;
+    }
+
+    /* window in ms times budget in permille is the budget in us */
+    if (g_app_adv.advertising && g_app_adv.windowOnUs >= ADV_BUDGET_WINDOW_MS * TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE) {
+        (void)uni_ble_ll_setAdvEnable(BLC_ADV_DISABLE);
+        g_app_adv.advertising = 0;
+        g_app_adv.hold = ADV_HOLD_BUDGET;
+        BLE_LOG(BLE_LOG_ADV_HOLD, (unsigned)g_app_adv.windowOnUs, (unsigned)(ADV_BUDGET_WINDOW_MS - elapsedMs));
+    }
+#endif /* TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE */
+}
+
+ble_sts_t AppAdvInit(u8 advDataLen, u8 scanRspLen)
+{
+    UNUSED(scanRspLen);
+
+    (void)memset(&g_app_adv, 0, sizeof(g_app_adv));
+    g_app_adv.stats.ttcMinMs = U32_MAX;
+    g_app_adv.windowStartTick = clock_time();
+    g_app_adv.accountTick = g_app_adv.windowStartTick;
+
+    /* Estimate of radio on-time for one advertising event without scan requests */
+    g_app_adv.eventRadioUs = ADV_CHANNEL_NUM * ((ADV_PDU_OVERHEAD_BYTES + advDataLen) * ADV_BYTE_US + ADV_RX_WINDOW_US);
+
+    return AppAdvStartFast();
+}
+
+void AppAdvRequestFast(void)
+{
+    /* Keep the time-to-connect reference of the ongoing advertising session */
+    if (g_app_adv.advertising) {
+        if (g_app_adv.phase != 0) {
+            (void)AppAdvApplyPhase(0);
+        }
+        return;
+    }
+
+    /* Held advertising resumes in the fast phase */
+    if (g_app_adv.hold != ADV_HOLD_NONE) {
+        g_app_adv.phase = 0;
+    }
+}
+
+void AppAdvTick(void)
+{
+    AppAdvBudgetTick();
+
+    if (g_app_adv.hold == ADV_HOLD_ERROR) {
+        if (AppAdvSlotFree() && clock_time_exceed(g_app_adv.holdTick, ADV_RETRY_MS * US_PER_MS)) {
+            (void)AppAdvApplyPhase(g_app_adv.phase);
+        }
+        return;
+    }
+
+    if (!g_app_adv.advertising) {
+        return;
+    }
+
+    u32 durationMs = g_advPhases[g_app_adv.phase].durationMs;
+    if (durationMs == 0 || g_app_adv.phase + 1 >= ARRAY_SIZE(g_advPhases)) {
+        return;
+    }
+
+    if (clock_time_exceed(g_app_adv.phaseStartTick, durationMs * US_PER_MS)) {
+        (void)AppAdvApplyPhase(g_app_adv.phase + 1);
+    }
+}
+
+void AppAdvOnConnect(void)
+{
+    if (g_app_adv.advertising) {
+        u32 ttcMs = (clock_time() - g_app_adv.advStartTick) / SYSTEM_TIMER_TICK_1MS;
+        AppAdvStats *stats = &g_app_adv.stats;
+
+        stats->connects++;
+        stats->ttcSumMs += ttcMs;
+        stats->ttcMinMs = min(stats->ttcMinMs, ttcMs);
+        stats->ttcMaxMs = max(stats->ttcMaxMs, ttcMs);
+        stats->phaseConnects[g_app_adv.phase]++;
+
+        BLE_LOG(BLE_LOG_ADV_TTC, (unsigned)ttcMs, g_app_adv.phase, (unsigned)(stats->ttcSumMs / stats->connects));
+    }
+
+    AppAdvAccount();
+    g_app_adv.advertising = 0;
+
+    /* Multi connection SDK keeps advertising while there are free slave slots */
+    if (AppAdvSlotFree()) {
+        (void)AppAdvStartFast();
+        return;
+    }
+
+    /* Nothing to resume or retry until a link is gone, AppAdvOnDisconnect() restarts advertising */
+    g_app_adv.hold = ADV_HOLD_NONE;
+}
+
+void AppAdvOnDisconnect(void)
+{
+    (void)AppAdvStartFast();
+}
+
+void AppAdvGetStats(AppAdvStats *stats)
+{
+    *stats = g_app_adv.stats;
+}
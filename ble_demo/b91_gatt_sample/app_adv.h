@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_B91_GATT_SAMPLE_APP_ADV_H
+#define VENDOR_B91_GATT_SAMPLE_APP_ADV_H
+
+#include <stack/ble/ble.h>
+
+#define APP_ADV_MAX_PHASES 4
+
+/**
+ *  @brief  Time-to-connect statistics, measured from (re)start of fast advertising to connection,
+ *          also the value of the advertising diagnostics characteristic (little endian)
+ */
+typedef struct {
+    u32 connects;
+    u32 ttcMinMs;
+    u32 ttcMaxMs;
+    u32 ttcSumMs;
+    /** Number of connections established in each advertising phase */
+    u32 phaseConnects[APP_ADV_MAX_PHASES];
+} AppAdvStats;
+
+/**
+ * @brief      Start the advertising scheduler in the fast phase.
+ *             Advertising and scan response data must already be set.
+ * @param[in]  advDataLen   advertising data length, used for the radio duty-cycle estimate
+ * @param[in]  scanRspLen   scan response data length
+ * @return     BLE_SUCCESS in case if advertising was enabled successfully
+ */
+ble_sts_t AppAdvInit(u8 advDataLen, u8 scanRspLen);
+
+/**
+ * @brief      Re-enter the fast phase, e.g. on user interaction. Held advertising resumes in the fast phase.
+ * @param[in]  none
+ * @return     none
+ */
+void AppAdvRequestFast(void);
+
+/**
+ * @brief      Advance to slower phases when the current one expires and hold advertising while the
+ *             radio on-time of the budget window is used up, call from the BLE main loop
+ * @param[in]  none
+ * @return     none
+ */
+void AppAdvTick(void);
+
+void AppAdvOnConnect(void);
+
+void AppAdvOnDisconnect(void);
+
+void AppAdvGetStats(AppAdvStats *stats);
+
+#endif /* VENDOR_B91_GATT_SAMPLE_APP_ADV_H */
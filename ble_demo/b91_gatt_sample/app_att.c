@@ -16,36 +16,23 @@
  *
  *****************************************************************************/
 
+#include <string.h>
+
 #include "stack/ble/ble.h"
 
-/**
- *  @brief  GATT table descriptors enumeration
- */
-typedef enum {
-    ATT_H_START = 0,
-
-    /* GAP service */
-    GenericAccess_PS_H,                     // UUID: 2800, VALUE: uuid 1800
-    GenericAccess_DeviceName_CD_H,          // UUID: 2803, VALUE: Prop: Read | Notify
-    GenericAccess_DeviceName_DP_H,          // UUID: 2A00, VALUE: device name
-    GenericAccess_Appearance_CD_H,          // UUID: 2803, VALUE: Prop: Read
-    GenericAccess_Appearance_DP_H,          // UUID: 2A01, VALUE: appearance
-    CONN_PARAM_CD_H,                        // UUID: 2803, VALUE: Prop: Read
-    CONN_PARAM_DP_H,                        // UUID: 2A04, VALUE: connParameter
-
-    /* GATT service */
-    GenericAttribute_PS_H,                  // UUID: 2800, VALUE: uuid 1801
-    GenericAttribute_ServiceChanged_CD_H,   // UUID: 2803, VALUE: Prop: Indicate
-    GenericAttribute_ServiceChanged_DP_H,   // UUID: 2A05, VALUE: service change
-    GenericAttribute_ServiceChanged_CCB_H,  // UUID: 2902, VALUE: serviceChangeCCC
-
-    /* Device info service */
-    DeviceInformation_PS_H,                 // UUID: 2800, VALUE: uuid 180A
-    DeviceInformation_pnpID_CD_H,           // UUID: 2803, VALUE: Prop: Read
-    DeviceInformation_pnpID_DP_H,           // UUID: 2A50, VALUE: PnPtrs
-
-    ATT_END_H,
-}ATT_HANDLE;
+#include "app_adv.h"
+#include "app_att.h"
+#include "ble_trace.h"
+#include "sys_param_blob.h"
+#include "uni_ble.h"
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+#include "app_bench.h"
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE
+#include "uni_ble_diag.h"
+#endif /* TELINK_BLE_DIAG_ENABLE */
+#include "uni_ble_prof.h"
 
 /**
  *  @brief  connect parameters structure for ATT
@@ -65,199 +52,342 @@ typedef struct {
 static const u16 my_primaryServiceUUID  = GATT_UUID_PRIMARY_SERVICE;
 static const u16 my_gapServiceUUID      = SERVICE_UUID_GENERIC_ACCESS;
 static const u16 my_characterUUID       = GATT_UUID_CHARACTER;
-static const u16 my_devNameUUID         = GATT_UUID_DEVICE_NAME;
 static const u16 my_gattServiceUUID     = SERVICE_UUID_GENERIC_ATTRIBUTE;
-static const u16 serviceChangeUUID      = GATT_UUID_SERVICE_CHANGE;
 static const u16 clientCharacterCfgUUID = GATT_UUID_CLIENT_CHAR_CFG;
 static const u16 my_devServiceUUID      = SERVICE_UUID_DEVICE_INFORMATION;
-static const u16 my_PnPUUID             = CHARACTERISTIC_UUID_PNP_ID;
-static const u16 my_appearanceUUID      = GATT_UUID_APPEARANCE;
-static const u16 my_periConnParamUUID   = GATT_UUID_PERI_CONN_PARAM;
-
-/* Characteristics */
-static const u8 my_devNameCharVal[5] = {
-    CHAR_PROP_READ | CHAR_PROP_NOTIFY,
-    U16_LO(GenericAccess_DeviceName_DP_H), U16_HI(GenericAccess_DeviceName_DP_H),
-    U16_LO(GATT_UUID_DEVICE_NAME), U16_HI(GATT_UUID_DEVICE_NAME)
-};
 
-static const u8 my_appearanceCharVal[5] = {
-    CHAR_PROP_READ,
-    U16_LO(GenericAccess_Appearance_DP_H), U16_HI(GenericAccess_Appearance_DP_H),
-    U16_LO(GATT_UUID_APPEARANCE), U16_HI(GATT_UUID_APPEARANCE)
-};
+/* Values */
+static const u8 my_devName[] = {'e', 'S', 'a', 'm', 'p', 'l', 'e'};
+static const u16 my_appearance = GAP_APPEARE_UNKNOWN;
+static const gap_periConnectParams_t my_periConnParameters = {8, 11, 0, 1000};
+/* Values the central writes survive deepSleep retention, the stack keeps the link across it */
+UNI_BLE_RETENTION_DATA static u16 serviceChangeVal[2] = {0};
+UNI_BLE_RETENTION_DATA static u8 serviceChangeCCC[2] = {0, 0};
+static const u8 my_PnPtrs [] = {0x02, 0x8a, 0x24, 0x66, 0x82, 0x01, 0x00};
+
+/*
+ * Device information strings point into the system parameter blob, the whole blob is also
+ * readable through a vendor characteristic, 128-bit UUID 7e5a0201-8c1f-4f5e-9d2b-b91b3c4d5e6f
+ */
+#define SYS_PARAM_UUID_BYTES(n) 0x6f, 0x5e, 0x4d, 0x3c, 0x1b, 0xb9, 0x2b, 0x9d, 0x5e, 0x4f, 0x1f, 0x8c, (n), 0x02, 0x5a, 0x7e
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+/* Vendor benchmark service, 128-bit UUIDs 7e5a000x-8c1f-4f5e-9d2b-b91b3c4d5e6f (little endian) */
+#define BENCH_UUID_BYTES(n) 0x6f, 0x5e, 0x4d, 0x3c, 0x1b, 0xb9, 0x2b, 0x9d, 0x5e, 0x4f, 0x1f, 0x8c, (n), 0x00, 0x5a, 0x7e
+#define BENCH_UUID(n)       {BENCH_UUID_BYTES(n)}
+
+static const u8 my_benchServiceUUID[16] = BENCH_UUID(0x00);
+
+UNI_BLE_RETENTION_DATA static u8 benchTxVal[1] = {0};
+UNI_BLE_RETENTION_DATA static u8 benchTxCCC[2] = {0, 0};
+UNI_BLE_RETENTION_DATA static u8 benchRxVal[1] = {0};
+UNI_BLE_RETENTION_DATA static AppBenchResult benchCtrlVal;
+UNI_BLE_RETENTION_DATA static u8 benchCtrlCCC[2] = {0, 0};
+
+/**
+ * @brief      Write Without Response to the sink: the payload is only counted
+ */
+static int BenchRxWrite(u16 connHandle, const u8 *data, u16 len)
+{
+    UNUSED(connHandle);
+
+    AppBenchSinkWrite(data, len);
+
+    return 0;
+}
+
+static int BenchCtrlWrite(u16 connHandle, const u8 *data, u16 len)
+{
+    AppBenchCtrlWrite(connHandle, data, len);
+
+    return 0;
+}
+
+/**
+ * @brief      Refresh the result in place just before the stack reads the attribute value
+ */
+static int BenchCtrlRead(u16 connHandle, u8 *value, u16 size)
+{
+    UNUSED(connHandle);
+
+    if (size >= sizeof(AppBenchResult)) {
+        AppBenchGetResult((AppBenchResult *)value);
+    }
+
+    return 0;
+}
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+
+#if TELINK_BLE_DIAG_ENABLE
+/* Vendor diagnostics service, 128-bit UUIDs 7e5a010x-8c1f-4f5e-9d2b-b91b3c4d5e6f (little endian) */
+#define DIAG_UUID_BYTES(n)  0x6f, 0x5e, 0x4d, 0x3c, 0x1b, 0xb9, 0x2b, 0x9d, 0x5e, 0x4f, 0x1f, 0x8c, (n), 0x01, 0x5a, 0x7e
+
+static const u8 my_diagServiceUUID[16] = {DIAG_UUID_BYTES(0x00)};
+
+static uni_ble_diag_t diagBuffersVal;
+static u8 diagCtrlVal[1];
+static AppAdvStats diagAdvVal;
 
-static const u8 my_periConnParamCharVal[5] = {
-    CHAR_PROP_READ,
-    U16_LO(CONN_PARAM_DP_H), U16_HI(CONN_PARAM_DP_H),
-    U16_LO(GATT_UUID_PERI_CONN_PARAM), U16_HI(GATT_UUID_PERI_CONN_PARAM)
+/**
+ * @brief      Serve the buffer counters of the reading link, all zero (connHandle 0) for a link diag does not track
+ */
+static int DiagBuffersRead(u16 connHandle, u8 *value, u16 size)
+{
+    if (size >= sizeof(uni_ble_diag_t) && !uni_ble_diag_get(connHandle, (uni_ble_diag_t *)value)) {
+        memset(value, 0, sizeof(uni_ble_diag_t));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      Serve the advertising time-to-connect statistics
+ */
+static int DiagAdvRead(u16 connHandle, u8 *value, u16 size)
+{
+    UNUSED(connHandle);
+
+    if (size >= sizeof(AppAdvStats)) {
+        AppAdvGetStats((AppAdvStats *)value);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      Diagnostics control: 0x01 dumps the profiler through HILOG, 0x02 clears it,
+ *             0x03 requests a dump of the trace buffer on the UART from the main loop,
+ *             0x04 puts advertising back into the fast phase
+ */
+static int DiagCtrlWrite(u16 connHandle, const u8 *data, u16 len)
+{
+    UNUSED(connHandle);
+
+    if (len == 0) {
+        return 0;
+    }
+
+    switch (data[0]) {
+#if CYCLE_PROF_ENABLE
+        case 0x01:
+            uni_ble_prof_dump();
+            break;
+        case 0x02:
+            uni_ble_prof_reset();
+            break;
+#endif /* CYCLE_PROF_ENABLE */
+#if TELINK_BLE_TRACE_ENABLE
+        case 0x03:
+            BleTraceRequestDump();
+            break;
+#endif /* TELINK_BLE_TRACE_ENABLE */
+        case 0x04:
+            AppAdvRequestFast();
+            break;
+        default:
+            break;
+    }
+
+    return 0;
+}
+#endif /* TELINK_BLE_DIAG_ENABLE */
+
+/* Maximum length of an attribute value (Core Spec Vol 3, Part F, 3.2.9) */
+#define ATT_VALUE_MAX_SIZE  512
+/* Notification bit of the Client Characteristic Configuration value (Core Spec Vol 3, Part G, 3.3.3.3) */
+#define CCC_NOTIFY_BIT      0x01
+/* Opcode and attribute handle of a Write Request or Command (Core Spec Vol 3, Part F, 3.4.5) */
+#define ATT_WRITE_HEADER_LEN    3
+
+/* Characteristic UUIDs and declaration values, generated from APP_ATT_TABLE */
+#define APP_ATT_DECL_SERVICE(name, uuid)
+#define APP_ATT_DECL_CHAR16(name, prop, uuid, perm, value, write, read) \
+    static const u16 name##_UUID = (uuid); \
+    static const u8 name##_CharVal[5] = { \
+        (prop), U16_LO(name##_DP_H), U16_HI(name##_DP_H), U16_LO(uuid), U16_HI(uuid) \
+    }; \
+    _Static_assert(sizeof(value) <= ATT_VALUE_MAX_SIZE, #name " value exceeds the ATT value limit");
+#define APP_ATT_DECL_CHAR128(name, prop, uuidBytes, uuidArg, perm, value, write, read) \
+    static const u8 name##_UUID[] = {uuidBytes(uuidArg)}; \
+    static const u8 name##_CharVal[19] = { \
+        (prop), U16_LO(name##_DP_H), U16_HI(name##_DP_H), uuidBytes(uuidArg) \
+    }; \
+    _Static_assert(sizeof(name##_UUID) == 16, #name " UUID must be 128-bit"); \
+    _Static_assert(sizeof(value) <= ATT_VALUE_MAX_SIZE, #name " value exceeds the ATT value limit");
+#define APP_ATT_DECL_DESC(name, uuid, perm, value, write, read) \
+    _Static_assert(sizeof(value) <= ATT_VALUE_MAX_SIZE, #name " value exceeds the ATT value limit");
+#define APP_ATT_DECL_END(name) \
+    _Static_assert(name##_END_H - name##_PS_H > 1, #name " service has no characteristic");
+
+APP_ATT_TABLE(APP_ATT_DECL_SERVICE, APP_ATT_DECL_CHAR16, APP_ATT_DECL_CHAR128, APP_ATT_DECL_DESC, APP_ATT_DECL_END)
+
+/* Per-handle read/write handlers, generated from APP_ATT_TABLE */
+#define APP_ATT_WRITE_SERVICE(name, uuid)
+#define APP_ATT_WRITE_CHAR16(name, prop, uuid, perm, value, write, read)                   [name##_DP_H] = (write),
+#define APP_ATT_WRITE_CHAR128(name, prop, uuidBytes, uuidArg, perm, value, write, read)    [name##_DP_H] = (write),
+#define APP_ATT_WRITE_DESC(name, uuid, perm, value, write, read)                           [name##_H] = (write),
+#define APP_ATT_WRITE_END(name)
+
+#define APP_ATT_READ_SERVICE(name, uuid)
+#define APP_ATT_READ_CHAR16(name, prop, uuid, perm, value, write, read)                    [name##_DP_H] = (read),
+#define APP_ATT_READ_CHAR128(name, prop, uuidBytes, uuidArg, perm, value, write, read)     [name##_DP_H] = (read),
+#define APP_ATT_READ_DESC(name, uuid, perm, value, write, read)                            [name##_H] = (read),
+#define APP_ATT_READ_END(name)
+
+static const AppAttWriteHandler g_attWriteHandlers[ATT_END_H] = {
+    APP_ATT_TABLE(APP_ATT_WRITE_SERVICE, APP_ATT_WRITE_CHAR16, APP_ATT_WRITE_CHAR128, APP_ATT_WRITE_DESC,
+                  APP_ATT_WRITE_END)
 };
 
-static const u8 my_serviceChangeCharVal[5] = {
-    CHAR_PROP_INDICATE,
-    U16_LO(GenericAttribute_ServiceChanged_DP_H), U16_HI(GenericAttribute_ServiceChanged_DP_H),
-    U16_LO(GATT_UUID_SERVICE_CHANGE), U16_HI(GATT_UUID_SERVICE_CHANGE)
+static const AppAttReadHandler g_attReadHandlers[ATT_END_H] = {
+    APP_ATT_TABLE(APP_ATT_READ_SERVICE, APP_ATT_READ_CHAR16, APP_ATT_READ_CHAR128, APP_ATT_READ_DESC,
+                  APP_ATT_READ_END)
 };
 
-static const u8 my_PnCharVal[5] = {
-    CHAR_PROP_READ,
-    U16_LO(DeviceInformation_pnpID_DP_H), U16_HI(DeviceInformation_pnpID_DP_H),
-    U16_LO(CHARACTERISTIC_UUID_PNP_ID), U16_HI(CHARACTERISTIC_UUID_PNP_ID)
+/*
+ * Attribute values handed to the read handlers, generated from APP_ATT_TABLE. The dispatchers are referenced
+ * by gattTable, so they cannot look the values up there.
+ */
+typedef struct {
+    u8 *value;
+    u16 len;
+} AppAttValue;
+
+#define APP_ATT_VALUE_SERVICE(name, uuid)
+#define APP_ATT_VALUE_CHAR16(name, prop, uuid, perm, value, write, read) \
+    [name##_DP_H] = {(u8 *)(&value), sizeof(value)},
+#define APP_ATT_VALUE_CHAR128(name, prop, uuidBytes, uuidArg, perm, value, write, read) \
+    [name##_DP_H] = {(u8 *)(&value), sizeof(value)},
+#define APP_ATT_VALUE_DESC(name, uuid, perm, value, write, read) \
+    [name##_H] = {(u8 *)(&value), sizeof(value)},
+#define APP_ATT_VALUE_END(name)
+
+static const AppAttValue g_attValues[ATT_END_H] = {
+    APP_ATT_TABLE(APP_ATT_VALUE_SERVICE, APP_ATT_VALUE_CHAR16, APP_ATT_VALUE_CHAR128, APP_ATT_VALUE_DESC,
+                  APP_ATT_VALUE_END)
 };
 
-/* Values */
-static const u8 my_devName[] = {'e', 'S', 'a', 'm', 'p', 'l', 'e'};
-static const u16 my_appearance = GAP_APPEARE_UNKNOWN;
-static const gap_periConnectParams_t my_periConnParameters = {8, 11, 0, 1000};
-static u16 serviceChangeVal[2] = {0};
-static u8 serviceChangeCCC[2] = {0, 0};
-static const u8 my_PnPtrs [] = {0x02, 0x8a, 0x24, 0x66, 0x82, 0x01, 0x00};
+static int AppAttWriteDispatch(UNI_BLE_ATT_CB_PARAMS(p))
+{
+    rf_packet_att_write_t *req = (rf_packet_att_write_t *)p;
 
-/* Define our GATT table here */
-static const attribute_t gattTable[] = {
-    {
-        ATT_END_H - 1,
-        0,
-        0,
-        0,
-        0,
-        0
-    }, // total num of attribute
+    /* Opcode and handle come first, a shorter PDU has no complete handle and would underflow the value length */
+    if (req->l2capLen < ATT_WRITE_HEADER_LEN) {
+        return ATT_ERR_INVALID_PDU;
+    }
 
-    // 0001 - 0007  gap
-    {
-        7,
-        ATT_PERMISSIONS_READ,
-        2,
-        2,
-        (u8 *)(&my_primaryServiceUUID),
-        (u8 *)(&my_gapServiceUUID),
-        0
-    },
-    {
-        0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_devNameCharVal),
-        (u8 *)(&my_characterUUID),
-        (u8 *)(my_devNameCharVal),
-        0
-    },
-    {
-        0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_devName),
-        (u8 *)(&my_devNameUUID),
-        (u8 *)(my_devName),
-        0
-    },
-    {
-        0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_appearanceCharVal),
-        (u8 *)(&my_characterUUID),
-        (u8 *)(my_appearanceCharVal),
-        0
+    u16 handle = MAKE_U16(req->handle1, req->handle);
+    if (handle >= ATT_END_H || g_attWriteHandlers[handle] == 0) {
+        return 0;
+    }
+
+    BLE_TRACE(BLE_TRACE_ATT_CB, handle);
+    UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_ATT_CB);
+    int ret = g_attWriteHandlers[handle](UNI_BLE_ATT_CB_CONN_HANDLE, &req->value,
+                                         req->l2capLen - ATT_WRITE_HEADER_LEN);
+    UNI_BLE_PROF_END(UNI_BLE_PROF_ATT_CB);
+
+    return ret;
+}
+
+static int AppAttReadDispatch(UNI_BLE_ATT_CB_PARAMS(p))
+{
+    rf_packet_att_read_t *req = (rf_packet_att_read_t *)p;
+    u16 handle = MAKE_U16(req->handle1, req->handle);
+
+    if (handle >= ATT_END_H || g_attReadHandlers[handle] == 0) {
+        return 0;
+    }
+
+    BLE_TRACE(BLE_TRACE_ATT_CB, handle);
+    UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_ATT_CB);
+    int ret = g_attReadHandlers[handle](UNI_BLE_ATT_CB_CONN_HANDLE, g_attValues[handle].value,
+                                        g_attValues[handle].len);
+    UNI_BLE_PROF_END(UNI_BLE_PROF_ATT_CB);
+
+    return ret;
+}
+
+/* Attributes without a handler keep the callback slot at 0 so the stack handles them itself */
+#define APP_ATT_CB(handler, dispatch)   (att_readwrite_callback_t)_Generic((handler), int: 0, default: (dispatch))
+
+/* Attribute table entries, generated from APP_ATT_TABLE */
+#define APP_ATT_ENTRY_SERVICE(name, uuid) \
+    { \
+        name##_END_H - name##_PS_H, \
+        ATT_PERMISSIONS_READ, \
+        2, \
+        sizeof(uuid), \
+        (u8 *)(&my_primaryServiceUUID), \
+        (u8 *)(&uuid), \
+        0 \
     },
-    {
-        0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_appearance),
-        (u8 *)(&my_appearanceUUID),
-        (u8 *)(&my_appearance),
-        0
+#define APP_ATT_ENTRY_CHAR(name, perm, value, write, read) \
+    { \
+        0, \
+        ATT_PERMISSIONS_READ, \
+        2, \
+        sizeof(name##_CharVal), \
+        (u8 *)(&my_characterUUID), \
+        (u8 *)(name##_CharVal), \
+        0 \
+    }, \
+    { \
+        0, \
+        (perm), \
+        sizeof(name##_UUID), \
+        sizeof(value), \
+        (u8 *)(&name##_UUID), \
+        (u8 *)(&value), \
+        APP_ATT_CB(write, AppAttWriteDispatch), \
+        APP_ATT_CB(read, AppAttReadDispatch) \
     },
-    {
-        0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_periConnParamCharVal),
-        (u8 *)(&my_characterUUID),
-        (u8 *)(my_periConnParamCharVal),
-        0
+#define APP_ATT_ENTRY_CHAR16(name, prop, uuid, perm, value, write, read) \
+    APP_ATT_ENTRY_CHAR(name, perm, value, write, read)
+#define APP_ATT_ENTRY_CHAR128(name, prop, uuidBytes, uuidArg, perm, value, write, read) \
+    APP_ATT_ENTRY_CHAR(name, perm, value, write, read)
+#define APP_ATT_ENTRY_DESC(name, uuid, perm, value, write, read) \
+    { \
+        0, \
+        (perm), \
+        sizeof(uuid), \
+        sizeof(value), \
+        (u8 *)(&uuid), \
+        (u8 *)(&value), \
+        APP_ATT_CB(write, AppAttWriteDispatch), \
+        APP_ATT_CB(read, AppAttReadDispatch) \
     },
+#define APP_ATT_ENTRY_END(name)
+
+/* Define our GATT table here */
+static const attribute_t gattTable[] = {
     {
+        ATT_END_H - 1,
         0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_periConnParameters),
-        (u8 *)(&my_periConnParamUUID),
-        (u8 *)(&my_periConnParameters),
-        0
-    },
-    // 0008 - 000b gatt
-    {
-        4,
-        ATT_PERMISSIONS_READ,
-        2,
-        2,
-        (u8 *)(&my_primaryServiceUUID),
-        (u8 *)(&my_gattServiceUUID),
-        0
-    },
-    {
         0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_serviceChangeCharVal),
-        (u8 *)(&my_characterUUID),
-        (u8 *)(my_serviceChangeCharVal),
-        0
-    },
-    {
         0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(serviceChangeVal),
-        (u8 *)(&serviceChangeUUID),
-        (u8 *)(&serviceChangeVal),
-        0
-    },
-    {
         0,
-        ATT_PERMISSIONS_RDWR,
-        2,
-        sizeof(serviceChangeCCC),
-        (u8 *)(&clientCharacterCfgUUID),
-        (u8 *)(serviceChangeCCC),
         0
-    },
+    }, // total num of attribute
 
-    // 000c - 000e  device Information Service
-    {
-        3,
-        ATT_PERMISSIONS_READ,
-        2,
-        2,
-        (u8 *)(&my_primaryServiceUUID),
-        (u8 *)(&my_devServiceUUID),
-        0
-    },
-    {
-        0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_PnCharVal),
-        (u8 *)(&my_characterUUID),
-        (u8 *)(my_PnCharVal),
-        0
-    },
-    {
-        0,
-        ATT_PERMISSIONS_READ,
-        2,
-        sizeof(my_PnPtrs),
-        (u8 *)(&my_PnPUUID),
-        (u8 *)(my_PnPtrs),
-        0
-    },
+    APP_ATT_TABLE(APP_ATT_ENTRY_SERVICE, APP_ATT_ENTRY_CHAR16, APP_ATT_ENTRY_CHAR128, APP_ATT_ENTRY_DESC,
+                  APP_ATT_ENTRY_END)
 };
 
+_Static_assert(ARRAY_SIZE(gattTable) == ATT_END_H, "gattTable does not match the ATT_HANDLE enum");
+_Static_assert(ATT_END_H - 1 <= 0xFFFF, "too many attributes for 16-bit ATT handles");
+
 void AppBleGattInit(void)
 {
     /* Set up GATT table */
     bls_att_setAttributeTable((u8 *)gattTable);
 }
+
+bool AppAttNotifyEnabled(u16 cccHandle)
+{
+    if (cccHandle >= ATT_END_H || gattTable[cccHandle].attrLen < 2) {
+        return false;
+    }
+
+    return (gattTable[cccHandle].pAttrValue[0] & CCC_NOTIFY_BIT) != 0;
+}
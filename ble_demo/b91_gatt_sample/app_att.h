@@ -19,6 +19,153 @@
 #ifndef VENDOR_B91_GATT_SAMPLE_APP_ATT_H
 #define VENDOR_B91_GATT_SAMPLE_APP_ATT_H
 
+#include <stack/ble/ble.h>
+
+/**
+ * @brief      Attribute write handler
+ * @param[in]  connHandle - connection the write arrived on
+ * @param[in]  data - written value, points straight into the L2CAP RX buffer
+ * @param[in]  len - length of the written value
+ * @return     0 on success, otherwise an ATT error code
+ */
+typedef int (*AppAttWriteHandler)(u16 connHandle, const u8 *data, u16 len);
+
+/**
+ * @brief      Attribute read handler, called just before the stack copies the value into the response
+ * @param[in]  connHandle - connection the read arrived on
+ * @param[out] value - attribute value buffer to fill in place
+ * @param[in]  size - size of the attribute value buffer
+ * @return     0 on success
+ */
+typedef int (*AppAttReadHandler)(u16 connHandle, u8 *value, u16 size);
+
+/*
+ * Declarative GATT table.
+ *
+ * Every attribute of the table is described exactly once below; app_att.c expands the same
+ * list into the handle enum, the characteristic declaration values and the attribute table,
+ * so the handles, the per-service attribute counts and the table header can no longer drift
+ * apart. Each list takes the following entry macros:
+ *
+ *   SERVICE(name, uuid)
+ *       Primary service declaration, handle name##_PS_H. uuid is the variable holding the
+ *       16-bit or 128-bit service UUID.
+ *   CHAR16(name, prop, uuid, perm, value, write, read)
+ *       Characteristic with a 16-bit UUID constant: declaration name##_CD_H and value
+ *       name##_DP_H. value is the variable holding the characteristic value, write/read the
+ *       optional AppAttWriteHandler/AppAttReadHandler of the value (0 if unused).
+ *   CHAR128(name, prop, uuidBytes, uuidArg, perm, value, write, read)
+ *       Same with a 128-bit UUID, given as the byte list macro uuidBytes(uuidArg).
+ *   DESC(name, uuid, perm, value, write, read)
+ *       Descriptor attached to the previous characteristic, handle name##_H.
+ *   END(name)
+ *       Closes the service; name##_END_H is one past its last handle.
+ *
+ * The list is evaluated at compile time only, the table and all declaration values end up
+ * in flash.
+ */
+#define APP_ATT_GAP_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    SERVICE(GenericAccess, my_gapServiceUUID) \
+    CHAR16(GenericAccess_DeviceName, CHAR_PROP_READ | CHAR_PROP_NOTIFY, GATT_UUID_DEVICE_NAME, \
+           ATT_PERMISSIONS_READ, my_devName, 0, 0) \
+    CHAR16(GenericAccess_Appearance, CHAR_PROP_READ, GATT_UUID_APPEARANCE, \
+           ATT_PERMISSIONS_READ, my_appearance, 0, 0) \
+    CHAR16(CONN_PARAM, CHAR_PROP_READ, GATT_UUID_PERI_CONN_PARAM, \
+           ATT_PERMISSIONS_READ, my_periConnParameters, 0, 0) \
+    END(GenericAccess)
+
+#define APP_ATT_GATT_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    SERVICE(GenericAttribute, my_gattServiceUUID) \
+    CHAR16(GenericAttribute_ServiceChanged, CHAR_PROP_INDICATE, GATT_UUID_SERVICE_CHANGE, \
+           ATT_PERMISSIONS_READ, serviceChangeVal, 0, 0) \
+    DESC(GenericAttribute_ServiceChanged_CCB, clientCharacterCfgUUID, \
+         ATT_PERMISSIONS_RDWR, serviceChangeCCC, 0, 0) \
+    END(GenericAttribute)
+
+#define APP_ATT_DIS_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    SERVICE(DeviceInformation, my_devServiceUUID) \
+    CHAR16(DeviceInformation_pnpID, CHAR_PROP_READ, CHARACTERISTIC_UUID_PNP_ID, \
+           ATT_PERMISSIONS_READ, my_PnPtrs, 0, 0) \
+    CHAR16(DeviceInformation_Manufacturer, CHAR_PROP_READ, CHARACTERISTIC_UUID_MANU_NAME_STRING, \
+           ATT_PERMISSIONS_READ, SYS_PARAM_VALUE(MANUFACTURE), 0, 0) \
+    CHAR16(DeviceInformation_Model, CHAR_PROP_READ, CHARACTERISTIC_UUID_MODEL_NUM_STRING, \
+           ATT_PERMISSIONS_READ, SYS_PARAM_VALUE(PRODUCT_MODEL), 0, 0) \
+    CHAR16(DeviceInformation_Serial, CHAR_PROP_READ, CHARACTERISTIC_UUID_SERIAL_NUM_STRING, \
+           ATT_PERMISSIONS_READ, SYS_PARAM_VALUE(SERIAL), 0, 0) \
+    CHAR16(DeviceInformation_FwRevision, CHAR_PROP_READ, CHARACTERISTIC_UUID_FW_REVISION_STRING, \
+           ATT_PERMISSIONS_READ, SYS_PARAM_VALUE(SOFTWARE_MODEL), 0, 0) \
+    CHAR16(DeviceInformation_HwRevision, CHAR_PROP_READ, CHARACTERISTIC_UUID_HW_REVISION_STRING, \
+           ATT_PERMISSIONS_READ, SYS_PARAM_VALUE(HARDWARE_MODEL), 0, 0) \
+    CHAR16(DeviceInformation_SwRevision, CHAR_PROP_READ, CHARACTERISTIC_UUID_SW_REVISION_STRING, \
+           ATT_PERMISSIONS_READ, SYS_PARAM_VALUE(DISPLAY_VERSION), 0, 0) \
+    CHAR128(DeviceInformation_Params, CHAR_PROP_READ, SYS_PARAM_UUID_BYTES, 0x01, \
+            ATT_PERMISSIONS_READ, g_sysParamBlob, 0, 0) \
+    END(DeviceInformation)
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+#define APP_ATT_BENCH_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    SERVICE(Bench, my_benchServiceUUID) \
+    CHAR128(Bench_Tx, CHAR_PROP_NOTIFY, BENCH_UUID_BYTES, 0x01, \
+            ATT_PERMISSIONS_READ, benchTxVal, 0, 0) \
+    DESC(Bench_Tx_CCB, clientCharacterCfgUUID, ATT_PERMISSIONS_RDWR, benchTxCCC, 0, 0) \
+    CHAR128(Bench_Rx, CHAR_PROP_WRITE_WITHOUT_RSP, BENCH_UUID_BYTES, 0x02, \
+            ATT_PERMISSIONS_WRITE, benchRxVal, BenchRxWrite, 0) \
+    CHAR128(Bench_Ctrl, CHAR_PROP_READ | CHAR_PROP_WRITE | CHAR_PROP_NOTIFY, BENCH_UUID_BYTES, 0x03, \
+            ATT_PERMISSIONS_RDWR, benchCtrlVal, BenchCtrlWrite, BenchCtrlRead) \
+    DESC(Bench_Ctrl_CCB, clientCharacterCfgUUID, ATT_PERMISSIONS_RDWR, benchCtrlCCC, 0, 0) \
+    END(Bench)
+#else
+#define APP_ATT_BENCH_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END)
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+
+#if TELINK_BLE_DIAG_ENABLE
+#define APP_ATT_DIAG_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    SERVICE(Diag, my_diagServiceUUID) \
+    CHAR128(Diag_Buffers, CHAR_PROP_READ, DIAG_UUID_BYTES, 0x01, \
+            ATT_PERMISSIONS_READ, diagBuffersVal, 0, DiagBuffersRead) \
+    CHAR128(Diag_Ctrl, CHAR_PROP_WRITE, DIAG_UUID_BYTES, 0x02, \
+            ATT_PERMISSIONS_WRITE, diagCtrlVal, DiagCtrlWrite, 0) \
+    CHAR128(Diag_Adv, CHAR_PROP_READ, DIAG_UUID_BYTES, 0x03, \
+            ATT_PERMISSIONS_READ, diagAdvVal, 0, DiagAdvRead) \
+    END(Diag)
+#else
+#define APP_ATT_DIAG_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END)
+#endif /* TELINK_BLE_DIAG_ENABLE */
+
+#define APP_ATT_TABLE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    APP_ATT_GAP_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    APP_ATT_GATT_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    APP_ATT_DIS_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    APP_ATT_BENCH_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END) \
+    APP_ATT_DIAG_SERVICE(SERVICE, CHAR16, CHAR128, DESC, END)
+
+/* name##_END_H takes the next handle value and is immediately stepped back, it only marks the service end */
+#define APP_ATT_ENUM_SERVICE(name, uuid)                                        name##_PS_H,
+#define APP_ATT_ENUM_CHAR16(name, prop, uuid, perm, value, write, read)         name##_CD_H, name##_DP_H,
+#define APP_ATT_ENUM_CHAR128(name, prop, uuidBytes, uuidArg, perm, value, write, read) \
+    name##_CD_H, name##_DP_H,
+#define APP_ATT_ENUM_DESC(name, uuid, perm, value, write, read)                 name##_H,
+#define APP_ATT_ENUM_END(name)                                                  name##_END_H, name##_END_M = name##_END_H - 1,
+
+/**
+ *  @brief  GATT table descriptors enumeration
+ */
+typedef enum {
+    ATT_H_START = 0,
+
+    APP_ATT_TABLE(APP_ATT_ENUM_SERVICE, APP_ATT_ENUM_CHAR16, APP_ATT_ENUM_CHAR128, APP_ATT_ENUM_DESC, APP_ATT_ENUM_END)
+
+    ATT_END_H,
+}ATT_HANDLE;
+
 void AppBleGattInit(void);
 
+/**
+ * @brief      Check the notification bit of a Client Characteristic Configuration descriptor,
+ *             the SDK sends notifications without looking at it
+ * @param[in]  cccHandle - handle of the CCC descriptor, e.g. Bench_Tx_CCB_H
+ * @return     true if the client enabled notifications
+ */
+bool AppAttNotifyEnabled(u16 cccHandle);
+
 #endif
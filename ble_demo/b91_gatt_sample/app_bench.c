@@ -0,0 +1,275 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <hiview_log.h>
+
+#include <tl_common.h>
+#include <drivers.h>
+#include <stack/ble/ble.h>
+
+#include "app_att.h"
+#include "app_bench.h"
+#include "uni_ble.h"
+#include "uni_ble_phy.h"
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+#include "uni_ble_notify.h"
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+#define BENCH_ATT_HEADER_LEN    3
+#define BENCH_MAX_PAYLOAD_LEN   244
+#define BENCH_SEQ_LEN           4
+#define BENCH_CONN_INTERVAL_US  1250
+#define BENCH_QUEUED_WRITE_LEN  20
+
+UNI_BLE_RETENTION_DATA static struct {
+    AppBenchStats stats;
+    u32 txSeq;
+    u32 pingTick;
+    u16 connHandle;
+    u8 connected;
+    u8 streaming;
+    u8 payloadLen;
+    u8 pingSeq;
+    u8 pingPending;
+    u8 queued;
+    u8 congested;
+    u8 writeLen;
+    u8 txBuff[BENCH_MAX_PAYLOAD_LEN];
+} g_app_bench;
+
+void AppBenchOnConnect(u16 connHandle)
+{
+    if (g_app_bench.connected) {
+        return;
+    }
+
+    g_app_bench.connHandle = connHandle;
+    g_app_bench.connected = 1;
+    g_app_bench.streaming = 0;
+    g_app_bench.pingPending = 0;
+    AppBenchStatsReset(&g_app_bench.stats, clock_time());
+}
+
+void AppBenchOnDisconnect(u16 connHandle)
+{
+    if (!g_app_bench.connected || connHandle != g_app_bench.connHandle) {
+        return;
+    }
+
+    g_app_bench.connected = 0;
+    g_app_bench.streaming = 0;
+    g_app_bench.pingPending = 0;
+}
+
+void AppBenchOnConnUpdate(u16 connHandle)
+{
+    if (!g_app_bench.connected || connHandle != g_app_bench.connHandle) {
+        return;
+    }
+
+    AppBenchStatsReset(&g_app_bench.stats, clock_time());
+}
+
+void AppBenchSinkWrite(const u8 *data, u16 len)
+{
+    UNUSED(data);
+
+    AppBenchStatsOnRx(&g_app_bench.stats, len);
+}
+
+static void AppBenchSendPing(void)
+{
+    u8 ping[2] = {APP_BENCH_OP_PING, ++g_app_bench.pingSeq};
+
+    if (!AppAttNotifyEnabled(Bench_Ctrl_CCB_H)) {
+        return;
+    }
+
+    g_app_bench.pingTick = clock_time();
+    if (uni_ble_att_pushNotifyData(g_app_bench.connHandle, Bench_Ctrl_DP_H, ping, sizeof(ping)) == BLE_SUCCESS) {
+        g_app_bench.pingPending = 1;
+    }
+}
+
+static void AppBenchOnPong(u8 seq)
+{
+    if (!g_app_bench.pingPending || seq != g_app_bench.pingSeq) {
+        return;
+    }
+
+    g_app_bench.pingPending = 0;
+    AppBenchStatsOnRtt(&g_app_bench.stats, (clock_time() - g_app_bench.pingTick) / SYSTEM_TIMER_TICK_1US);
+}
+
+void AppBenchCtrlWrite(u16 connHandle, const u8 *data, u16 len)
+{
+    if (len == 0) {
+        return;
+    }
+
+    /* the link that last wrote the control point is the one being measured */
+    g_app_bench.connHandle = connHandle;
+    g_app_bench.connected = 1;
+
+    switch (data[0]) {
+        case APP_BENCH_OP_START_TX:
+            g_app_bench.payloadLen = (len > 1) ? data[1] : 0;
+            g_app_bench.txSeq = 0;
+            g_app_bench.streaming = 1;
+            g_app_bench.queued = 0;
+            uni_ble_phy_policy_set_throughput(connHandle, true);
+            AppBenchStatsReset(&g_app_bench.stats, clock_time());
+            break;
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+        case APP_BENCH_OP_START_QUEUED:
+            g_app_bench.writeLen = (len > 1 && data[1] != 0) ? data[1] : BENCH_QUEUED_WRITE_LEN;
+            g_app_bench.writeLen = max(min(g_app_bench.writeLen, BENCH_MAX_PAYLOAD_LEN), BENCH_SEQ_LEN);
+            uni_ble_notify_set_batching(len > 2 ? data[2] != 0 : true);
+            g_app_bench.txSeq = 0;
+            g_app_bench.streaming = 1;
+            g_app_bench.queued = 1;
+            g_app_bench.congested = 0;
+            uni_ble_phy_policy_set_throughput(connHandle, true);
+            AppBenchStatsReset(&g_app_bench.stats, clock_time());
+            break;
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+        case APP_BENCH_OP_STOP_TX:
+            g_app_bench.streaming = 0;
+            uni_ble_phy_policy_set_throughput(connHandle, false);
+            break;
+        case APP_BENCH_OP_RESET:
+            AppBenchStatsReset(&g_app_bench.stats, clock_time());
+            break;
+        case APP_BENCH_OP_PING:
+            if (len > 1) {
+                AppBenchOnPong(data[1]);
+            } else {
+                AppBenchSendPing();
+            }
+            break;
+        default:
+            HILOG_WARN(HILOG_MODULE_APP, "AppBenchCtrlWrite(): unknown opcode %d", data[0]);
+            break;
+    }
+}
+
+void AppBenchGetResult(AppBenchResult *result)
+{
+    u32 connIntervalUs = 0;
+
+    if (g_app_bench.connected) {
+        connIntervalUs = uni_ble_ll_getConnectionInterval(g_app_bench.connHandle) * BENCH_CONN_INTERVAL_US;
+    }
+
+    AppBenchStatsReport(&g_app_bench.stats, clock_time(), SYSTEM_TIMER_TICK_1MS, connIntervalUs, result);
+}
+
+static u16 AppBenchPayloadLen(void)
+{
+    u16 len = uni_ble_att_getEffectiveMtuSize(g_app_bench.connHandle) - BENCH_ATT_HEADER_LEN;
+
+    if (g_app_bench.payloadLen != 0 && g_app_bench.payloadLen < len) {
+        len = g_app_bench.payloadLen;
+    }
+    if (len > BENCH_MAX_PAYLOAD_LEN) {
+        len = BENCH_MAX_PAYLOAD_LEN;
+    }
+    if (len < BENCH_SEQ_LEN) {
+        len = BENCH_SEQ_LEN;
+    }
+
+    return len;
+}
+
+/**
+ * @brief      Fill the payload with a counter pattern: 4 bytes sequence number, then (u8)(seq + i)
+ */
+static void AppBenchFillPattern(u8 *buff, u16 len, u32 seq)
+{
+    buff[0] = U32_BYTE0(seq);
+    buff[1] = U32_BYTE1(seq);
+    buff[2] = U32_BYTE2(seq);
+    buff[3] = U32_BYTE3(seq);
+
+    for (u16 i = BENCH_SEQ_LEN; i < len; i++) {
+        buff[i] = (u8)(seq + i);
+    }
+}
+
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+void AppBenchOnBackpressure(u16 connHandle, bool congested)
+{
+    if (connHandle == g_app_bench.connHandle) {
+        g_app_bench.congested = congested;
+    }
+}
+
+void AppBenchOnNotifySent(u16 connHandle, u16 attHandle, u16 len)
+{
+    if (connHandle == g_app_bench.connHandle && attHandle == Bench_Tx_DP_H) {
+        AppBenchStatsOnTx(&g_app_bench.stats, len);
+    }
+}
+
+/**
+ * @brief      Feed small writes into the notify queue until it pushes back, packets are counted when sent
+ */
+static void AppBenchQueuedTask(void)
+{
+    while (!g_app_bench.congested) {
+        AppBenchFillPattern(g_app_bench.txBuff, g_app_bench.writeLen, g_app_bench.txSeq);
+        if (!uni_ble_notify_queue(g_app_bench.connHandle, Bench_Tx_DP_H, g_app_bench.txBuff, g_app_bench.writeLen)) {
+            break;
+        }
+
+        g_app_bench.txSeq++;
+    }
+}
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+void AppBenchTask(void)
+{
+    if (!g_app_bench.connected || !g_app_bench.streaming) {
+        return;
+    }
+
+    /* Keep the stream armed until the client subscribes */
+    if (!AppAttNotifyEnabled(Bench_Tx_CCB_H)) {
+        return;
+    }
+
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+    if (g_app_bench.queued) {
+        AppBenchQueuedTask();
+        return;
+    }
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+    u16 len = AppBenchPayloadLen();
+
+    /* Stop as soon as the stack refuses a packet, i.e. TX FIFO is full */
+    for (;;) {
+        AppBenchFillPattern(g_app_bench.txBuff, len, g_app_bench.txSeq);
+        if (uni_ble_att_pushNotifyData(g_app_bench.connHandle, Bench_Tx_DP_H, g_app_bench.txBuff, len) != BLE_SUCCESS) {
+            break;
+        }
+
+        g_app_bench.txSeq++;
+        AppBenchStatsOnTx(&g_app_bench.stats, len);
+    }
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_B91_GATT_SAMPLE_APP_BENCH_H
+#define VENDOR_B91_GATT_SAMPLE_APP_BENCH_H
+
+#include <stack/ble/ble.h>
+
+#include "app_bench_stats.h"
+
+/**
+ *  @brief  Opcodes written to the benchmark control characteristic
+ */
+typedef enum {
+    APP_BENCH_OP_START_TX = 0x01, // [op, payloadLen]: start notify stream, payloadLen 0 means (MTU - 3)
+    APP_BENCH_OP_STOP_TX  = 0x02, // [op]: stop notify stream
+    APP_BENCH_OP_RESET    = 0x03, // [op]: clear counters and restart measurement window
+    APP_BENCH_OP_PING     = 0x04, // [op, seq]: from device (notify) and host (write) for round-trip latency
+    APP_BENCH_OP_START_QUEUED = 0x05, // [op, writeLen, batching]: stream writeLen sized writes through the notify queue
+} AppBenchOpcode;
+
+void AppBenchOnConnect(u16 connHandle);
+
+void AppBenchOnDisconnect(u16 connHandle);
+
+/**
+ * @brief      Restart the measurement window after a connection parameter or PHY update of the bench
+ *             link, rates and packets per connection event of a window must come from one setting
+ * @param[in]  connHandle  connection handle
+ * @return     none
+ */
+void AppBenchOnConnUpdate(u16 connHandle);
+
+/**
+ * @brief      Account data received on the write-without-response sink
+ * @param[in]  data  pointer to the payload inside the L2CAP RX buffer
+ * @param[in]  len   payload length
+ * @return     none
+ */
+void AppBenchSinkWrite(const u8 *data, u16 len);
+
+void AppBenchCtrlWrite(u16 connHandle, const u8 *data, u16 len);
+
+void AppBenchGetResult(AppBenchResult *result);
+
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+/* uni_ble_notify callbacks */
+void AppBenchOnBackpressure(u16 connHandle, bool congested);
+
+void AppBenchOnNotifySent(u16 connHandle, u16 attHandle, u16 len);
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+/**
+ * @brief      Push the notify stream into free TX FIFO entries, must be called from the BLE main loop
+ * @param[in]  none
+ * @return     none
+ */
+void AppBenchTask(void);
+
+#endif /* VENDOR_B91_GATT_SAMPLE_APP_BENCH_H */
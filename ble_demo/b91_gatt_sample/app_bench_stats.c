@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "app_bench_stats.h"
+
+#define PACKETS_PER_EVT_SCALE 100
+#define US_PER_MS             1000
+#define MS_PER_SEC            1000
+
+void AppBenchStatsReset(AppBenchStats *stats, uint32_t nowTick)
+{
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->startTick = nowTick;
+    stats->rttMinUs = UINT32_MAX;
+}
+
+void AppBenchStatsOnRx(AppBenchStats *stats, uint32_t len)
+{
+    stats->rxBytes += len;
+    stats->rxPackets++;
+}
+
+void AppBenchStatsOnTx(AppBenchStats *stats, uint32_t len)
+{
+    stats->txBytes += len;
+    stats->txPackets++;
+}
+
+void AppBenchStatsOnRtt(AppBenchStats *stats, uint32_t rttUs)
+{
+    stats->rttCount++;
+    stats->rttSumUs += rttUs;
+    if (rttUs < stats->rttMinUs) {
+        stats->rttMinUs = rttUs;
+    }
+    if (rttUs > stats->rttMaxUs) {
+        stats->rttMaxUs = rttUs;
+    }
+}
+
+static uint32_t PerSecond(uint32_t count, uint32_t elapsedMs)
+{
+    return (uint32_t)(((uint64_t)count * MS_PER_SEC) / elapsedMs);
+}
+
+static uint16_t PerConnEvent(uint32_t packets, uint32_t connEvents)
+{
+    uint64_t scaled = ((uint64_t)packets * PACKETS_PER_EVT_SCALE) / connEvents;
+    return (scaled > UINT16_MAX) ? UINT16_MAX : (uint16_t)scaled;
+}
+
+void AppBenchStatsReport(const AppBenchStats *stats, uint32_t nowTick, uint32_t ticksPerMs,
+                         uint32_t connIntervalUs, AppBenchResult *result)
+{
+    (void)memset(result, 0, sizeof(*result));
+
+    /* unsigned subtraction handles system timer wrap-around */
+    uint32_t elapsedMs = (nowTick - stats->startTick) / ticksPerMs;
+    result->elapsedMs = elapsedMs;
+    if (elapsedMs == 0) {
+        return;
+    }
+
+    result->rxBytesPerSec = PerSecond(stats->rxBytes, elapsedMs);
+    result->txBytesPerSec = PerSecond(stats->txBytes, elapsedMs);
+
+    if (connIntervalUs != 0) {
+        uint32_t connEvents = (uint32_t)(((uint64_t)elapsedMs * US_PER_MS) / connIntervalUs);
+        if (connEvents != 0) {
+            result->rxPacketsPerConnEvt = PerConnEvent(stats->rxPackets, connEvents);
+            result->txPacketsPerConnEvt = PerConnEvent(stats->txPackets, connEvents);
+        }
+    }
+
+    if (stats->rttCount != 0) {
+        result->rttAvgUs = stats->rttSumUs / stats->rttCount;
+        result->rttMinUs = stats->rttMinUs;
+        result->rttMaxUs = stats->rttMaxUs;
+    }
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_B91_GATT_SAMPLE_APP_BENCH_STATS_H
+#define VENDOR_B91_GATT_SAMPLE_APP_BENCH_STATS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  @brief  Raw benchmark counters. Does not depend on the BLE SDK so it can be built on a host.
+ */
+typedef struct {
+    uint32_t startTick;
+    uint32_t rxBytes;
+    uint32_t rxPackets;
+    uint32_t txBytes;
+    uint32_t txPackets;
+    uint32_t rttCount;
+    uint32_t rttSumUs;
+    uint32_t rttMinUs;
+    uint32_t rttMaxUs;
+} AppBenchStats;
+
+/**
+ *  @brief  Benchmark result as exposed by the control characteristic (little endian, packed)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t elapsedMs;
+    uint32_t rxBytesPerSec;
+    uint32_t txBytesPerSec;
+    /** Packets per connection event, fixed point multiplied by 100 */
+    uint16_t rxPacketsPerConnEvt;
+    uint16_t txPacketsPerConnEvt;
+    uint32_t rttAvgUs;
+    uint32_t rttMinUs;
+    uint32_t rttMaxUs;
+} AppBenchResult;
+
+/**
+ * @brief      Clear all counters and restart the measurement window
+ * @param[in]  stats   counters
+ * @param[in]  nowTick current system timer tick
+ * @return     none
+ */
+void AppBenchStatsReset(AppBenchStats *stats, uint32_t nowTick);
+
+void AppBenchStatsOnRx(AppBenchStats *stats, uint32_t len);
+
+void AppBenchStatsOnTx(AppBenchStats *stats, uint32_t len);
+
+void AppBenchStatsOnRtt(AppBenchStats *stats, uint32_t rttUs);
+
+/**
+ * @brief      Convert counters into rates for the current measurement window
+ * @param[in]  stats          counters
+ * @param[in]  nowTick        current system timer tick
+ * @param[in]  ticksPerMs     system timer ticks per millisecond
+ * @param[in]  connIntervalUs connection interval, 0 if not connected
+ * @param[out] result         computed result
+ * @return     none
+ */
+void AppBenchStatsReport(const AppBenchStats *stats, uint32_t nowTick, uint32_t ticksPerMs,
+                         uint32_t connIntervalUs, AppBenchResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_B91_GATT_SAMPLE_APP_BENCH_STATS_H */
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_B91_GATT_SAMPLE_APP_BUFFER_H
+#define VENDOR_B91_GATT_SAMPLE_APP_BUFFER_H
+
+#include <stack/ble/ble.h>
+
+#include "uni_ble.h"
+
+/*
+ * BLE controller and L2CAP buffer budget, set from the GN args of BUILD.gn.
+ * tools/ble_ram_report.py prints the same totals at build time.
+ */
+#if TELINK_BLE_HIGH_THROUGHPUT_ENABLE
+#define ACL_CONN_MAX_RX_OCTETS    TELINK_BLE_CONN_MAX_OCTETS
+#define ACL_CONN_MAX_TX_OCTETS    TELINK_BLE_CONN_MAX_OCTETS
+#define ATT_MTU_SLAVE_RX_MAX_SIZE TELINK_BLE_ATT_MTU_SIZE
+#else
+#define ACL_CONN_MAX_RX_OCTETS    27
+#define ACL_CONN_MAX_TX_OCTETS    27
+#define ATT_MTU_SLAVE_RX_MAX_SIZE 23
+#endif /* TELINK_BLE_HIGH_THROUGHPUT_ENABLE */
+
+#define ACL_TX_FIFO_SIZE          CAL_LL_ACL_TX_FIFO_SIZE(ACL_CONN_MAX_TX_OCTETS)
+#define ACL_TX_FIFO_NUM           TELINK_BLE_ACL_TX_FIFO_NUM
+#define ACL_RX_FIFO_SIZE          CAL_LL_ACL_RX_FIFO_SIZE(ACL_CONN_MAX_RX_OCTETS)
+#define ACL_RX_FIFO_NUM           TELINK_BLE_ACL_RX_FIFO_NUM
+
+#define MTU_S_BUFF_SIZE_MAX       CAL_MTU_BUFF_SIZE(ATT_MTU_SLAVE_RX_MAX_SIZE)
+
+/* The RX FIFO is shared by all links, TX FIFOs and L2CAP buffers are per link */
+#define APP_BLE_RX_FIFO_RAM       (ACL_RX_FIFO_SIZE * ACL_RX_FIFO_NUM)
+#define APP_BLE_TX_FIFO_RAM       (ACL_TX_FIFO_SIZE * ACL_TX_FIFO_NUM * UNI_BLE_MAX_CONN)
+#define APP_BLE_MTU_RAM           (2 * MTU_S_BUFF_SIZE_MAX * UNI_BLE_MAX_CONN)
+#define APP_BLE_RAM_TOTAL         (APP_BLE_RX_FIFO_RAM + APP_BLE_TX_FIFO_RAM + APP_BLE_MTU_RAM)
+
+_Static_assert(ACL_CONN_MAX_RX_OCTETS >= 27 && ACL_CONN_MAX_RX_OCTETS <= 251, "DLE RX octets out of range");
+_Static_assert(ACL_CONN_MAX_TX_OCTETS >= 27 && ACL_CONN_MAX_TX_OCTETS <= 251, "DLE TX octets out of range");
+_Static_assert(ATT_MTU_SLAVE_RX_MAX_SIZE >= 23 && ATT_MTU_SLAVE_RX_MAX_SIZE <= 247, "ATT MTU out of range");
+
+/* Constraints of the controller FIFOs */
+_Static_assert(ACL_RX_FIFO_NUM >= 2 && (ACL_RX_FIFO_NUM & (ACL_RX_FIFO_NUM - 1)) == 0,
+               "telink_ble_acl_rx_fifo_num must be a power of two");
+_Static_assert(ACL_TX_FIFO_NUM > 2 && ((ACL_TX_FIFO_NUM - 1) & (ACL_TX_FIFO_NUM - 2)) == 0,
+               "telink_ble_acl_tx_fifo_num must be a power of two plus one, e.g. 9, 17 or 33");
+_Static_assert(ACL_RX_FIFO_SIZE % 16 == 0 && ACL_TX_FIFO_SIZE % 16 == 0, "ACL FIFO entries must be 16-byte aligned");
+_Static_assert(MTU_S_BUFF_SIZE_MAX % 4 == 0, "L2CAP MTU buffers must be 4-byte aligned");
+/* The build time RAM report is only right for the SDK the GN args describe */
+_Static_assert(UNI_BLE_MAX_CONN == TELINK_BLE_BUILD_MAX_CONN,
+               "telink_ble_sdk_multi/telink_ble_sdk_slave_max_num do not match the linked BLE SDK");
+
+#endif /* VENDOR_B91_GATT_SAMPLE_APP_BUFFER_H */
@@ -0,0 +1,41 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <los_task.h>
+
+#include <tl_common.h>
+#include <drivers.h>
+
+#include "ble_log.h"
+#include "bin_log_task.h"
+#include "stack_wm.h"
+
+#if TELINK_BIN_LOG_ENABLE
+_Static_assert((TELINK_BIN_LOG_LEN & (TELINK_BIN_LOG_LEN - 1)) == 0, "TELINK_BIN_LOG_LEN must be a power of two");
+
+BinLog g_bleLog;
+static BinLogRecord g_bleLogBuff[TELINK_BIN_LOG_LEN];
+
+void BleLogInit(void)
+{
+    UINT32 ret = BinLogTaskStart(&g_bleLog, g_bleLogBuff, TELINK_BIN_LOG_LEN, STACK_WM_SIZE(TELINK_LOG_TASK_STACK_SIZE));
+    if (ret != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "ret of BinLogTaskStart() = %#x", ret);
+    }
+}
+#endif /* TELINK_BIN_LOG_ENABLE */
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_B91_GATT_SAMPLE_BLE_LOG_H
+#define VENDOR_B91_GATT_SAMPLE_BLE_LOG_H
+
+#include <hiview_log.h>
+
+#include <bin_log.h>
+
+/**
+ *  @brief  Messages of the BLE callback paths, decode the deferred output with
+ *          common/tools/bin_log_decode.py --catalog ble_log.h. Arguments are 32-bit integers.
+ */
+#define BLE_LOG_CONNECT_FMT         "connect: handle %#x, role %d, interval %d"
+#define BLE_LOG_DISCONNECT_FMT      "disconnect: handle %#x, reason %#x"
+#define BLE_LOG_ADV_PHASE_FMT       "adv phase %d: interval %d..%d"
+#define BLE_LOG_ADV_TTC_FMT         "time to connect %u ms in phase %d, avg %u ms"
+#define BLE_LOG_CONN_PARAMS_FMT     "conn 0x%x params: interval %d, latency %d, timeout %d"
+#define BLE_LOG_CONN_PHY_FMT        "conn 0x%x PHY: tx %d, rx %d"
+#define BLE_LOG_ADV_HOLD_FMT        "adv held: %u us on air in the budget window, resumes in %u ms"
+#define BLE_LOG_CONN_REJECT_FMT     "connect: handle %#x rejected, connection table full, %u rejected so far"
+
+#define BLE_LOG_CATALOG(X)      \
+    X(BLE_LOG_CONNECT)          \
+    X(BLE_LOG_DISCONNECT)       \
+    X(BLE_LOG_ADV_PHASE)        \
+    X(BLE_LOG_ADV_TTC)          \
+    X(BLE_LOG_CONN_PARAMS)      \
+    X(BLE_LOG_CONN_PHY)         \
+    X(BLE_LOG_ADV_HOLD)         \
+    X(BLE_LOG_CONN_REJECT)
+
+typedef enum {
+    BLE_LOG_CATALOG(BIN_LOG_ENUM)
+    BLE_LOG_COUNT,
+} BleLogId;
+
+#if TELINK_BIN_LOG_ENABLE
+extern BinLog g_bleLog;
+
+/* Only the ID and the arguments are recorded, BinLogTask formats and prints them later */
+#define BLE_LOG(id, ...)                                                        \
+    do {                                                                        \
+        BIN_LOG_FORMAT_CHECK(id##_FMT, ##__VA_ARGS__);                          \
+        BIN_LOG_WRITE(&g_bleLog, clock_time(), (id), ##__VA_ARGS__);            \
+    } while (0)
+
+/**
+ * @brief      Start the lowest-priority task that drains the log to the UART
+ * @param[in]  none
+ * @return     none
+ */
+void BleLogInit(void);
+#else
+#define BLE_LOG(id, ...)                                                        \
+    do {                                                                        \
+        BIN_LOG_FORMAT_CHECK(id##_FMT, ##__VA_ARGS__);                          \
+        HILOG_INFO(HILOG_MODULE_APP, id##_FMT, ##__VA_ARGS__);                  \
+    } while (0)
+#endif /* TELINK_BIN_LOG_ENABLE */
+
+#endif /* VENDOR_B91_GATT_SAMPLE_BLE_LOG_H */
@@ -22,6 +22,7 @@
 #include <stdio.h>
 
 #include <los_task.h>
+#include <los_event.h>
 #include <los_arch_interrupt.h>
 
 #include <hiview_log.h>
@@ -36,15 +37,127 @@
 #include <riscv_hal.h>
 
 #include <B91/gpio.h>
+#include <drivers.h>
 
 #include <stack/ble/ble.h>
 
 #include "app.h"
+#include "ble_log.h"
+#include "ble_trace.h"
+#include "stack_wm.h"
 #include "uni_ble.h"
 
 #define LED_TASK_PRIORITY LOSCFG_BASE_CORE_TSK_DEFAULT_PRIO
 #define PROTO_TASK_PRIORITY (OS_TASK_PRIORITY_LOWEST-1)
 
+#define BLE_TASK_EVENT_IRQ  0x1
+
+#if TELINK_BLE_TASK_EVENT_DRIVEN
+static EVENT_CB_S g_bleTaskEvent;
+#endif /* TELINK_BLE_TASK_EVENT_DRIVEN */
+
+#if TELINK_BLE_TASK_STATS_ENABLE
+#define BLE_TASK_STATS_PERIOD_MS 5000
+#define PERCENT                  100
+
+static struct {
+    u32 windowStartTick;
+    u32 iterations;
+    u32 idleTicks;
+} g_bleTaskStats;
+
+/**
+ * @brief      Account one main loop iteration and periodically report iterations/s and idle percentage
+ * @param[in]  idleTicks  system timer ticks spent blocked since the previous iteration
+ * @return     none
+ */
+static void BleTaskStatsUpdate(u32 idleTicks)
+{
+    g_bleTaskStats.iterations++;
+    g_bleTaskStats.idleTicks += idleTicks;
+
+    u32 now = clock_time();
+    u32 windowTicks = now - g_bleTaskStats.windowStartTick;
+    if (windowTicks < BLE_TASK_STATS_PERIOD_MS * SYSTEM_TIMER_TICK_1MS) {
+        return;
+    }
+
+    u32 windowMs = windowTicks / SYSTEM_TIMER_TICK_1MS;
+    HILOG_INFO(HILOG_MODULE_APP, "BleTask: %u loops/s, idle %u%%",
+               (unsigned)((u64)g_bleTaskStats.iterations * 1000 / windowMs),
+               (unsigned)((u64)g_bleTaskStats.idleTicks * PERCENT / windowTicks));
+
+    u32 evtPending;
+    u32 evtDrops;
+    u32 evtHighWater;
+    uni_ble_get_event_queue_stats(&evtPending, &evtDrops, &evtHighWater);
+    HILOG_INFO(HILOG_MODULE_APP, "BleTask: event queue pending %u, drops %u, high-water %u, rejected links %u",
+               (unsigned)evtPending, (unsigned)evtDrops, (unsigned)evtHighWater,
+               (unsigned)uni_ble_get_conn_rejects());
+
+    g_bleTaskStats.windowStartTick = now;
+    g_bleTaskStats.iterations = 0;
+    g_bleTaskStats.idleTicks = 0;
+}
+#endif /* TELINK_BLE_TASK_STATS_ENABLE */
+
+#if TELINK_STACK_REPORT_ENABLE
+static u32 g_stackReportTick;
+
+/**
+ * @brief      Periodically report the stack watermark of all tasks. Runs in BleTask, the report
+ *             delays the main loop for the duration of the output, so it is for sizing builds only.
+ * @param[in]  none
+ * @return     none
+ */
+static void StackReportUpdate(void)
+{
+    u32 now = clock_time();
+    if (now - g_stackReportTick < TELINK_STACK_REPORT_MS * SYSTEM_TIMER_TICK_1MS) {
+        return;
+    }
+
+    g_stackReportTick = now;
+    StackWmReport(BinLogPrintLine, NULL);
+}
+#endif /* TELINK_STACK_REPORT_ENABLE */
+
+/**
+ * @brief      Block BleTask until an RF or STimer interrupt signals stack work.
+ *             The stack programs the STimer for its own next deadline, so the IRQ covers
+ *             stack-requested wakeups; TELINK_BLE_TASK_MAX_IDLE_MS bounds the sleep for app work.
+ * @param[in]  none
+ * @return     system timer ticks spent waiting
+ */
+static u32 BleTaskWait(void)
+{
+#if TELINK_BLE_TASK_EVENT_DRIVEN
+    u32 start = clock_time();
+
+    UINT32 events = LOS_EventRead(&g_bleTaskEvent, BLE_TASK_EVENT_IRQ, LOS_WAITMODE_OR | LOS_WAITMODE_CLR,
+                                  LOS_MS2Tick(TELINK_BLE_TASK_MAX_IDLE_MS));
+    BLE_TRACE(BLE_TRACE_TASK_WAKE, (events & BLE_TASK_EVENT_IRQ) ? 1 : 0);
+    UNUSED(events);
+
+    return clock_time() - start;
+#else
+    return 0;
+#endif /* TELINK_BLE_TASK_EVENT_DRIVEN */
+}
+
+/**
+ * @brief      Wake BleTask, safe to call from interrupt context. LOS_EventWrite() runs from flash,
+ *             so this stays in flash as well; the IRQ handlers only need the SDK part in RAM.
+ * @param[in]  none
+ * @return     none
+ */
+static void BleTaskWakeup(void)
+{
+#if TELINK_BLE_TASK_EVENT_DRIVEN
+    (void)LOS_EventWrite(&g_bleTaskEvent, BLE_TASK_EVENT_IRQ);
+#endif /* TELINK_BLE_TASK_EVENT_DRIVEN */
+}
+
 static void BleTask(void)
 {
     /*
@@ -56,8 +169,25 @@ static void BleTask(void)
 
     HILOG_INFO(HILOG_MODULE_APP, "%s:%d", __func__, __LINE__);
 
+#if TELINK_BLE_TASK_STATS_ENABLE
+    g_bleTaskStats.windowStartTick = clock_time();
+#endif /* TELINK_BLE_TASK_STATS_ENABLE */
+
     while (1) {
+        BLE_TRACE(BLE_TRACE_MAIN_LOOP_BEGIN, 0);
         MainLoop();
+        BLE_TRACE(BLE_TRACE_MAIN_LOOP_END, 0);
+
+        u32 idleTicks = BleTaskWait();
+#if TELINK_BLE_TASK_STATS_ENABLE
+        BleTaskStatsUpdate(idleTicks);
+#else
+        UNUSED(idleTicks);
+#endif /* TELINK_BLE_TASK_STATS_ENABLE */
+
+#if TELINK_STACK_REPORT_ENABLE
+        StackReportUpdate();
+#endif /* TELINK_STACK_REPORT_ENABLE */
     }
 }
 
@@ -68,7 +198,9 @@ static void BleTask(void)
  */
 _attribute_ram_code_ void RfIrqHandler(void)
 {
+    BLE_TRACE(BLE_TRACE_RF_IRQ, 0);
     uni_ble_sdk_irq_handler();
+    BleTaskWakeup();
 }
 
 /**
@@ -78,23 +210,47 @@ _attribute_ram_code_ void RfIrqHandler(void)
  */
 _attribute_ram_code_ void StimerIrqHandler(void)
 {
+    BLE_TRACE(BLE_TRACE_STIMER_IRQ, 0);
     uni_ble_sdk_irq_handler();
+    BleTaskWakeup();
 }
 
 void BleSampleInit(void)
 {
+#if TELINK_BIN_LOG_ENABLE
+    BleLogInit();
+#endif /* TELINK_BIN_LOG_ENABLE */
+#if TELINK_BLE_TRACE_ENABLE
+    BleTraceInit();
+#endif /* TELINK_BLE_TRACE_ENABLE */
+
     rf_drv_ble_init();
 
     /* load customized freq_offset cap value. */
     blc_app_loadCustomizedParameters();
+#if TELINK_BLE_DEEP_RETENTION_ENABLE
+    if (pm_is_MCU_deepRetentionWakeup()) {
+        UserInitDeepRetention();
+    } else {
+        UserInitNormal();
+    }
+#else
     UserInitNormal();
+#endif /* TELINK_BLE_DEEP_RETENTION_ENABLE */
 
     UINT32 ret;
+#if TELINK_BLE_TASK_EVENT_DRIVEN
+    ret = LOS_EventInit(&g_bleTaskEvent);
+    if (ret != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "ret of LOS_EventInit(BleTask) = %#x", ret);
+    }
+#endif /* TELINK_BLE_TASK_EVENT_DRIVEN */
+
     UINT32 taskId = 0;
     TSK_INIT_PARAM_S taskParam = {0};
     taskParam.pfnTaskEntry = (TSK_ENTRY_FUNC)BleTask;
     taskParam.uwArg = 0;
-    taskParam.uwStackSize = LOSCFG_BASE_CORE_TSK_DEFAULT_STACK_SIZE;
+    taskParam.uwStackSize = STACK_WM_SIZE(TELINK_BLE_TASK_STACK_SIZE);
     taskParam.pcName = "BleTask";
     taskParam.usTaskPrio = PROTO_TASK_PRIORITY;
     ret = LOS_TaskCreate(&taskId, &taskParam);
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <tl_common.h>
+#include <drivers.h>
+
+#include "bin_log.h"
+#include "ble_trace.h"
+
+_Static_assert((TELINK_BLE_TRACE_LEN & (TELINK_BLE_TRACE_LEN - 1)) == 0, "TELINK_BLE_TRACE_LEN must be a power of two");
+
+TraceRing g_bleTrace;
+static TraceRecord g_bleTraceBuff[TELINK_BLE_TRACE_LEN];
+static volatile u8 g_bleTraceDumpRequest;
+
+void BleTraceInit(void)
+{
+    (void)TraceRingInit(&g_bleTrace, g_bleTraceBuff, TELINK_BLE_TRACE_LEN);
+}
+
+void BleTraceRequestDump(void)
+{
+    g_bleTraceDumpRequest = 1;
+}
+
+void BleTraceTick(void)
+{
+    if (!g_bleTraceDumpRequest) {
+        return;
+    }
+
+    g_bleTraceDumpRequest = 0;
+    TraceRingDump(&g_bleTrace, SYSTEM_TIMER_TICK_1US, BinLogPrintLine, NULL);
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_B91_GATT_SAMPLE_BLE_TRACE_H
+#define VENDOR_B91_GATT_SAMPLE_BLE_TRACE_H
+
+#include <trace_ring.h>
+
+/**
+ *  @brief  Trace event IDs. tools/trace_decode.py reads this enum: XXX_BEGIN/XXX_END pairs become slices,
+ *          XXX_IRQ events are instants on the interrupt track and start an IRQ-to-task latency measurement.
+ */
+typedef enum {
+    BLE_TRACE_RF_IRQ = 1,           // arg: 0
+    BLE_TRACE_STIMER_IRQ = 2,       // arg: 0
+    BLE_TRACE_TASK_WAKE = 3,        // arg: 1 woken by an IRQ event, 0 idle timeout
+    BLE_TRACE_MAIN_LOOP_BEGIN = 4,  // arg: 0
+    BLE_TRACE_MAIN_LOOP_END = 5,    // arg: 0
+    BLE_TRACE_APP_EVENT = 6,        // arg: uni_ble event type delivered to the application
+    BLE_TRACE_ATT_CB = 7,           // arg: attribute handle
+} BleTraceId;
+
+#if TELINK_BLE_TRACE_ENABLE
+extern TraceRing g_bleTrace;
+
+#define BLE_TRACE(id, arg)  TraceRingWrite(&g_bleTrace, clock_time(), (id), (arg))
+
+void BleTraceInit(void);
+
+/**
+ * @brief      Ask for a dump of the trace buffer, safe to call from ATT callbacks. The dump runs in the
+ *             next BleTraceTick().
+ * @param[in]  none
+ * @return     none
+ */
+void BleTraceRequestDump(void);
+
+/**
+ * @brief      Print the trace buffer on the UART if a dump was requested, decode with
+ *             tools/trace_decode.py. Blocks the caller for the duration of the output, call from the
+ *             BLE main loop outside of stack callbacks.
+ * @param[in]  none
+ * @return     none
+ */
+void BleTraceTick(void);
+#else
+#define BLE_TRACE(id, arg)
+#endif /* TELINK_BLE_TRACE_ENABLE */
+
+#endif /* VENDOR_B91_GATT_SAMPLE_BLE_TRACE_H */
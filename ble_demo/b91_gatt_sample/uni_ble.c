@@ -16,19 +16,290 @@
  *
  *****************************************************************************/
 
+#include <string.h>
+
 #include <los_compiler.h>
 
 #include <tl_common.h>
 #include <drivers.h>
 #include <stack/ble/ble.h>
 
-#include "uni_ble.h"
+#include <evt_ring.h>
 
-struct {
+#include "ble_log.h"
+#include "ble_trace.h"
+#include "uni_ble.h"
+#include "uni_ble_conn_param.h"
+#include "uni_ble_phy.h"
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+#include "uni_ble_notify.h"
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE
+#include "uni_ble_diag.h"
+#endif /* TELINK_BLE_DIAG_ENABLE */
+#include "uni_ble_prof.h"
+
+/* Number of events buffered between stack context and the application, must be a power of two */
+#define UNI_BLE_EVT_QUEUE_LEN 8
+
+typedef enum {
+    UNI_BLE_EVT_CONNECT,
+    UNI_BLE_EVT_DISCONNECT,
+    UNI_BLE_EVT_CONN_UPDATE,
+    UNI_BLE_EVT_PHY_UPDATE,
+} uni_ble_evt_type_t;
+
+typedef struct {
+    u8 type;
+    u8 reason;
+    uni_ble_conn_info_t conn;
+} uni_ble_evt_t;
+
+UNI_BLE_RETENTION_DATA struct {
     connect_cb_t connect;
-    connect_cb_t disconnect;
+    disconnect_cb_t disconnect;
+    connect_cb_t conn_update;
+    struct {
+        u8 used;
+        uni_ble_conn_info_t info;
+    } conn[UNI_BLE_MAX_CONN];
+    EvtRing evtRing;
+    uni_ble_evt_t evtBuff[UNI_BLE_EVT_QUEUE_LEN];
+    /** connections refused because the table was full */
+    u32 connRejects;
 } g_app_ble_state;
 
+static void uni_ble_post_event(u8 type, const uni_ble_conn_info_t *conn, u8 reason)
+{
+    uni_ble_evt_t evt = {
+        .type = type,
+        .reason = reason,
+        .conn = *conn,
+    };
+
+    (void)EvtRingPush(&g_app_ble_state.evtRing, &evt);
+}
+
+void uni_ble_process_events(void)
+{
+    uni_ble_evt_t evt;
+
+    while (EvtRingPop(&g_app_ble_state.evtRing, &evt) == 0) {
+        BLE_TRACE(BLE_TRACE_APP_EVENT, evt.type);
+        if (evt.type == UNI_BLE_EVT_CONNECT) {
+            uni_ble_conn_policy_on_connect(&evt.conn);
+            uni_ble_phy_policy_on_connect(&evt.conn);
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+            uni_ble_notify_on_connect(&evt.conn);
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE
+            uni_ble_diag_on_connect(&evt.conn);
+#endif /* TELINK_BLE_DIAG_ENABLE */
+            connect_cb_t func = g_app_ble_state.connect;
+            if (func) {
+                UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_APP_CB);
+                func(&evt.conn);
+                UNI_BLE_PROF_END(UNI_BLE_PROF_APP_CB);
+            }
+        } else if (evt.type == UNI_BLE_EVT_DISCONNECT) {
+            uni_ble_conn_policy_on_disconnect(&evt.conn);
+            uni_ble_phy_policy_on_disconnect(&evt.conn);
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+            uni_ble_notify_on_disconnect(&evt.conn);
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE
+            uni_ble_diag_on_disconnect(&evt.conn);
+#endif /* TELINK_BLE_DIAG_ENABLE */
+            disconnect_cb_t func = g_app_ble_state.disconnect;
+            if (func) {
+                UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_APP_CB);
+                func(&evt.conn, evt.reason);
+                UNI_BLE_PROF_END(UNI_BLE_PROF_APP_CB);
+            }
+        } else if (evt.type == UNI_BLE_EVT_CONN_UPDATE || evt.type == UNI_BLE_EVT_PHY_UPDATE) {
+            if (evt.type == UNI_BLE_EVT_CONN_UPDATE) {
+                uni_ble_conn_policy_on_update(&evt.conn);
+            } else {
+                uni_ble_phy_policy_on_update(&evt.conn);
+            }
+            connect_cb_t func = g_app_ble_state.conn_update;
+            if (func) {
+                UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_APP_CB);
+                func(&evt.conn);
+                UNI_BLE_PROF_END(UNI_BLE_PROF_APP_CB);
+            }
+        }
+    }
+}
+
+void uni_ble_get_event_queue_stats(u32 *pending, u32 *drops, u32 *highWater)
+{
+    *pending = EvtRingCount(&g_app_ble_state.evtRing);
+    *drops = g_app_ble_state.evtRing.drops;
+    *highWater = g_app_ble_state.evtRing.highWater;
+}
+
+u32 uni_ble_get_conn_rejects(void)
+{
+    return g_app_ble_state.connRejects;
+}
+
+static void uni_ble_events_init(void)
+{
+    (void)EvtRingInit(&g_app_ble_state.evtRing, g_app_ble_state.evtBuff, sizeof(uni_ble_evt_t),
+                      UNI_BLE_EVT_QUEUE_LEN);
+}
+
+static int uni_ble_conn_index(u16 connHandle)
+{
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_app_ble_state.conn[i].used && g_app_ble_state.conn[i].info.connHandle == connHandle) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief      Store a new connection in the table and queue the connect event
+ * @param[in]  info connection information decoded from the stack event
+ * @return     none
+ */
+static void uni_ble_conn_up(const uni_ble_conn_info_t *info)
+{
+    int idx = uni_ble_conn_index(info->connHandle);
+
+    for (int i = 0; idx < 0 && i < UNI_BLE_MAX_CONN; i++) {
+        if (!g_app_ble_state.conn[i].used) {
+            idx = i;
+        }
+    }
+
+    /* The controller accepted a link the table has no room for, so nothing would ever serve it */
+    if (idx < 0) {
+        g_app_ble_state.connRejects++;
+        BLE_LOG(BLE_LOG_CONN_REJECT, info->connHandle, (unsigned)g_app_ble_state.connRejects);
+        (void)uni_ble_ll_disconnect(info->connHandle, HCI_ERR_CONN_REJ_LIMITED_RESOURCES);
+        return;
+    }
+
+    g_app_ble_state.conn[idx].used = 1;
+    g_app_ble_state.conn[idx].info = *info;
+
+    uni_ble_post_event(UNI_BLE_EVT_CONNECT, info, 0);
+}
+
+/**
+ * @brief      Remove a connection from the table and queue the disconnect event
+ * @param[in]  connHandle connection handle
+ * @param[in]  reason     HCI disconnect reason
+ * @return     none
+ */
+static void uni_ble_conn_down(u16 connHandle, u8 reason)
+{
+    int idx = uni_ble_conn_index(connHandle);
+
+    if (idx < 0) {
+        return;
+    }
+
+    g_app_ble_state.conn[idx].used = 0;
+
+    uni_ble_post_event(UNI_BLE_EVT_DISCONNECT, &g_app_ble_state.conn[idx].info, reason);
+}
+
+/**
+ * @brief      Record connection parameters accepted by the central and queue the update event
+ */
+static void uni_ble_conn_updated(u16 connHandle, u16 interval, u16 latency, u16 timeout)
+{
+    int idx = uni_ble_conn_index(connHandle);
+
+    if (idx < 0) {
+        return;
+    }
+
+    uni_ble_conn_info_t *info = &g_app_ble_state.conn[idx].info;
+    info->interval = interval;
+    info->latency = latency;
+    info->timeout = timeout;
+
+    uni_ble_post_event(UNI_BLE_EVT_CONN_UPDATE, info, 0);
+}
+
+/**
+ * @brief      Record the PHY reported by HCI LE PHY Update Complete and queue the update event
+ */
+static void uni_ble_phy_updated(const u8 *param)
+{
+    hci_le_phyUpdateCompleteEvt_t *pPhyEvt = (hci_le_phyUpdateCompleteEvt_t *)param;
+    if (pPhyEvt->status != BLE_SUCCESS) {
+        return;
+    }
+
+    int idx = uni_ble_conn_index(pPhyEvt->connHandle);
+    if (idx < 0) {
+        return;
+    }
+
+    uni_ble_conn_info_t *info = &g_app_ble_state.conn[idx].info;
+    info->txPhy = pPhyEvt->tx_phy;
+    info->rxPhy = pPhyEvt->rx_phy;
+
+    uni_ble_post_event(UNI_BLE_EVT_PHY_UPDATE, info, 0);
+}
+
+void uni_ble_ll_init2MPhyCodedPhy_feature(void)
+{
+    blc_ll_init2MPhyCodedPhy_feature();
+}
+
+ble_sts_t uni_ble_ll_setPhy(u16 connHandle, u8 phys, le_ci_prefer_t codedOption)
+{
+    return blc_ll_setPhy(connHandle, PHY_TRX_PREFER, phys, phys, codedOption);
+}
+
+/**
+ * @brief      L2CAP data handler, marks link activity for the connection parameter policy
+ */
+static int uni_ble_l2cap_data_handler(u16 connHandle, u8 *p)
+{
+    uni_ble_conn_policy_activity(connHandle);
+#if TELINK_BLE_DIAG_ENABLE
+    uni_ble_diag_on_rx(connHandle, p);
+#endif /* TELINK_BLE_DIAG_ENABLE */
+
+#if TELINK_SDK_B91_BLE_MULTI
+    return blc_l2cap_pktHandler(connHandle, p);
+#else
+    return blc_l2cap_packet_receive(connHandle, p);
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+}
+
+void uni_ble_register_conn_update_cb(connect_cb_t on_update)
+{
+    g_app_ble_state.conn_update = on_update;
+}
+
+const uni_ble_conn_info_t *uni_ble_get_conn(u16 connHandle)
+{
+    int idx = uni_ble_conn_index(connHandle);
+
+    return (idx < 0) ? NULL : &g_app_ble_state.conn[idx].info;
+}
+
+int uni_ble_get_conn_count(void)
+{
+    int count = 0;
+
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        count += g_app_ble_state.conn[i].used;
+    }
+
+    return count;
+}
+
 #if TELINK_SDK_B91_BLE_SINGLE
 
 ble_sts_t uni_ble_ll_setAdvParam(u16 intervalMin, u16 intervalMax, adv_type_t advType, own_addr_type_t ownAddrType,
@@ -61,6 +332,65 @@ ble_sts_t uni_ble_ll_initAclConnTxFifo(u8 *pTxbuf, int fifo_size, int fifo_numbe
     return blc_ll_initAclConnTxFifo(pTxbuf, fifo_size, fifo_number);
 }
 
+ble_sts_t uni_ble_ll_setAclConnMaxOctetsNumber(u8 maxRxOct, u8 maxTxOct)
+{
+    return blc_ll_setAclConnMaxOctetsNumber(maxRxOct, maxTxOct);
+}
+
+ble_sts_t uni_ble_att_setRxMtuSize(u16 mtu_size)
+{
+    return blc_att_setRxMtuSize(mtu_size);
+}
+
+void uni_ble_l2cap_initMtuBuffer(u8 *pRxbuf, u16 rx_size, u8 *pTxbuf, u16 tx_size)
+{
+    blc_l2cap_initMtuBuffer(pRxbuf, rx_size, pTxbuf, tx_size);
+}
+
+ble_sts_t uni_ble_ll_exchangeDataLength(u16 connHandle, u16 maxTxOct)
+{
+    UNUSED(connHandle);
+
+    return blc_ll_exchangeDataLength(LL_LENGTH_REQ, maxTxOct);
+}
+
+ble_sts_t uni_ble_att_requestMtuSizeExchange(u16 connHandle, u16 mtu_size)
+{
+    return blc_att_requestMtuSizeExchange(connHandle, mtu_size);
+}
+
+ble_sts_t uni_ble_att_pushNotifyData(u16 connHandle, u16 attHandle, u8 *p, int len)
+{
+    ble_sts_t status = bls_att_pushNotifyData(attHandle, p, len);
+#if TELINK_BLE_DIAG_ENABLE
+    uni_ble_diag_on_tx(connHandle, len, status);
+#endif /* TELINK_BLE_DIAG_ENABLE */
+    if (status == BLE_SUCCESS) {
+        uni_ble_conn_policy_activity(connHandle);
+    }
+
+    return status;
+}
+
+u16 uni_ble_att_getEffectiveMtuSize(u16 connHandle)
+{
+    return blc_att_getEffectiveMtuSize(connHandle);
+}
+
+u16 uni_ble_ll_getConnectionInterval(u16 connHandle)
+{
+    UNUSED(connHandle);
+
+    return bls_ll_getConnectionInterval();
+}
+
+u8 uni_ble_ll_getTxFifoNumber(u16 connHandle)
+{
+    UNUSED(connHandle);
+
+    return blc_ll_getTxFifoNumber();
+}
+
 void uni_ble_init(void)
 {
     blc_gap_peripheral_init();
@@ -69,7 +399,7 @@ void uni_ble_init(void)
 void uni_ble_l2cap_register_data_handler(void)
 {
     /* L2CAP initialization */
-    blc_l2cap_register_handler((void *)blc_l2cap_packet_receive);
+    blc_l2cap_register_handler((void *)uni_ble_l2cap_data_handler);
 }
 
 void uni_ble_ll_initAdvertising_module(void)
@@ -89,44 +419,126 @@ void uni_ble_ll_initSlaveRole_module(void)
 
 void uni_ble_sdk_main_loop(void)
 {
+    UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_SDK_MAIN_LOOP);
     blt_sdk_main_loop();
+    UNI_BLE_PROF_END(UNI_BLE_PROF_SDK_MAIN_LOOP);
 }
 
 _attribute_ram_code_ void uni_ble_sdk_irq_handler(void)
 {
+    UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_SDK_IRQ);
     irq_blt_sdk_handler();
+    UNI_BLE_PROF_END(UNI_BLE_PROF_SDK_IRQ);
+}
+
+void uni_ble_pm_initDeepRetention(void)
+{
+    blc_ll_initPowerManagement_module();
+    bls_pm_setSuspendMask(SUSPEND_ADV | DEEPSLEEP_RETENTION_ADV | SUSPEND_CONN | DEEPSLEEP_RETENTION_CONN);
+}
+
+void uni_ble_ll_recoverDeepRetention(void)
+{
+    blc_ll_recoverDeepRetention();
 }
 
+/**
+ * @brief      BLT_EV_FLAG_CONNECT call-back, p points to the CONNECT_IND packet
+ */
 static void connect_cb(u8 e, u8 *p, int n)
 {
     UNUSED(e);
-    UNUSED(p);
     UNUSED(n);
 
-    connect_cb_t func = g_app_ble_state.connect;
-    if (func) {
-        func();
-    }
+    rf_packet_connect_t *pConnReq = (rf_packet_connect_t *)p;
+    uni_ble_conn_info_t info = {
+        .connHandle = BLS_CONN_HANDLE,
+        .role = LL_ROLE_SLAVE,
+        .peerAddrType = pConnReq->txAddr,
+        .interval = pConnReq->interval,
+        .latency = pConnReq->latency,
+        .timeout = pConnReq->timeout,
+        .txPhy = BLE_PHY_1M,
+        .rxPhy = BLE_PHY_1M,
+    };
+    memcpy(info.peerAddr, pConnReq->initA, sizeof(info.peerAddr));
+
+    uni_ble_conn_up(&info);
 }
 
+/**
+ * @brief      BLT_EV_FLAG_TERMINATE call-back, p points to the terminate reason
+ */
 static void disconnect_cb(u8 e, u8 *p, int n)
 {
     UNUSED(e);
-    UNUSED(p);
     UNUSED(n);
 
-    connect_cb_t func = g_app_ble_state.disconnect;
-    if (func) {
-        func();
+    uni_ble_conn_down(BLS_CONN_HANDLE, *p);
+}
+
+/**
+ * @brief      BLT_EV_FLAG_CONN_PARA_UPDATE call-back, p points to new interval, latency and timeout
+ */
+static void conn_update_cb(u8 e, u8 *p, int n)
+{
+    UNUSED(e);
+    UNUSED(n);
+
+    uni_ble_conn_updated(BLS_CONN_HANDLE, MAKE_U16(p[1], p[0]), MAKE_U16(p[3], p[2]), MAKE_U16(p[5], p[4]));
+}
+
+ble_sts_t uni_ble_l2cap_requestConnParamUpdate(u16 connHandle, u16 min_interval, u16 max_interval, u16 latency,
+                                               u16 timeout)
+{
+    UNUSED(connHandle);
+
+    bls_l2cap_requestConnParamUpdate(min_interval, max_interval, latency, timeout);
+
+    return BLE_SUCCESS;
+}
+
+ble_sts_t uni_ble_ll_disconnect(u16 connHandle, u8 reason)
+{
+    UNUSED(connHandle);
+
+    return bls_ll_terminateConnection(reason);
+}
+
+s8 uni_ble_ll_getRssi(u16 connHandle)
+{
+    UNUSED(connHandle);
+
+    /* averaged RSSI is reported with an offset of 110 */
+    return (s8)(blc_ll_getLatestAvgRSSI() - 110);
+}
+
+/**
+ * @brief      BLE controller event handler call-back, only PHY updates are reported through HCI here
+ */
+static int controller_event_cb(u32 event, u8 *param, int paramLen)
+{
+    UNUSED(paramLen);
+
+    if ((event & HCI_FLAG_EVENT_BT_STD) && (event & 0xff) == HCI_EVT_LE_META &&
+        param[0] == HCI_SUB_EVT_LE_PHY_UPDATE_COMPLETE) {
+        uni_ble_phy_updated(param);
     }
+
+    return 0;
 }
 
-void uni_ble_register_connect_disconnect_cb(connect_cb_t on_connect, connect_cb_t on_disconnect)
+void uni_ble_register_connect_disconnect_cb(connect_cb_t on_connect, disconnect_cb_t on_disconnect)
 {
     g_app_ble_state.connect = on_connect;
     g_app_ble_state.disconnect = on_disconnect;
+    uni_ble_events_init();
     bls_app_registerEventCallback(BLT_EV_FLAG_CONNECT, connect_cb);
     bls_app_registerEventCallback(BLT_EV_FLAG_TERMINATE, disconnect_cb);
+    bls_app_registerEventCallback(BLT_EV_FLAG_CONN_PARA_UPDATE, conn_update_cb);
+
+    blc_hci_le_setEventMask_cmd(HCI_LE_EVT_MASK_PHY_UPDATE_COMPLETE);
+    blc_hci_registerControllerEventHandler(controller_event_cb);
 }
 
 #elif TELINK_SDK_B91_BLE_MULTI
@@ -159,6 +571,60 @@ ble_sts_t uni_ble_ll_initAclConnTxFifo(u8 *pTxbuf, int fifo_size, int fifo_numbe
     return  blc_ll_initAclConnSlaveTxFifo(pTxbuf, fifo_size, fifo_number, conn_number);
 }
 
+ble_sts_t uni_ble_ll_setAclConnMaxOctetsNumber(u8 maxRxOct, u8 maxTxOct)
+{
+    /* This sample runs slave role only, master TX octets are kept at the minimum */
+    return blc_ll_setAclConnMaxOctetsNumber(maxRxOct, 27, maxTxOct);
+}
+
+ble_sts_t uni_ble_att_setRxMtuSize(u16 mtu_size)
+{
+    return blc_att_setSlaveRxMTUSize(mtu_size);
+}
+
+void uni_ble_l2cap_initMtuBuffer(u8 *pRxbuf, u16 rx_size, u8 *pTxbuf, u16 tx_size)
+{
+    blc_l2cap_initAclConnSlaveMtuBuffer(pRxbuf, rx_size, pTxbuf, tx_size);
+}
+
+ble_sts_t uni_ble_ll_exchangeDataLength(u16 connHandle, u16 maxTxOct)
+{
+    return blc_ll_sendDateLengthExtendReq(connHandle, maxTxOct);
+}
+
+ble_sts_t uni_ble_att_requestMtuSizeExchange(u16 connHandle, u16 mtu_size)
+{
+    return blc_att_requestMtuSizeExchange(connHandle, mtu_size);
+}
+
+ble_sts_t uni_ble_att_pushNotifyData(u16 connHandle, u16 attHandle, u8 *p, int len)
+{
+    ble_sts_t status = blc_gatt_pushHandleValueNotify(connHandle, attHandle, p, len);
+#if TELINK_BLE_DIAG_ENABLE
+    uni_ble_diag_on_tx(connHandle, len, status);
+#endif /* TELINK_BLE_DIAG_ENABLE */
+    if (status == BLE_SUCCESS) {
+        uni_ble_conn_policy_activity(connHandle);
+    }
+
+    return status;
+}
+
+u16 uni_ble_att_getEffectiveMtuSize(u16 connHandle)
+{
+    return blc_att_getEffectiveMtuSize(connHandle);
+}
+
+u16 uni_ble_ll_getConnectionInterval(u16 connHandle)
+{
+    return blc_ll_getAclConnectionInterval(connHandle);
+}
+
+u8 uni_ble_ll_getTxFifoNumber(u16 connHandle)
+{
+    return blc_ll_getTxFifoNumber(connHandle);
+}
+
 void uni_ble_init(void)
 {
     blc_gap_init();
@@ -167,7 +633,7 @@ void uni_ble_init(void)
 void uni_ble_l2cap_register_data_handler(void)
 {
     /* HCI initialization begin */
-    blc_hci_registerControllerDataHandler(blc_l2cap_pktHandler);
+    blc_hci_registerControllerDataHandler(uni_ble_l2cap_data_handler);
 }
 
 void uni_ble_ll_initAdvertising_module(void)
@@ -187,12 +653,35 @@ void uni_ble_ll_initSlaveRole_module(void)
 
 void uni_ble_sdk_main_loop(void)
 {
+    UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_SDK_MAIN_LOOP);
     blc_sdk_main_loop();
+    UNI_BLE_PROF_END(UNI_BLE_PROF_SDK_MAIN_LOOP);
 }
 
 _attribute_ram_code_ void uni_ble_sdk_irq_handler(void)
 {
+    UNI_BLE_PROF_BEGIN(UNI_BLE_PROF_SDK_IRQ);
     blc_sdk_irq_handler();
+    UNI_BLE_PROF_END(UNI_BLE_PROF_SDK_IRQ);
+}
+
+ble_sts_t uni_ble_l2cap_requestConnParamUpdate(u16 connHandle, u16 min_interval, u16 max_interval, u16 latency,
+                                               u16 timeout)
+{
+    blc_l2cap_sendConnParamUpdateReq(connHandle, min_interval, max_interval, latency, timeout);
+
+    return BLE_SUCCESS;
+}
+
+ble_sts_t uni_ble_ll_disconnect(u16 connHandle, u8 reason)
+{
+    return blc_ll_disconnect(connHandle, reason);
+}
+
+s8 uni_ble_ll_getRssi(u16 connHandle)
+{
+    /* averaged RSSI is reported with an offset of 110 */
+    return (s8)(blc_ll_getLatestAvgRSSI(connHandle) - 110);
 }
 
 /**
@@ -211,19 +700,39 @@ static int AppControllerEventCallback(u32 event, u8 *param, int paramLen)
 
         // ------------ disconnect -------------------------------------
         if (evtCode == HCI_EVT_DISCONNECTION_COMPLETE) {
-            connect_cb_t func = g_app_ble_state.disconnect;
-            if (func) {
-                func();
-            }
+            event_disconnection_t *pDisConn = (event_disconnection_t *)param;
+            uni_ble_conn_down(pDisConn->connHandle, pDisConn->reason);
         } else if (evtCode == HCI_EVT_LE_META) {
             u8 subEvt_code = param[0];
 
             // ------hci le event: le connection complete event---------------------------------
             if (subEvt_code == HCI_SUB_EVT_LE_CONNECTION_COMPLETE) {
-                connect_cb_t func = g_app_ble_state.connect;
-                if (func) {
-                    func();
+                hci_le_connectionCompleteEvt_t *pConnEvt = (hci_le_connectionCompleteEvt_t *)param;
+                if (pConnEvt->status != BLE_SUCCESS) {
+                    return 0;
+                }
+
+                uni_ble_conn_info_t info = {
+                    .connHandle = pConnEvt->connHandle,
+                    .role = pConnEvt->role,
+                    .peerAddrType = pConnEvt->peerAddrType,
+                    .interval = pConnEvt->connInterval,
+                    .latency = pConnEvt->slaveLatency,
+                    .timeout = pConnEvt->supervisionTimeout,
+                    .txPhy = BLE_PHY_1M,
+                    .rxPhy = BLE_PHY_1M,
+                };
+                memcpy(info.peerAddr, pConnEvt->peerAddr, sizeof(info.peerAddr));
+
+                uni_ble_conn_up(&info);
+            } else if (subEvt_code == HCI_SUB_EVT_LE_CONNECTION_UPDATE_COMPLETE) {
+                hci_le_connectionUpdateCompleteEvt_t *pUpdEvt = (hci_le_connectionUpdateCompleteEvt_t *)param;
+                if (pUpdEvt->status == BLE_SUCCESS) {
+                    uni_ble_conn_updated(pUpdEvt->connHandle, pUpdEvt->connInterval, pUpdEvt->connLatency,
+                                         pUpdEvt->supervisionTimeout);
                 }
+            } else if (subEvt_code == HCI_SUB_EVT_LE_PHY_UPDATE_COMPLETE) {
+                uni_ble_phy_updated(param);
             }
         }
     }
@@ -231,12 +740,14 @@ static int AppControllerEventCallback(u32 event, u8 *param, int paramLen)
     return 0;
 }
 
-void uni_ble_register_connect_disconnect_cb(connect_cb_t on_connect, connect_cb_t on_disconnect)
+void uni_ble_register_connect_disconnect_cb(connect_cb_t on_connect, disconnect_cb_t on_disconnect)
 {
     g_app_ble_state.connect = on_connect;
     g_app_ble_state.disconnect = on_disconnect;
+    uni_ble_events_init();
 
-    blc_hci_le_setEventMask_cmd(HCI_EVT_MASK_DISCONNECTION_COMPLETE | HCI_LE_EVT_MASK_CONNECTION_COMPLETE);
+    blc_hci_le_setEventMask_cmd(HCI_EVT_MASK_DISCONNECTION_COMPLETE | HCI_LE_EVT_MASK_CONNECTION_COMPLETE |
+                                HCI_LE_EVT_MASK_CONNECTION_UPDATE_COMPLETE | HCI_LE_EVT_MASK_PHY_UPDATE_COMPLETE);
 
     // controller hci event to host all processed in this func
     blc_hci_registerControllerEventHandler(AppControllerEventCallback);
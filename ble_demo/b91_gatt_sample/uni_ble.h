@@ -21,7 +21,61 @@
 
 #include <stack/ble/ble.h>
 
-typedef void (*connect_cb_t)(void);
+#include "app_config.h"
+
+#if TELINK_SDK_B91_BLE_MULTI
+#if TELINK_BLE_SLAVE_MAX_NUM
+_Static_assert(TELINK_BLE_SLAVE_MAX_NUM <= SLAVE_MAX_NUM, "telink_ble_slave_max_num exceeds SLAVE_MAX_NUM of the SDK");
+#define UNI_BLE_MAX_CONN TELINK_BLE_SLAVE_MAX_NUM
+#else
+#define UNI_BLE_MAX_CONN SLAVE_MAX_NUM
+#endif /* TELINK_BLE_SLAVE_MAX_NUM */
+#else
+#define UNI_BLE_MAX_CONN 1
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+
+/**
+ *  @brief  Connection information passed to connect/disconnect callbacks
+ */
+typedef struct {
+    u16 connHandle;
+    /** LL_ROLE_MASTER or LL_ROLE_SLAVE */
+    u8 role;
+    u8 peerAddrType;
+    u8 peerAddr[6];
+    /** Connection interval (1.25 ms units) */
+    u16 interval;
+    /** Peripheral latency (connection events) */
+    u16 latency;
+    /** Supervision timeout (10 ms units) */
+    u16 timeout;
+    /** Current PHY as in HCI LE PHY Update Complete: 1 - 1M, 2 - 2M, 3 - Coded */
+    u8 txPhy;
+    u8 rxPhy;
+} uni_ble_conn_info_t;
+
+typedef void (*connect_cb_t)(const uni_ble_conn_info_t *conn);
+
+typedef void (*disconnect_cb_t)(const uni_ble_conn_info_t *conn, u8 reason);
+
+/* Parameter list of attribute read/write callbacks differs between single and multi connection SDK */
+#if TELINK_SDK_B91_BLE_MULTI
+#define UNI_BLE_ATT_CB_PARAMS(p)   u16 connHandle, void *p
+#define UNI_BLE_ATT_CB_CONN_HANDLE (connHandle)
+#else
+#define UNI_BLE_ATT_CB_PARAMS(p)   void *p
+#define UNI_BLE_ATT_CB_CONN_HANDLE (BLS_CONN_HANDLE)
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+
+/* Data that must survive deepSleep retention, only the single connection SDK supports it */
+#if TELINK_BLE_DEEP_RETENTION_ENABLE
+#if TELINK_SDK_B91_BLE_MULTI
+#error "deepSleep retention is supported with TELINK_SDK_B91_BLE_SINGLE only"
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+#define UNI_BLE_RETENTION_DATA _attribute_data_retention_
+#else
+#define UNI_BLE_RETENTION_DATA
+#endif /* TELINK_BLE_DEEP_RETENTION_ENABLE */
 
 ble_sts_t uni_ble_ll_setAdvParam(u16 intervalMin, u16 intervalMax, adv_type_t advType, own_addr_type_t ownAddrType,
                                  u8 peerAddrType, u8 *peerAddr, adv_chn_map_t adv_channelMap,
@@ -35,6 +89,27 @@ ble_sts_t uni_ble_ll_setAdvEnable(int adv_enable);
 
 ble_sts_t uni_ble_ll_initAclConnTxFifo(u8 *pTxbuf, int fifo_size, int fifo_number, int conn_number);
 
+ble_sts_t uni_ble_ll_setAclConnMaxOctetsNumber(u8 maxRxOct, u8 maxTxOct);
+
+ble_sts_t uni_ble_att_setRxMtuSize(u16 mtu_size);
+
+void uni_ble_l2cap_initMtuBuffer(u8 *pRxbuf, u16 rx_size, u8 *pTxbuf, u16 tx_size);
+
+ble_sts_t uni_ble_ll_exchangeDataLength(u16 connHandle, u16 maxTxOct);
+
+ble_sts_t uni_ble_att_requestMtuSizeExchange(u16 connHandle, u16 mtu_size);
+
+ble_sts_t uni_ble_att_pushNotifyData(u16 connHandle, u16 attHandle, u8 *p, int len);
+
+u16 uni_ble_att_getEffectiveMtuSize(u16 connHandle);
+
+u16 uni_ble_ll_getConnectionInterval(u16 connHandle);
+
+/**
+ * @brief      Number of packets waiting in the ACL TX FIFO of a link
+ */
+u8 uni_ble_ll_getTxFifoNumber(u16 connHandle);
+
 void uni_ble_init(void);
 
 void uni_ble_l2cap_register_data_handler(void);
@@ -49,6 +124,79 @@ void uni_ble_sdk_main_loop(void);
 
 void uni_ble_sdk_irq_handler(void);
 
-void uni_ble_register_connect_disconnect_cb(connect_cb_t on_connect, connect_cb_t on_disconnect);
+#if TELINK_SDK_B91_BLE_SINGLE
+void uni_ble_pm_initDeepRetention(void);
+
+void uni_ble_ll_recoverDeepRetention(void);
+#endif /* TELINK_SDK_B91_BLE_SINGLE */
+
+ble_sts_t uni_ble_l2cap_requestConnParamUpdate(u16 connHandle, u16 min_interval, u16 max_interval, u16 latency,
+                                               u16 timeout);
+
+void uni_ble_register_connect_disconnect_cb(connect_cb_t on_connect, disconnect_cb_t on_disconnect);
+
+void uni_ble_ll_init2MPhyCodedPhy_feature(void);
+
+/**
+ * @brief      Request a PHY change on a connection
+ * @param[in]  connHandle   connection handle
+ * @param[in]  phys         PHY_PREFER_1M, PHY_PREFER_2M or PHY_PREFER_CODED, used for both TX and RX
+ * @param[in]  codedOption  preferred coding when Coded PHY is requested
+ * @return     BLE_SUCCESS if the request was accepted by the controller
+ */
+ble_sts_t uni_ble_ll_setPhy(u16 connHandle, u8 phys, le_ci_prefer_t codedOption);
+
+/**
+ * @brief      Terminate a connection
+ * @param[in]  connHandle   connection handle, the single connection SDK only has one link
+ * @param[in]  reason       HCI error code sent to the peer
+ * @return     BLE_SUCCESS if the request was accepted by the controller
+ */
+ble_sts_t uni_ble_ll_disconnect(u16 connHandle, u8 reason);
+
+/**
+ * @brief      Get the averaged RSSI of a connection
+ * @param[in]  connHandle   connection handle
+ * @return     RSSI in dBm
+ */
+s8 uni_ble_ll_getRssi(u16 connHandle);
+
+/**
+ * @brief      Register a call-back for connection parameter and PHY updates
+ * @param[in]  on_update  called with the updated connection information
+ * @return     none
+ */
+void uni_ble_register_conn_update_cb(connect_cb_t on_update);
+
+/**
+ * @brief      Look up an established connection
+ * @param[in]  connHandle connection handle
+ * @return     connection information, NULL if there is no such connection
+ */
+const uni_ble_conn_info_t *uni_ble_get_conn(u16 connHandle);
+
+int uni_ble_get_conn_count(void);
+
+/**
+ * @brief      Deliver queued connect/disconnect events to the application callbacks.
+ *             Stack callbacks only post events, so this must be called from a safe point of the BLE task.
+ * @param[in]  none
+ * @return     none
+ */
+void uni_ble_process_events(void);
+
+/**
+ * @brief      Get event queue statistics
+ * @param[out] pending    events waiting for uni_ble_process_events()
+ * @param[out] drops      events lost because the queue was full
+ * @param[out] highWater  maximum number of queued events
+ * @return     none
+ */
+void uni_ble_get_event_queue_stats(u32 *pending, u32 *drops, u32 *highWater);
+
+/**
+ * @brief      Number of connections terminated because the connection table was full
+ */
+u32 uni_ble_get_conn_rejects(void);
 
 #endif // UNI_BLE_H
@@ -0,0 +1,183 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <los_compiler.h>
+#include <hiview_log.h>
+
+#include <tl_common.h>
+#include <drivers.h>
+#include <stack/ble/ble.h>
+
+#include "ble_log.h"
+#include "uni_ble.h"
+#include "uni_ble_conn_param.h"
+
+#define US_PER_MS 1000
+
+typedef enum {
+    CONN_MODE_NONE = 0,
+    CONN_MODE_ACTIVE,
+    CONN_MODE_IDLE,
+} conn_mode_t;
+
+UNI_BLE_RETENTION_DATA static struct {
+    uni_ble_conn_policy_t policy;
+    u8 enabled;
+    struct {
+        u16 connHandle;
+        u8 used;
+        /** mode of the last request, CONN_MODE_NONE if none sent yet */
+        u8 requested;
+        u32 activityTick;
+        u32 requestTick;
+    } link[UNI_BLE_MAX_CONN];
+} g_uni_ble_conn_policy;
+
+static int conn_policy_index(u16 connHandle)
+{
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_uni_ble_conn_policy.link[i].used && g_uni_ble_conn_policy.link[i].connHandle == connHandle) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief      Check whether the parameters accepted by the central match a mode
+ */
+static bool conn_policy_matches(const uni_ble_conn_info_t *conn, conn_mode_t mode)
+{
+    const uni_ble_conn_policy_t *policy = &g_uni_ble_conn_policy.policy;
+
+    if (mode == CONN_MODE_ACTIVE) {
+        return conn->interval >= policy->activeIntervalMin && conn->interval <= policy->activeIntervalMax &&
+               conn->latency == policy->activeLatency;
+    }
+
+    return conn->interval >= policy->idleIntervalMin && conn->interval <= policy->idleIntervalMax &&
+           conn->latency == policy->idleLatency;
+}
+
+static void conn_policy_request(int idx, const uni_ble_conn_info_t *conn, conn_mode_t mode)
+{
+    const uni_ble_conn_policy_t *policy = &g_uni_ble_conn_policy.policy;
+    ble_sts_t status;
+
+    if (mode == CONN_MODE_ACTIVE) {
+        status = uni_ble_l2cap_requestConnParamUpdate(conn->connHandle, policy->activeIntervalMin,
+                                                      policy->activeIntervalMax, policy->activeLatency,
+                                                      policy->timeout);
+    } else {
+        status = uni_ble_l2cap_requestConnParamUpdate(conn->connHandle, policy->idleIntervalMin,
+                                                      policy->idleIntervalMax, policy->idleLatency,
+                                                      policy->timeout);
+    }
+
+    if (status != BLE_SUCCESS) {
+        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_l2cap_requestConnParamUpdate(): %d", status);
+        return;
+    }
+
+    g_uni_ble_conn_policy.link[idx].requested = mode;
+    g_uni_ble_conn_policy.link[idx].requestTick = clock_time();
+}
+
+void uni_ble_conn_policy_init(const uni_ble_conn_policy_t *policy)
+{
+    g_uni_ble_conn_policy.policy = *policy;
+    g_uni_ble_conn_policy.enabled = 1;
+}
+
+void uni_ble_conn_policy_activity(u16 connHandle)
+{
+    int idx = conn_policy_index(connHandle);
+
+    if (idx >= 0) {
+        g_uni_ble_conn_policy.link[idx].activityTick = clock_time();
+    }
+}
+
+void uni_ble_conn_policy_tick(void)
+{
+    if (!g_uni_ble_conn_policy.enabled) {
+        return;
+    }
+
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (!g_uni_ble_conn_policy.link[i].used) {
+            continue;
+        }
+
+        const uni_ble_conn_info_t *conn = uni_ble_get_conn(g_uni_ble_conn_policy.link[i].connHandle);
+        if (conn == NULL) {
+            continue;
+        }
+
+        conn_mode_t mode = clock_time_exceed(g_uni_ble_conn_policy.link[i].activityTick,
+                                             g_uni_ble_conn_policy.policy.idleAfterMs * US_PER_MS) ?
+                           CONN_MODE_IDLE : CONN_MODE_ACTIVE;
+        if (conn_policy_matches(conn, mode)) {
+            g_uni_ble_conn_policy.link[i].requested = mode;
+            continue;
+        }
+
+        /* The central is free to reject or modify a request, so retry only after retryMs */
+        if (g_uni_ble_conn_policy.link[i].requested != mode ||
+            clock_time_exceed(g_uni_ble_conn_policy.link[i].requestTick,
+                              g_uni_ble_conn_policy.policy.retryMs * US_PER_MS)) {
+            conn_policy_request(i, conn, mode);
+        }
+    }
+}
+
+void uni_ble_conn_policy_on_connect(const uni_ble_conn_info_t *conn)
+{
+    int idx = conn_policy_index(conn->connHandle);
+
+    for (int i = 0; idx < 0 && i < UNI_BLE_MAX_CONN; i++) {
+        if (!g_uni_ble_conn_policy.link[i].used) {
+            idx = i;
+        }
+    }
+
+    if (idx < 0) {
+        return;
+    }
+
+    /* Service discovery follows a new connection, so start as active */
+    g_uni_ble_conn_policy.link[idx].used = 1;
+    g_uni_ble_conn_policy.link[idx].connHandle = conn->connHandle;
+    g_uni_ble_conn_policy.link[idx].requested = CONN_MODE_NONE;
+    g_uni_ble_conn_policy.link[idx].activityTick = clock_time();
+}
+
+void uni_ble_conn_policy_on_update(const uni_ble_conn_info_t *conn)
+{
+    BLE_LOG(BLE_LOG_CONN_PARAMS, conn->connHandle, conn->interval, conn->latency, conn->timeout);
+}
+
+void uni_ble_conn_policy_on_disconnect(const uni_ble_conn_info_t *conn)
+{
+    int idx = conn_policy_index(conn->connHandle);
+
+    if (idx >= 0) {
+        g_uni_ble_conn_policy.link[idx].used = 0;
+    }
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef UNI_BLE_CONN_PARAM_H
+#define UNI_BLE_CONN_PARAM_H
+
+#include "uni_ble.h"
+
+/**
+ *  @brief  Connection parameter policy: short interval without latency while data flows,
+ *          long interval with peripheral latency after a quiet period
+ */
+typedef struct {
+    /** Interval range while active (1.25 ms units) */
+    u16 activeIntervalMin;
+    u16 activeIntervalMax;
+    u16 activeLatency;
+    /** Interval range while idle (1.25 ms units) */
+    u16 idleIntervalMin;
+    u16 idleIntervalMax;
+    u16 idleLatency;
+    /** Supervision timeout (10 ms units), must cover (1 + idleLatency) * idleIntervalMax */
+    u16 timeout;
+    /** Quiet period without L2CAP traffic before switching to idle parameters */
+    u32 idleAfterMs;
+    /** Delay before repeating a request the central did not apply */
+    u32 retryMs;
+} uni_ble_conn_policy_t;
+
+/**
+ * @brief      Enable the policy for all current and future connections
+ * @param[in]  policy  parameters, copied
+ * @return     none
+ */
+void uni_ble_conn_policy_init(const uni_ble_conn_policy_t *policy);
+
+/**
+ * @brief      Mark traffic on a link, called by uni_ble for L2CAP RX and notifications.
+ *             Applications may call it to keep a link active ahead of a burst.
+ * @param[in]  connHandle  connection handle
+ * @return     none
+ */
+void uni_ble_conn_policy_activity(u16 connHandle);
+
+/**
+ * @brief      Issue connection parameter update requests where needed, call from the BLE main loop
+ * @param[in]  none
+ * @return     none
+ */
+void uni_ble_conn_policy_tick(void);
+
+/* Hooks called by uni_ble_process_events() */
+void uni_ble_conn_policy_on_connect(const uni_ble_conn_info_t *conn);
+
+void uni_ble_conn_policy_on_update(const uni_ble_conn_info_t *conn);
+
+void uni_ble_conn_policy_on_disconnect(const uni_ble_conn_info_t *conn);
+
+#endif // UNI_BLE_CONN_PARAM_H
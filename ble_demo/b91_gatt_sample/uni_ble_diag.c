@@ -0,0 +1,219 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <los_compiler.h>
+#include <hiview_log.h>
+
+#include <tl_common.h>
+#include <drivers.h>
+#include <stack/ble/ble.h>
+
+#include "uni_ble.h"
+#include "uni_ble_diag.h"
+
+#define US_PER_MS               1000
+#define CONN_INTERVAL_UNIT_US   1250
+/* ATT notification header: opcode + attribute handle */
+#define DIAG_ATT_HEADER_LEN     3
+/* LLID of an LL data PDU carrying the continuation of an L2CAP SDU */
+#define DIAG_LLID_MASK          0x03
+#define DIAG_LLID_CONTINUE      0x01
+
+#define DIAG_INC(cnt)           do { if ((cnt) != U16_MAX) { (cnt)++; } } while (0)
+
+UNI_BLE_RETENTION_DATA static struct {
+    uni_ble_diag_cfg_t cfg;
+    u8 enabled;
+    u32 reportTick;
+    struct {
+        u8 used;
+        /* packets received since the last main loop pass */
+        u8 rxPending;
+        u8 txFifoLast;
+        u32 txProgressTick;
+        uni_ble_diag_t diag;
+    } link[UNI_BLE_MAX_CONN];
+} g_uni_ble_diag;
+
+static int diag_index(u16 connHandle)
+{
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_uni_ble_diag.link[i].used && g_uni_ble_diag.link[i].diag.connHandle == connHandle) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void diag_report(int idx)
+{
+    const uni_ble_diag_t *diag = &g_uni_ble_diag.link[idx].diag;
+
+    HILOG_INFO(HILOG_MODULE_APP, "diag 0x%x tx: fifo peak %d/%d, drops %d, stalls %d", diag->connHandle,
+               diag->txFifoPeak, g_uni_ble_diag.cfg.txFifoNum, diag->txDrops, diag->txStalls);
+    HILOG_INFO(HILOG_MODULE_APP, "diag 0x%x rx: fifo peak %d/%d, full %d, fragments %d", diag->connHandle,
+               diag->rxFifoPeak, g_uni_ble_diag.cfg.rxFifoNum, diag->rxFifoFull, diag->rxFragments);
+    HILOG_INFO(HILOG_MODULE_APP, "diag 0x%x sdu peak: rx %d, tx %d, packets rx %u, tx %u", diag->connHandle,
+               diag->rxSduPeak, diag->txSduPeak, diag->rxPackets, diag->txPackets);
+}
+
+void uni_ble_diag_init(const uni_ble_diag_cfg_t *cfg)
+{
+    g_uni_ble_diag.cfg = *cfg;
+    g_uni_ble_diag.reportTick = clock_time();
+    g_uni_ble_diag.enabled = 1;
+}
+
+bool uni_ble_diag_get(u16 connHandle, uni_ble_diag_t *diag)
+{
+    int idx = diag_index(connHandle);
+
+    if (idx < 0) {
+        return false;
+    }
+
+    *diag = g_uni_ble_diag.link[idx].diag;
+
+    return true;
+}
+
+void uni_ble_diag_on_rx(u16 connHandle, const u8 *p)
+{
+    int idx = diag_index(connHandle);
+
+    if (idx < 0) {
+        return;
+    }
+
+    uni_ble_diag_t *diag = &g_uni_ble_diag.link[idx].diag;
+    const rf_packet_l2cap_t *pkt = (const rf_packet_l2cap_t *)p;
+
+    diag->rxPackets++;
+    if (g_uni_ble_diag.link[idx].rxPending != U8_MAX) {
+        g_uni_ble_diag.link[idx].rxPending++;
+    }
+
+    if ((pkt->type & DIAG_LLID_MASK) == DIAG_LLID_CONTINUE) {
+        DIAG_INC(diag->rxFragments);
+    } else {
+        diag->rxSduPeak = max(diag->rxSduPeak, pkt->l2capLen);
+    }
+}
+
+void uni_ble_diag_on_tx(u16 connHandle, int len, ble_sts_t status)
+{
+    int idx = diag_index(connHandle);
+
+    if (idx < 0) {
+        return;
+    }
+
+    uni_ble_diag_t *diag = &g_uni_ble_diag.link[idx].diag;
+
+    if (status != BLE_SUCCESS) {
+        DIAG_INC(diag->txDrops);
+        return;
+    }
+
+    diag->txPackets++;
+    diag->txSduPeak = max(diag->txSduPeak, len + DIAG_ATT_HEADER_LEN);
+}
+
+static void diag_sample(int idx)
+{
+    uni_ble_diag_t *diag = &g_uni_ble_diag.link[idx].diag;
+    u8 rxPending = g_uni_ble_diag.link[idx].rxPending;
+    u8 txFifo = uni_ble_ll_getTxFifoNumber(diag->connHandle);
+
+    g_uni_ble_diag.link[idx].rxPending = 0;
+    diag->rxFifoPeak = max(diag->rxFifoPeak, rxPending);
+    if (rxPending >= g_uni_ble_diag.cfg.rxFifoNum) {
+        DIAG_INC(diag->rxFifoFull);
+    }
+
+    diag->txFifoPeak = max(diag->txFifoPeak, txFifo);
+
+    /* The FIFO only drains on acknowledged packets, a full interval without progress means the peer NAKed */
+    const uni_ble_conn_info_t *conn = uni_ble_get_conn(diag->connHandle);
+    if (txFifo == 0 || txFifo < g_uni_ble_diag.link[idx].txFifoLast) {
+        g_uni_ble_diag.link[idx].txProgressTick = clock_time();
+    } else if (conn != NULL &&
+               clock_time_exceed(g_uni_ble_diag.link[idx].txProgressTick, conn->interval * CONN_INTERVAL_UNIT_US)) {
+        DIAG_INC(diag->txStalls);
+        g_uni_ble_diag.link[idx].txProgressTick = clock_time();
+    }
+    g_uni_ble_diag.link[idx].txFifoLast = txFifo;
+}
+
+void uni_ble_diag_tick(void)
+{
+    if (!g_uni_ble_diag.enabled) {
+        return;
+    }
+
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_uni_ble_diag.link[i].used) {
+            diag_sample(i);
+        }
+    }
+
+    if (g_uni_ble_diag.cfg.reportMs == 0 ||
+        !clock_time_exceed(g_uni_ble_diag.reportTick, g_uni_ble_diag.cfg.reportMs * US_PER_MS)) {
+        return;
+    }
+
+    g_uni_ble_diag.reportTick = clock_time();
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_uni_ble_diag.link[i].used) {
+            diag_report(i);
+        }
+    }
+}
+
+void uni_ble_diag_on_connect(const uni_ble_conn_info_t *conn)
+{
+    int idx = diag_index(conn->connHandle);
+
+    for (int i = 0; idx < 0 && i < UNI_BLE_MAX_CONN; i++) {
+        if (!g_uni_ble_diag.link[i].used) {
+            idx = i;
+        }
+    }
+
+    if (idx < 0) {
+        return;
+    }
+
+    memset(&g_uni_ble_diag.link[idx], 0, sizeof(g_uni_ble_diag.link[idx]));
+    g_uni_ble_diag.link[idx].diag.connHandle = conn->connHandle;
+    g_uni_ble_diag.link[idx].txProgressTick = clock_time();
+    g_uni_ble_diag.link[idx].used = 1;
+}
+
+void uni_ble_diag_on_disconnect(const uni_ble_conn_info_t *conn)
+{
+    int idx = diag_index(conn->connHandle);
+
+    if (idx >= 0) {
+        diag_report(idx);
+        g_uni_ble_diag.link[idx].used = 0;
+    }
+}
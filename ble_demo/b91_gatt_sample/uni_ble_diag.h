@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef UNI_BLE_DIAG_H
+#define UNI_BLE_DIAG_H
+
+#include "uni_ble.h"
+
+/**
+ *  @brief  Per-connection buffer counters, also the value of the diagnostics characteristic (little endian, packed)
+ */
+typedef struct __attribute__((packed)) {
+    u16 connHandle;
+    /** Most packets seen waiting in the ACL TX FIFO */
+    u8 txFifoPeak;
+    /** Most packets received between two main loop passes, i.e. RX FIFO entries in use */
+    u8 rxFifoPeak;
+    /** Notifications the stack refused, mostly because the TX FIFO was full */
+    u16 txDrops;
+    /** Main loop passes that found every RX FIFO entry used, the controller then NAKs the peer */
+    u16 rxFifoFull;
+    /** Connection intervals in which the TX FIFO made no progress, estimates retransmissions */
+    u16 txStalls;
+    /** L2CAP continuation fragments received */
+    u16 rxFragments;
+    /** Largest L2CAP SDU received and sent, compare with the L2CAP MTU buffers */
+    u16 rxSduPeak;
+    u16 txSduPeak;
+    u32 rxPackets;
+    u32 txPackets;
+} uni_ble_diag_t;
+
+typedef struct {
+    /** ACL TX/RX FIFO entries as passed to the FIFO init functions */
+    u8 txFifoNum;
+    u8 rxFifoNum;
+    /** Period of the HILOG report, 0 reports on disconnect only */
+    u32 reportMs;
+} uni_ble_diag_cfg_t;
+
+/**
+ * @brief      Enable the counters
+ * @param[in]  cfg  configuration, copied
+ * @return     none
+ */
+void uni_ble_diag_init(const uni_ble_diag_cfg_t *cfg);
+
+/**
+ * @brief      Get the counters of a link
+ * @param[in]  connHandle  connection handle
+ * @param[out] diag        counters
+ * @return     false if there is no such connection
+ */
+bool uni_ble_diag_get(u16 connHandle, uni_ble_diag_t *diag);
+
+/**
+ * @brief      Sample FIFO occupancy and print the periodic report, call from the BLE main loop
+ * @param[in]  none
+ * @return     none
+ */
+void uni_ble_diag_tick(void);
+
+/* Hooks called by uni_ble */
+void uni_ble_diag_on_rx(u16 connHandle, const u8 *p);
+
+void uni_ble_diag_on_tx(u16 connHandle, int len, ble_sts_t status);
+
+void uni_ble_diag_on_connect(const uni_ble_conn_info_t *conn);
+
+void uni_ble_diag_on_disconnect(const uni_ble_conn_info_t *conn);
+
+#endif // UNI_BLE_DIAG_H
@@ -0,0 +1,264 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <los_compiler.h>
+
+#include <tl_common.h>
+#include <drivers.h>
+#include <stack/ble/ble.h>
+
+#include "uni_ble.h"
+#include "uni_ble_notify.h"
+
+#define NOTIFY_ATT_HEADER_LEN   3
+/* Largest notification payload: 251 octets LL payload - 4 octets L2CAP header - 3 octets ATT header */
+#define NOTIFY_MAX_PAYLOAD_LEN  244
+/* Each queued write is stored as attHandle (2 bytes) + len (2 bytes) + data */
+#define NOTIFY_RECORD_HDR_LEN   4
+/* With batching a notification shorter than the MTU is held back while this many packets are still in the TX FIFO */
+#define NOTIFY_HOLD_FIFO_NUM    2
+
+#define NOTIFY_QUEUE_SIZE       TELINK_BLE_NOTIFY_QUEUE_SIZE
+#define NOTIFY_QUEUE_MASK       (NOTIFY_QUEUE_SIZE - 1)
+
+_Static_assert((NOTIFY_QUEUE_SIZE & NOTIFY_QUEUE_MASK) == 0, "TELINK_BLE_NOTIFY_QUEUE_SIZE must be a power of two");
+_Static_assert(NOTIFY_QUEUE_SIZE > NOTIFY_RECORD_HDR_LEN && NOTIFY_QUEUE_SIZE <= 0x8000,
+               "TELINK_BLE_NOTIFY_QUEUE_SIZE out of range");
+
+UNI_BLE_RETENTION_DATA static struct {
+    uni_ble_notify_cfg_t cfg;
+    u8 enabled;
+    struct {
+        u16 connHandle;
+        u8 used;
+        u8 congested;
+        /* free running byte indexes, head - tail is the number of queued bytes */
+        u16 head;
+        u16 tail;
+        /* bytes of the oldest record already sent */
+        u16 sent;
+        u8 buff[NOTIFY_QUEUE_SIZE];
+    } link[UNI_BLE_MAX_CONN];
+    u8 txBuff[NOTIFY_MAX_PAYLOAD_LEN];
+} g_uni_ble_notify;
+
+static int notify_index(u16 connHandle)
+{
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_uni_ble_notify.link[i].used && g_uni_ble_notify.link[i].connHandle == connHandle) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void notify_copy_in(int idx, u16 pos, const u8 *data, u16 len)
+{
+    u8 *buff = g_uni_ble_notify.link[idx].buff;
+
+    for (u16 i = 0; i < len; i++) {
+        buff[(u16)(pos + i) & NOTIFY_QUEUE_MASK] = data[i];
+    }
+}
+
+static void notify_copy_out(int idx, u16 pos, u8 *data, u16 len)
+{
+    const u8 *buff = g_uni_ble_notify.link[idx].buff;
+
+    for (u16 i = 0; i < len; i++) {
+        data[i] = buff[(u16)(pos + i) & NOTIFY_QUEUE_MASK];
+    }
+}
+
+void uni_ble_notify_init(const uni_ble_notify_cfg_t *cfg)
+{
+    g_uni_ble_notify.cfg = *cfg;
+    g_uni_ble_notify.enabled = 1;
+}
+
+void uni_ble_notify_set_batching(bool batching)
+{
+    g_uni_ble_notify.cfg.batching = batching;
+}
+
+bool uni_ble_notify_queue(u16 connHandle, u16 attHandle, const u8 *data, u16 len)
+{
+    int idx = notify_index(connHandle);
+
+    if (idx < 0 || len == 0) {
+        return false;
+    }
+
+    u16 queued = g_uni_ble_notify.link[idx].head - g_uni_ble_notify.link[idx].tail;
+    if (NOTIFY_RECORD_HDR_LEN + len > NOTIFY_QUEUE_SIZE - queued) {
+        g_uni_ble_notify.link[idx].congested = 1;
+        if (g_uni_ble_notify.cfg.backpressure != NULL) {
+            g_uni_ble_notify.cfg.backpressure(connHandle, true);
+        }
+        return false;
+    }
+
+    u8 hdr[NOTIFY_RECORD_HDR_LEN] = {U16_LO(attHandle), U16_HI(attHandle), U16_LO(len), U16_HI(len)};
+    u16 head = g_uni_ble_notify.link[idx].head;
+
+    notify_copy_in(idx, head, hdr, sizeof(hdr));
+    notify_copy_in(idx, head + NOTIFY_RECORD_HDR_LEN, data, len);
+    g_uni_ble_notify.link[idx].head = head + NOTIFY_RECORD_HDR_LEN + len;
+
+    return true;
+}
+
+u16 uni_ble_notify_pending(u16 connHandle)
+{
+    int idx = notify_index(connHandle);
+
+    if (idx < 0) {
+        return 0;
+    }
+
+    return g_uni_ble_notify.link[idx].head - g_uni_ble_notify.link[idx].tail;
+}
+
+/**
+ * @brief      Pack the oldest queued data into txBuff without consuming it
+ * @param[out] attHandle  attribute the notification is for
+ * @param[out] tail       queue tail after the packet is sent
+ * @param[out] sent       bytes of the oldest record already sent after the packet is sent
+ * @return     payload length
+ */
+static u16 notify_pack(int idx, u16 maxLen, u16 *attHandle, u16 *tail, u16 *sent)
+{
+    u16 pos = g_uni_ble_notify.link[idx].tail;
+    u16 done = g_uni_ble_notify.link[idx].sent;
+    u16 len = 0;
+
+    while (pos != g_uni_ble_notify.link[idx].head && len < maxLen) {
+        u8 hdr[NOTIFY_RECORD_HDR_LEN];
+        notify_copy_out(idx, pos, hdr, sizeof(hdr));
+
+        u16 handle = MAKE_U16(hdr[1], hdr[0]);
+        u16 recordLen = MAKE_U16(hdr[3], hdr[2]);
+        if (len == 0) {
+            *attHandle = handle;
+        } else if (handle != *attHandle) {
+            break;
+        }
+
+        u16 n = min(recordLen - done, maxLen - len);
+        notify_copy_out(idx, pos + NOTIFY_RECORD_HDR_LEN + done, g_uni_ble_notify.txBuff + len, n);
+        len += n;
+        done += n;
+        if (done == recordLen) {
+            pos += NOTIFY_RECORD_HDR_LEN + recordLen;
+            done = 0;
+        }
+
+        /* without batching every write goes out on its own, only split when it exceeds the MTU */
+        if (!g_uni_ble_notify.cfg.batching) {
+            break;
+        }
+    }
+
+    *tail = pos;
+    *sent = done;
+
+    return len;
+}
+
+static void notify_flush(int idx)
+{
+    u16 connHandle = g_uni_ble_notify.link[idx].connHandle;
+    u16 maxLen = min(uni_ble_att_getEffectiveMtuSize(connHandle) - NOTIFY_ATT_HEADER_LEN, NOTIFY_MAX_PAYLOAD_LEN);
+
+    while (g_uni_ble_notify.link[idx].head != g_uni_ble_notify.link[idx].tail) {
+        u16 attHandle = 0;
+        u16 tail;
+        u16 sent;
+        u16 len = notify_pack(idx, maxLen, &attHandle, &tail, &sent);
+
+        /* Nagle style: a short packet waits while the link still has data to send this connection event */
+        if (g_uni_ble_notify.cfg.batching && len < maxLen &&
+            uni_ble_ll_getTxFifoNumber(connHandle) >= NOTIFY_HOLD_FIFO_NUM) {
+            break;
+        }
+
+        /* the stack refuses the packet once the TX FIFO is full, retry next loop */
+        if (uni_ble_att_pushNotifyData(connHandle, attHandle, g_uni_ble_notify.txBuff, len) != BLE_SUCCESS) {
+            break;
+        }
+
+        g_uni_ble_notify.link[idx].tail = tail;
+        g_uni_ble_notify.link[idx].sent = sent;
+        if (g_uni_ble_notify.cfg.sent != NULL) {
+            g_uni_ble_notify.cfg.sent(connHandle, attHandle, len);
+        }
+    }
+
+    u16 queued = g_uni_ble_notify.link[idx].head - g_uni_ble_notify.link[idx].tail;
+    if (g_uni_ble_notify.link[idx].congested && queued <= NOTIFY_QUEUE_SIZE / 2) {
+        g_uni_ble_notify.link[idx].congested = 0;
+        if (g_uni_ble_notify.cfg.backpressure != NULL) {
+            g_uni_ble_notify.cfg.backpressure(connHandle, false);
+        }
+    }
+}
+
+void uni_ble_notify_tick(void)
+{
+    if (!g_uni_ble_notify.enabled) {
+        return;
+    }
+
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_uni_ble_notify.link[i].used) {
+            notify_flush(i);
+        }
+    }
+}
+
+void uni_ble_notify_on_connect(const uni_ble_conn_info_t *conn)
+{
+    int idx = notify_index(conn->connHandle);
+
+    for (int i = 0; idx < 0 && i < UNI_BLE_MAX_CONN; i++) {
+        if (!g_uni_ble_notify.link[i].used) {
+            idx = i;
+        }
+    }
+
+    if (idx < 0) {
+        return;
+    }
+
+    g_uni_ble_notify.link[idx].used = 1;
+    g_uni_ble_notify.link[idx].connHandle = conn->connHandle;
+    g_uni_ble_notify.link[idx].congested = 0;
+    g_uni_ble_notify.link[idx].head = 0;
+    g_uni_ble_notify.link[idx].tail = 0;
+    g_uni_ble_notify.link[idx].sent = 0;
+}
+
+void uni_ble_notify_on_disconnect(const uni_ble_conn_info_t *conn)
+{
+    int idx = notify_index(conn->connHandle);
+
+    if (idx >= 0) {
+        g_uni_ble_notify.link[idx].used = 0;
+    }
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef UNI_BLE_NOTIFY_H
+#define UNI_BLE_NOTIFY_H
+
+#include "uni_ble.h"
+
+/**
+ * @brief      Backpressure callback
+ * @param[in]  connHandle  connection handle
+ * @param[in]  congested   true when uni_ble_notify_queue() refused data because the queue of the link is full,
+ *                         false once that queue has drained below half of its size
+ * @return     none
+ */
+typedef void (*uni_ble_notify_backpressure_cb_t)(u16 connHandle, bool congested);
+
+/**
+ * @brief      Called for every notification handed to the TX FIFO
+ */
+typedef void (*uni_ble_notify_sent_cb_t)(u16 connHandle, u16 attHandle, u16 len);
+
+typedef struct {
+    /** Coalesce consecutive writes to the same attribute into MTU sized notifications */
+    bool batching;
+    uni_ble_notify_backpressure_cb_t backpressure;
+    uni_ble_notify_sent_cb_t sent;
+} uni_ble_notify_cfg_t;
+
+/**
+ * @brief      Enable the per-connection notification queue
+ * @param[in]  cfg  configuration, copied
+ * @return     none
+ */
+void uni_ble_notify_init(const uni_ble_notify_cfg_t *cfg);
+
+void uni_ble_notify_set_batching(bool batching);
+
+/**
+ * @brief      Queue notification data for a link. With batching the data of consecutive calls for the same
+ *             attribute is treated as a byte stream, so write boundaries are not preserved on the air.
+ * @param[in]  connHandle  connection handle
+ * @param[in]  attHandle   attribute handle of the characteristic value
+ * @param[in]  data        data, copied
+ * @param[in]  len         data length
+ * @return     true if queued, false if the queue is full (the backpressure callback is invoked)
+ */
+bool uni_ble_notify_queue(u16 connHandle, u16 attHandle, const u8 *data, u16 len);
+
+/**
+ * @brief      Number of bytes, including record headers, waiting in the queue of a link
+ */
+u16 uni_ble_notify_pending(u16 connHandle);
+
+/**
+ * @brief      Move queued data into free TX FIFO entries, call from the BLE main loop
+ * @param[in]  none
+ * @return     none
+ */
+void uni_ble_notify_tick(void);
+
+/* Hooks called by uni_ble_process_events() */
+void uni_ble_notify_on_connect(const uni_ble_conn_info_t *conn);
+
+void uni_ble_notify_on_disconnect(const uni_ble_conn_info_t *conn);
+
+#endif // UNI_BLE_NOTIFY_H
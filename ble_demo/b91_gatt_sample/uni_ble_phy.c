@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <los_compiler.h>
+#include <hiview_log.h>
+
+#include <tl_common.h>
+#include <drivers.h>
+#include <stack/ble/ble.h>
+
+#include "ble_log.h"
+#include "uni_ble.h"
+#include "uni_ble_phy.h"
+
+#define US_PER_MS       1000
+/* Weight of the history in the RSSI moving average, avg = (avg * (N - 1) + sample) / N */
+#define RSSI_AVG_WEIGHT 4
+
+UNI_BLE_RETENTION_DATA static struct {
+    uni_ble_phy_policy_t policy;
+    u8 enabled;
+    struct {
+        u16 connHandle;
+        u8 used;
+        u8 throughput;
+        u8 requested;
+        s16 rssiAvg;
+        u32 sampleTick;
+        u32 requestTick;
+    } link[UNI_BLE_MAX_CONN];
+} g_uni_ble_phy_policy;
+
+static int phy_policy_index(u16 connHandle)
+{
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (g_uni_ble_phy_policy.link[i].used && g_uni_ble_phy_policy.link[i].connHandle == connHandle) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief      Choose the PHY for a link from its averaged RSSI, current PHY and throughput demand
+ * @return     BLE_PHY_1M, BLE_PHY_2M or BLE_PHY_CODED
+ */
+static u8 phy_policy_select(int idx, u8 currentPhy)
+{
+    const uni_ble_phy_policy_t *policy = &g_uni_ble_phy_policy.policy;
+    s16 rssi = g_uni_ble_phy_policy.link[idx].rssiAvg;
+
+    if (currentPhy == BLE_PHY_CODED ? (rssi <= policy->codedExitAboveDbm) : (rssi < policy->codedBelowDbm)) {
+        return BLE_PHY_CODED;
+    }
+
+    if (g_uni_ble_phy_policy.link[idx].throughput && rssi > policy->fastAboveDbm) {
+        return BLE_PHY_2M;
+    }
+
+    return BLE_PHY_1M;
+}
+
+static void phy_policy_request(int idx, u8 phy)
+{
+    static const u8 phyPrefer[] = {
+        [BLE_PHY_1M] = PHY_PREFER_1M,
+        [BLE_PHY_2M] = PHY_PREFER_2M,
+        [BLE_PHY_CODED] = PHY_PREFER_CODED,
+    };
+
+    ble_sts_t status = uni_ble_ll_setPhy(g_uni_ble_phy_policy.link[idx].connHandle, phyPrefer[phy],
+                                         CODED_PHY_PREFER_S8);
+    if (status != BLE_SUCCESS) {
+        HILOG_ERROR(HILOG_MODULE_APP, "uni_ble_ll_setPhy(): %d", status);
+        return;
+    }
+
+    g_uni_ble_phy_policy.link[idx].requested = phy;
+    g_uni_ble_phy_policy.link[idx].requestTick = clock_time();
+}
+
+void uni_ble_phy_policy_init(const uni_ble_phy_policy_t *policy)
+{
+    g_uni_ble_phy_policy.policy = *policy;
+    g_uni_ble_phy_policy.enabled = 1;
+}
+
+void uni_ble_phy_policy_set_throughput(u16 connHandle, bool needed)
+{
+    int idx = phy_policy_index(connHandle);
+
+    if (idx >= 0) {
+        g_uni_ble_phy_policy.link[idx].throughput = needed;
+    }
+}
+
+void uni_ble_phy_policy_tick(void)
+{
+    if (!g_uni_ble_phy_policy.enabled) {
+        return;
+    }
+
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        if (!g_uni_ble_phy_policy.link[i].used ||
+            !clock_time_exceed(g_uni_ble_phy_policy.link[i].sampleTick,
+                               g_uni_ble_phy_policy.policy.sampleMs * US_PER_MS)) {
+            continue;
+        }
+
+        const uni_ble_conn_info_t *conn = uni_ble_get_conn(g_uni_ble_phy_policy.link[i].connHandle);
+        if (conn == NULL) {
+            continue;
+        }
+
+        g_uni_ble_phy_policy.link[i].sampleTick = clock_time();
+        s8 rssi = uni_ble_ll_getRssi(conn->connHandle);
+        g_uni_ble_phy_policy.link[i].rssiAvg =
+            (g_uni_ble_phy_policy.link[i].rssiAvg * (RSSI_AVG_WEIGHT - 1) + rssi) / RSSI_AVG_WEIGHT;
+
+        u8 phy = phy_policy_select(i, conn->txPhy);
+        if (phy == conn->txPhy) {
+            g_uni_ble_phy_policy.link[i].requested = phy;
+            continue;
+        }
+
+        /* The peer may refuse a PHY, so a request is repeated only after retryMs */
+        if (g_uni_ble_phy_policy.link[i].requested != phy ||
+            clock_time_exceed(g_uni_ble_phy_policy.link[i].requestTick,
+                              g_uni_ble_phy_policy.policy.retryMs * US_PER_MS)) {
+            phy_policy_request(i, phy);
+        }
+    }
+}
+
+void uni_ble_phy_policy_on_connect(const uni_ble_conn_info_t *conn)
+{
+    int idx = phy_policy_index(conn->connHandle);
+
+    for (int i = 0; idx < 0 && i < UNI_BLE_MAX_CONN; i++) {
+        if (!g_uni_ble_phy_policy.link[i].used) {
+            idx = i;
+        }
+    }
+
+    if (idx < 0) {
+        return;
+    }
+
+    g_uni_ble_phy_policy.link[idx].used = 1;
+    g_uni_ble_phy_policy.link[idx].connHandle = conn->connHandle;
+    g_uni_ble_phy_policy.link[idx].throughput = 0;
+    g_uni_ble_phy_policy.link[idx].requested = conn->txPhy;
+    /* Start from the Coded PHY exit threshold, neither switching up nor down before samples arrive */
+    g_uni_ble_phy_policy.link[idx].rssiAvg = g_uni_ble_phy_policy.policy.codedExitAboveDbm;
+    g_uni_ble_phy_policy.link[idx].sampleTick = clock_time();
+}
+
+void uni_ble_phy_policy_on_update(const uni_ble_conn_info_t *conn)
+{
+    BLE_LOG(BLE_LOG_CONN_PHY, conn->connHandle, conn->txPhy, conn->rxPhy);
+}
+
+void uni_ble_phy_policy_on_disconnect(const uni_ble_conn_info_t *conn)
+{
+    int idx = phy_policy_index(conn->connHandle);
+
+    if (idx >= 0) {
+        g_uni_ble_phy_policy.link[idx].used = 0;
+    }
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef UNI_BLE_PHY_H
+#define UNI_BLE_PHY_H
+
+#include "uni_ble.h"
+
+/**
+ *  @brief  PHY selection policy: 2M PHY while the application needs throughput,
+ *          Coded PHY when the averaged RSSI shows a degrading link, 1M PHY otherwise
+ */
+typedef struct {
+    /** Move to Coded PHY when the averaged RSSI falls below this value (dBm) */
+    s8 codedBelowDbm;
+    /** Leave Coded PHY only when the averaged RSSI rises above this value (dBm) */
+    s8 codedExitAboveDbm;
+    /** 2M PHY is requested only when the averaged RSSI is above this value (dBm) */
+    s8 fastAboveDbm;
+    /** RSSI sampling period */
+    u32 sampleMs;
+    /** Delay before repeating a PHY request the peer did not apply */
+    u32 retryMs;
+} uni_ble_phy_policy_t;
+
+/**
+ * @brief      Enable the policy, uni_ble_ll_init2MPhyCodedPhy_feature() must have been called
+ * @param[in]  policy  parameters, copied
+ * @return     none
+ */
+void uni_ble_phy_policy_init(const uni_ble_phy_policy_t *policy);
+
+/**
+ * @brief      Tell the policy whether a link currently needs high throughput
+ * @param[in]  connHandle  connection handle
+ * @param[in]  needed      true while bulk transfer is running
+ * @return     none
+ */
+void uni_ble_phy_policy_set_throughput(u16 connHandle, bool needed);
+
+/**
+ * @brief      Sample RSSI and issue PHY requests where needed, call from the BLE main loop
+ * @param[in]  none
+ * @return     none
+ */
+void uni_ble_phy_policy_tick(void);
+
+/* Hooks called by uni_ble_process_events() */
+void uni_ble_phy_policy_on_connect(const uni_ble_conn_info_t *conn);
+
+void uni_ble_phy_policy_on_update(const uni_ble_conn_info_t *conn);
+
+void uni_ble_phy_policy_on_disconnect(const uni_ble_conn_info_t *conn);
+
+#endif // UNI_BLE_PHY_H
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+
+#include <hiview_log.h>
+
+#include <tl_common.h>
+
+#include "uni_ble.h"
+#include "uni_ble_prof.h"
+
+/* Histogram buckets printed per log line, each as a space and up to 10 digits */
+#define PROF_HIST_PER_LINE  4
+#define PROF_HIST_FIELD_LEN 11
+
+_Static_assert(CYCLE_PROF_HIST_BUCKETS % PROF_HIST_PER_LINE == 0, "histogram is dumped in whole lines");
+
+UNI_BLE_RETENTION_DATA CycleProfPoint g_uni_ble_prof[UNI_BLE_PROF_NUM] = {
+    [UNI_BLE_PROF_SDK_MAIN_LOOP] = {.name = "sdk_main_loop"},
+    [UNI_BLE_PROF_SDK_IRQ] = {.name = "sdk_irq"},
+    [UNI_BLE_PROF_APP_CB] = {.name = "app_cb"},
+    [UNI_BLE_PROF_ATT_CB] = {.name = "att_cb"},
+    [UNI_BLE_PROF_APP_LOOP] = {.name = "app_loop"},
+};
+
+void uni_ble_prof_dump(void)
+{
+    for (int i = 0; i < UNI_BLE_PROF_NUM; i++) {
+        const CycleProfPoint *point = &g_uni_ble_prof[i];
+
+        HILOG_INFO(HILOG_MODULE_APP, "prof %s: n %u, min %u, avg %u, max %u cycles", point->name, point->count,
+                   point->min, CycleProfAvg(point), point->max);
+
+        /* bucket b counts [2^b, 2^(b+1)) cycles, lines without samples are skipped */
+        for (int b = 0; b < CYCLE_PROF_HIST_BUCKETS; b += PROF_HIST_PER_LINE) {
+            char line[PROF_HIST_PER_LINE * PROF_HIST_FIELD_LEN + 1];
+            int len = 0;
+            u32 samples = 0;
+
+            for (int j = 0; j < PROF_HIST_PER_LINE; j++) {
+                samples |= point->hist[b + j];
+                len += snprintf(line + len, sizeof(line) - len, " %u", (unsigned)point->hist[b + j]);
+            }
+            if (samples == 0) {
+                continue;
+            }
+            HILOG_INFO(HILOG_MODULE_APP, "prof %s 2^%d:%s", point->name, b, line);
+        }
+    }
+}
+
+void uni_ble_prof_reset(void)
+{
+    for (int i = 0; i < UNI_BLE_PROF_NUM; i++) {
+        CycleProfReset(&g_uni_ble_prof[i]);
+    }
+}
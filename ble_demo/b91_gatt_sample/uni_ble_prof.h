@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef UNI_BLE_PROF_H
+#define UNI_BLE_PROF_H
+
+#include <cycle_prof.h>
+
+/**
+ *  @brief  Measurement points of the BLE task, enabled with telink_ble_profiler_enable
+ */
+typedef enum {
+    /** uni_ble_sdk_main_loop(), includes interrupts taken meanwhile */
+    UNI_BLE_PROF_SDK_MAIN_LOOP,
+    /** uni_ble_sdk_irq_handler() */
+    UNI_BLE_PROF_SDK_IRQ,
+    /** Application connect/disconnect/update callbacks */
+    UNI_BLE_PROF_APP_CB,
+    /** Attribute read/write handlers */
+    UNI_BLE_PROF_ATT_CB,
+    /** Application work of MainLoop() after the SDK main loop */
+    UNI_BLE_PROF_APP_LOOP,
+    UNI_BLE_PROF_NUM,
+} uni_ble_prof_id_t;
+
+#define UNI_BLE_PROF_BEGIN(id)  CYCLE_PROF_BEGIN(id)
+#define UNI_BLE_PROF_END(id)    CYCLE_PROF_END(id, &g_uni_ble_prof[id])
+
+#if CYCLE_PROF_ENABLE
+extern CycleProfPoint g_uni_ble_prof[UNI_BLE_PROF_NUM];
+
+/**
+ * @brief      Print min/avg/max and the log2 histogram of every point through HILOG
+ * @param[in]  none
+ * @return     none
+ */
+void uni_ble_prof_dump(void);
+
+void uni_ble_prof_reset(void);
+#endif /* CYCLE_PROF_ENABLE */
+
+#endif // UNI_BLE_PROF_H
@@ -18,109 +18,150 @@
 
 #include "hal_sys_param.h"
 
-static const char OHOS_DEVICE_TYPE[] = {"Evaluation Board"};
-static const char OHOS_DISPLAY_VERSION[] = {"OpenHarmony 3.x"};
-static const char OHOS_MANUFACTURE[] = {"Telink"};
-static const char OHOS_BRAND[] = {"Telink"};
-static const char OHOS_MARKET_NAME[] = {"B91 Generic Starter Kit"};
-static const char OHOS_PRODUCT_SERIES[] = {"TLSR9"};
-static const char OHOS_PRODUCT_MODEL[] = {"v1.0.0"};
-static const char OHOS_SOFTWARE_MODEL[] = {"v1.0.0"};
-static const char OHOS_HARDWARE_MODEL[] = {"v1.3"};
-static const char OHOS_HARDWARE_PROFILE[] = {"BLE:true"};
-static const char OHOS_BOOTLOADER_VERSION[] = {"bootloader"};
-static const char OHOS_ABI_LIST[] = {"default"};
-static const char OHOS_SERIAL[] = {"1234567890"};
+#include "sys_param_blob.h"
+
 static const int OHOS_FIRST_API_VERSION = 1;
 
+#define SYS_PARAM_INIT(name, str) \
+    .rec_##name = {SYS_PARAM_##name, sizeof(str) - 1, str, 0},
+
+const SysParamBlob g_sysParamBlob = {
+    .version = SYS_PARAM_BLOB_VERSION,
+    .count = SYS_PARAM_ID_MAX,
+    .size = sizeof(SysParamBlob),
+    SYS_PARAM_TABLE(SYS_PARAM_INIT)
+};
+
+#define SYS_PARAM_CHECK_LEN(name, str) \
+    _Static_assert(sizeof(str) - 1 <= 0xFF, #name " too long for an 8-bit record length");
+
+SYS_PARAM_TABLE(SYS_PARAM_CHECK_LEN)
+
+/* Record offsets inside the blob, indexed by parameter ID */
+#define SYS_PARAM_OFFSET(name, str)     [SYS_PARAM_##name] = offsetof(SysParamBlob, rec_##name),
+
+static const uint16_t g_sysParamOffset[SYS_PARAM_ID_MAX] = {
+    SYS_PARAM_TABLE(SYS_PARAM_OFFSET)
+};
+
+/* Common head of all records */
+typedef struct __attribute__((packed)) {
+    uint8_t id;
+    uint8_t len;
+    char value[];
+} SysParamRecord;
+
+static const SysParamRecord *SysParamFind(SysParamId id)
+{
+    if ((unsigned)id >= SYS_PARAM_ID_MAX) {
+        return NULL;
+    }
+
+    return (const SysParamRecord *)((const uint8_t *)&g_sysParamBlob + g_sysParamOffset[id]);
+}
+
+const char *SysParamGet(SysParamId id)
+{
+    const SysParamRecord *rec = SysParamFind(id);
+
+    return (rec != NULL) ? rec->value : NULL;
+}
+
+size_t SysParamGetLen(SysParamId id)
+{
+    const SysParamRecord *rec = SysParamFind(id);
+
+    return (rec != NULL) ? rec->len : 0;
+}
+
 const char *HalGetDeviceType(void)
 {
-    return OHOS_DEVICE_TYPE;
+    return SysParamGet(SYS_PARAM_DEVICE_TYPE);
 }
 
 const char *HalGetManufacture(void)
 {
-    return OHOS_MANUFACTURE;
+    return SysParamGet(SYS_PARAM_MANUFACTURE);
 }
 
 const char *HalGetBrand(void)
 {
-    return OHOS_BRAND;
+    return SysParamGet(SYS_PARAM_BRAND);
 }
 
 const char *HalGetMarketName(void)
 {
-    return OHOS_MARKET_NAME;
+    return SysParamGet(SYS_PARAM_MARKET_NAME);
 }
 
 const char *HalGetProductSeries(void)
 {
-    return OHOS_PRODUCT_SERIES;
+    return SysParamGet(SYS_PARAM_PRODUCT_SERIES);
 }
 
 const char *HalGetProductModel(void)
 {
-    return OHOS_PRODUCT_MODEL;
+    return SysParamGet(SYS_PARAM_PRODUCT_MODEL);
 }
 
 const char *HalGetSoftwareModel(void)
 {
-    return OHOS_SOFTWARE_MODEL;
+    return SysParamGet(SYS_PARAM_SOFTWARE_MODEL);
 }
 
 const char *HalGetHardwareModel(void)
 {
-    return OHOS_HARDWARE_MODEL;
+    return SysParamGet(SYS_PARAM_HARDWARE_MODEL);
 }
 
 const char *HalGetHardwareProfile(void)
 {
-    return OHOS_HARDWARE_PROFILE;
+    return SysParamGet(SYS_PARAM_HARDWARE_PROFILE);
 }
 
 const char *HalGetSerial(void)
 {
-    return OHOS_SERIAL;
+    return SysParamGet(SYS_PARAM_SERIAL);
 }
 
 const char *HalGetBootloaderVersion(void)
 {
-    return OHOS_BOOTLOADER_VERSION;
+    return SysParamGet(SYS_PARAM_BOOTLOADER_VERSION);
 }
 
 const char *HalGetAbiList(void)
 {
-    return OHOS_ABI_LIST;
+    return SysParamGet(SYS_PARAM_ABI_LIST);
 }
 
 const char *HalGetDisplayVersion(void)
 {
-    return OHOS_DISPLAY_VERSION;
+    return SysParamGet(SYS_PARAM_DISPLAY_VERSION);
 }
 
 const char *HalGetIncrementalVersion(void)
 {
-    return INCREMENTAL_VERSION;
+    return SysParamGet(SYS_PARAM_INCREMENTAL_VERSION);
 }
 
 const char *HalGetBuildType(void)
 {
-    return BUILD_TYPE;
+    return SysParamGet(SYS_PARAM_BUILD_TYPE);
 }
 
 const char *HalGetBuildUser(void)
 {
-    return BUILD_USER;
+    return SysParamGet(SYS_PARAM_BUILD_USER);
 }
 
 const char *HalGetBuildHost(void)
 {
-    return BUILD_HOST;
+    return SysParamGet(SYS_PARAM_BUILD_HOST);
 }
 
 const char *HalGetBuildTime(void)
 {
-    return BUILD_TIME;
+    return SysParamGet(SYS_PARAM_BUILD_TIME);
 }
 
 int HalGetFirstApiVersion(void)
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_BLE_DEMO_SYS_PARAM_BLOB_H
+#define VENDOR_BLE_DEMO_SYS_PARAM_BLOB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * System parameter table.
+ *
+ * Every string parameter is listed exactly once below. The list expands into the parameter
+ * IDs and into one packed blob in flash, which backs the HalGet*() getters, the Device
+ * Information Service characteristics and the parameter blob characteristic without copies.
+ *
+ * Blob layout (little endian):
+ *
+ *   u8 version, u8 count, u16 size           header, size covers the whole blob
+ *   u8 id, u8 len, char value[len], u8 0     one record per parameter, in list order
+ *
+ * len excludes the terminating zero that follows every value, so the values are C strings
+ * and GATT string characteristics at the same time.
+ */
+#define SYS_PARAM_TABLE(X) \
+    X(DEVICE_TYPE, "Evaluation Board") \
+    X(DISPLAY_VERSION, "OpenHarmony 3.x") \
+    X(MANUFACTURE, "Telink") \
+    X(BRAND, "Telink") \
+    X(MARKET_NAME, "B91 Generic Starter Kit") \
+    X(PRODUCT_SERIES, "TLSR9") \
+    X(PRODUCT_MODEL, "v1.0.0") \
+    X(SOFTWARE_MODEL, "v1.0.0") \
+    X(HARDWARE_MODEL, "v1.3") \
+    X(HARDWARE_PROFILE, "BLE:true") \
+    X(BOOTLOADER_VERSION, "bootloader") \
+    X(ABI_LIST, "default") \
+    X(SERIAL, "1234567890") \
+    X(INCREMENTAL_VERSION, INCREMENTAL_VERSION) \
+    X(BUILD_TYPE, BUILD_TYPE) \
+    X(BUILD_USER, BUILD_USER) \
+    X(BUILD_HOST, BUILD_HOST) \
+    X(BUILD_TIME, BUILD_TIME)
+
+#define SYS_PARAM_BLOB_VERSION  1
+
+/* Names are only ever pasted, so BUILD_TYPE and friends are not expanded as macros */
+#define SYS_PARAM_ENUM(name, str)       SYS_PARAM_##name,
+
+typedef enum {
+    SYS_PARAM_TABLE(SYS_PARAM_ENUM)
+    SYS_PARAM_ID_MAX,
+} SysParamId;
+
+#define SYS_PARAM_RECORD(name, str) \
+    struct __attribute__((packed)) { \
+        uint8_t id; \
+        uint8_t len; \
+        char value[sizeof(str) - 1]; \
+        char end; \
+    } rec_##name;
+
+/**
+ *  @brief  Packed parameter blob, also the value of the parameter blob characteristic
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t version;
+    uint8_t count;
+    uint16_t size;
+    SYS_PARAM_TABLE(SYS_PARAM_RECORD)
+} SysParamBlob;
+
+_Static_assert(SYS_PARAM_ID_MAX <= 0xFF, "too many system parameters for 8-bit IDs");
+_Static_assert(sizeof(SysParamBlob) <= 0xFFFF, "system parameter blob too large");
+
+extern const SysParamBlob g_sysParamBlob;
+
+/* Value of a parameter as a constant, usable in static initializers such as the GATT table */
+#define SYS_PARAM_VALUE(name)   (g_sysParamBlob.rec_##name.value)
+
+/**
+ * @brief      Look up a parameter in constant time
+ * @param[in]  id - parameter ID
+ * @return     zero-terminated value inside the blob, NULL if id is out of range
+ */
+const char *SysParamGet(SysParamId id);
+
+/**
+ * @brief      Length of a parameter
+ * @param[in]  id - parameter ID
+ * @return     value length without the terminating zero, 0 if id is out of range
+ */
+size_t SysParamGetLen(SysParamId id);
+
+#endif /* VENDOR_BLE_DEMO_SYS_PARAM_BLOB_H */
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+# All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Host client for the b91_gatt_sample benchmark service.
+
+Build the firmware with telink_ble_bench_service_enable = true, then run:
+
+    python3 ble_bench_client.py --address <MAC> --seconds 10
+
+Requires the 'bleak' package.
+"""
+
+import argparse
+import asyncio
+import struct
+import time
+
+from bleak import BleakClient
+
+BENCH_TX_UUID = "7e5a0001-8c1f-4f5e-9d2b-b91b3c4d5e6f"
+BENCH_RX_UUID = "7e5a0002-8c1f-4f5e-9d2b-b91b3c4d5e6f"
+BENCH_CTRL_UUID = "7e5a0003-8c1f-4f5e-9d2b-b91b3c4d5e6f"
+
+OP_START_TX = 0x01
+OP_STOP_TX = 0x02
+OP_RESET = 0x03
+OP_PING = 0x04
+OP_START_QUEUED = 0x05
+
+RESULT_FORMAT = "<IIIHHIII"
+RESULT_FIELDS = (
+    "elapsed_ms",
+    "rx_bytes_per_sec",
+    "tx_bytes_per_sec",
+    "rx_packets_per_conn_evt",
+    "tx_packets_per_conn_evt",
+    "rtt_avg_us",
+    "rtt_min_us",
+    "rtt_max_us",
+)
+
+
+class StreamChecker:
+    """Verifies the device counter pattern and counts received bytes."""
+
+    def __init__(self):
+        self.bytes = 0
+        self.packets = 0
+        self.errors = 0
+        self.lost = 0
+        self.next_seq = None
+
+    def on_notify(self, _sender, data):
+        self.packets += 1
+        self.bytes += len(data)
+        if len(data) < 4:
+            self.errors += 1
+            return
+
+        seq = struct.unpack_from("<I", data)[0]
+        if self.next_seq is not None and seq != self.next_seq:
+            self.lost += (seq - self.next_seq) & 0xFFFFFFFF
+        self.next_seq = (seq + 1) & 0xFFFFFFFF
+
+        for i in range(4, len(data)):
+            if data[i] != (seq + i) & 0xFF:
+                self.errors += 1
+                break
+
+
+async def measure_rtt(client, count):
+    pongs = asyncio.Queue()
+
+    async def on_ctrl(_sender, data):
+        if len(data) >= 2 and data[0] == OP_PING:
+            await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_PING, data[1]]), response=False)
+            await pongs.put(data[1])
+
+    await client.start_notify(BENCH_CTRL_UUID, on_ctrl)
+    for _ in range(count):
+        await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_PING]), response=True)
+        await asyncio.wait_for(pongs.get(), timeout=2.0)
+    await client.stop_notify(BENCH_CTRL_UUID)
+
+
+async def measure_queued(client, seconds, write_len, batching):
+    """Stream small writes through the device notify queue, returns host side bytes and device result."""
+    received = [0]
+
+    def on_notify(_sender, data):
+        received[0] += len(data)
+
+    await client.start_notify(BENCH_TX_UUID, on_notify)
+    await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_START_QUEUED, write_len, int(batching)]), response=True)
+    await asyncio.sleep(seconds)
+    await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_STOP_TX]), response=True)
+    result = await read_result(client)
+    await client.stop_notify(BENCH_TX_UUID)
+    return received[0], result
+
+
+async def read_result(client):
+    raw = await client.read_gatt_char(BENCH_CTRL_UUID)
+    values = struct.unpack(RESULT_FORMAT, bytes(raw[:struct.calcsize(RESULT_FORMAT)]))
+    result = dict(zip(RESULT_FIELDS, values))
+    result["rx_packets_per_conn_evt"] /= 100.0
+    result["tx_packets_per_conn_evt"] /= 100.0
+    return result
+
+
+async def run(args):
+    async with BleakClient(args.address) as client:
+        checker = StreamChecker()
+        await client.start_notify(BENCH_TX_UUID, checker.on_notify)
+
+        await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_START_TX, args.payload]), response=True)
+        start = time.monotonic()
+        await asyncio.sleep(args.seconds)
+        await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_STOP_TX]), response=True)
+        elapsed = time.monotonic() - start
+        device_tx = await read_result(client)
+        await client.stop_notify(BENCH_TX_UUID)
+
+        await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_RESET]), response=True)
+        chunk = bytes(args.write_len)
+        deadline = time.monotonic() + args.seconds
+        while time.monotonic() < deadline:
+            await client.write_gatt_char(BENCH_RX_UUID, chunk, response=False)
+        device_rx = await read_result(client)
+
+        await client.write_gatt_char(BENCH_CTRL_UUID, bytes([OP_RESET]), response=True)
+        await measure_rtt(client, args.pings)
+        device_rtt = await read_result(client)
+
+        queued = []
+        if args.queued_write_len:
+            for batching in (False, True):
+                queued.append((batching, await measure_queued(client, args.seconds, args.queued_write_len, batching)))
+
+    print("notify (device -> host)")
+    print("  host   : %.0f B/s, %d packets, %d lost, %d pattern errors"
+          % (checker.bytes / elapsed, checker.packets, checker.lost, checker.errors))
+    print("  device : %d B/s, %.2f packets/conn event"
+          % (device_tx["tx_bytes_per_sec"], device_tx["tx_packets_per_conn_evt"]))
+    print("write without response (host -> device)")
+    print("  device : %d B/s, %.2f packets/conn event"
+          % (device_rx["rx_bytes_per_sec"], device_rx["rx_packets_per_conn_evt"]))
+    print("round trip latency (%d pings)" % args.pings)
+    print("  device : avg %d us, min %d us, max %d us"
+          % (device_rtt["rtt_avg_us"], device_rtt["rtt_min_us"], device_rtt["rtt_max_us"]))
+    for batching, (host_bytes, device_queued) in queued:
+        print("notify queue, %d byte writes, %s" % (args.queued_write_len, "batched" if batching else "unbatched"))
+        print("  host   : %.0f B/s" % (host_bytes / args.seconds))
+        print("  device : %d B/s, %.2f packets/conn event"
+              % (device_queued["tx_bytes_per_sec"], device_queued["tx_packets_per_conn_evt"]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--address", required=True, help="device address")
+    parser.add_argument("--seconds", type=float, default=10.0, help="duration of each phase")
+    parser.add_argument("--payload", type=int, default=0, help="notify payload length, 0 means MTU - 3")
+    parser.add_argument("--write-len", type=int, default=20, help="write without response payload length")
+    parser.add_argument("--pings", type=int, default=20, help="number of round trip measurements")
+    parser.add_argument("--queued-write-len", type=int, default=0,
+                        help="compare batched and unbatched notify queue with writes of this length, "
+                             "needs telink_ble_notify_queue_enable")
+    asyncio.run(run(parser.parse_args()))
+
+
+if __name__ == "__main__":
+    main()
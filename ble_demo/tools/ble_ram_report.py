@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+# All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Print the BLE buffer RAM of a b91_gatt_sample configuration.
+
+Called by the ble_ram_report action of b91_gatt_sample/BUILD.gn with the values of
+the GN args and the link count the buffers are allocated for (1 with the single
+connection SDK), so every build logs how many bytes the ACL FIFOs and L2CAP MTU
+buffers take. It can also be run by hand to compare configurations, --max-conn adds
+the totals of other link counts:
+
+    python3 ble_ram_report.py --octets 251 --mtu 247 --tx-fifo-num 9 --rx-fifo-num 4 --conn 2 --max-conn 4
+
+The sizes mirror CAL_LL_ACL_RX_FIFO_SIZE, CAL_LL_ACL_TX_FIFO_SIZE and CAL_MTU_BUFF_SIZE
+of the B91 BLE SDK, app_buffer.h checks the same constraints at compile time and the
+firmware logs the exact totals at boot. Only the standard library is used.
+"""
+
+import argparse
+import sys
+
+
+def align(value, step):
+    return (value + step - 1) // step * step
+
+
+def rx_fifo_size(octets):
+    return align(octets + 22, 16)
+
+
+def tx_fifo_size(octets):
+    return align(octets + 10, 16)
+
+
+def mtu_buff_size(mtu):
+    return align(mtu + 6, 4)
+
+
+def is_pow2(value):
+    return value > 0 and value & (value - 1) == 0
+
+
+def check(args):
+    errors = []
+    if not 27 <= args.octets <= 251:
+        errors.append("DLE octets %d not in 27..251" % args.octets)
+    if not 23 <= args.mtu <= 247:
+        errors.append("ATT MTU %d not in 23..247" % args.mtu)
+    if args.rx_fifo_num < 2 or not is_pow2(args.rx_fifo_num):
+        errors.append("RX FIFO number %d is not a power of two" % args.rx_fifo_num)
+    if args.tx_fifo_num < 3 or not is_pow2(args.tx_fifo_num - 1):
+        errors.append("TX FIFO number %d is not a power of two plus one" % args.tx_fifo_num)
+    if args.conn < 1:
+        errors.append("link count %d is not 1 or more" % args.conn)
+    return errors
+
+
+def report(args):
+    rx_size = rx_fifo_size(args.octets)
+    tx_size = tx_fifo_size(args.octets)
+    mtu_size = mtu_buff_size(args.mtu)
+    rx_ram = rx_size * args.rx_fifo_num
+    link_ram = tx_size * args.tx_fifo_num + 2 * mtu_size
+
+    lines = [
+        "BLE RAM: %d B for %d link(s), DLE %d octets, ATT MTU %d"
+        % (rx_ram + args.conn * link_ram, args.conn, args.octets, args.mtu),
+        "  rx fifo  %4d B x %2d shared   = %6d B" % (rx_size, args.rx_fifo_num, rx_ram),
+        "  tx fifo  %4d B x %2d per link = %6d B" % (tx_size, args.tx_fifo_num, tx_size * args.tx_fifo_num),
+        "  mtu rx+tx %3d B x  2 per link = %6d B" % (mtu_size, 2 * mtu_size),
+    ]
+    if args.max_conn:
+        lines.append("  other link counts:")
+        for links in range(1, args.max_conn + 1):
+            if links != args.conn:
+                lines.append("  %5d %6d B" % (links, rx_ram + links * link_ram))
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--octets", type=int, default=27, help="DLE max RX/TX octets")
+    parser.add_argument("--mtu", type=int, default=23, help="ATT MTU of the slave")
+    parser.add_argument("--tx-fifo-num", type=int, default=17, help="ACL TX FIFO entries per link")
+    parser.add_argument("--rx-fifo-num", type=int, default=8, help="ACL RX FIFO entries")
+    parser.add_argument("--conn", type=int, default=1, help="links the buffers are allocated for")
+    parser.add_argument("--max-conn", type=int, default=0, help="also list the totals for 1..this many links")
+    parser.add_argument("-o", "--output", help="also write the report to this file")
+    args = parser.parse_args()
+
+    errors = check(args)
+    if errors:
+        for error in errors:
+            sys.stderr.write("ble_ram_report: %s\n" % error)
+        sys.exit(1)
+
+    text = "\n".join(report(args)) + "\n"
+    sys.stdout.write(text)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+# All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Decode a b91_gatt_sample trace dump into a Chrome trace / Perfetto JSON timeline.
+
+Build the firmware with telink_ble_trace_enable = true, capture the UART log while
+writing 0x03 to the diagnostics control characteristic, then run:
+
+    python3 trace_decode.py uart.log -o trace.json
+
+Open trace.json in chrome://tracing or https://ui.perfetto.dev. IRQ-to-task latency
+statistics are printed on stderr. Only the standard library is used.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+DEFAULT_IDS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "b91_gatt_sample", "ble_trace.h")
+
+ENUM_ENTRY = re.compile(r"^\s*(BLE_TRACE_\w+)\s*(?:=\s*(\w+))?\s*,", re.MULTILINE)
+BEGIN_LINE = re.compile(r"TRACE BEGIN (\d+) (\d+) (\d+)")
+RECORD_LINE = re.compile(r"TRACE ([0-9a-fA-F]{8}) ([0-9a-fA-F]{4}) ([0-9a-fA-F]{4})")
+
+TIMESTAMP_WRAP = 1 << 32
+PID = 1
+TID_IRQ = 1
+TID_TASK = 2
+TID_LATENCY = 3
+
+
+def load_ids(path):
+    """Map event ID to name from the BleTraceId enum."""
+    with open(path) as f:
+        text = f.read()
+    ids = {}
+    value = -1
+    for name, explicit in ENUM_ENTRY.findall(text):
+        value = int(explicit, 0) if explicit else value + 1
+        ids[value] = name[len("BLE_TRACE_"):]
+    return ids
+
+
+def parse_dumps(lines):
+    """Yield (ticks_per_us, overwritten, records) for every complete dump in the log."""
+    current = None
+    for line in lines:
+        begin = BEGIN_LINE.search(line)
+        if begin:
+            current = (int(begin.group(1)), int(begin.group(3)), [])
+            continue
+        if current is None:
+            continue
+        if "TRACE END" in line:
+            yield current
+            current = None
+            continue
+        record = RECORD_LINE.search(line)
+        if record:
+            current[2].append(tuple(int(g, 16) for g in record.groups()))
+
+
+def unwrap(records):
+    """Records are in write order, make the 32-bit timestamps monotonic across timer wrap."""
+    offset = 0
+    previous = None
+    result = []
+    for timestamp, event, arg in records:
+        if previous is not None and timestamp + offset < previous - TIMESTAMP_WRAP // 2:
+            offset += TIMESTAMP_WRAP
+        previous = timestamp + offset
+        result.append((previous, event, arg))
+    return result
+
+
+def to_events(records, ids, ticks_per_us, latencies):
+    events = []
+    start = records[0][0] if records else 0
+    pending_irq = None
+
+    for timestamp, event, arg in sorted(records, key=lambda r: r[0]):
+        name = ids.get(event, "EVENT_%d" % event)
+        ts = (timestamp - start) / ticks_per_us
+        entry = {"pid": PID, "ts": ts, "args": {"arg": arg}}
+
+        if name.endswith("_IRQ"):
+            entry.update(name=name, ph="i", s="t", tid=TID_IRQ)
+            if pending_irq is None:
+                pending_irq = (ts, name)
+        elif name.endswith("_BEGIN"):
+            entry.update(name=name[:-len("_BEGIN")], ph="B", tid=TID_TASK)
+        elif name.endswith("_END"):
+            entry.update(name=name[:-len("_END")], ph="E", tid=TID_TASK)
+        else:
+            entry.update(name=name, ph="i", s="t", tid=TID_TASK)
+        events.append(entry)
+
+        # the first task side event after an interrupt is the reaction to it
+        if pending_irq is not None and entry["tid"] == TID_TASK:
+            irq_ts, irq_name = pending_irq
+            latencies.append(ts - irq_ts)
+            events.append({"pid": PID, "tid": TID_LATENCY, "ph": "X", "name": irq_name + " -> " + name,
+                           "ts": irq_ts, "dur": ts - irq_ts})
+            pending_irq = None
+
+    return events
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", nargs="?", help="UART log, stdin if omitted")
+    parser.add_argument("-o", "--output", help="JSON output, stdout if omitted")
+    parser.add_argument("--ids", default=DEFAULT_IDS, help="header with the BleTraceId enum")
+    args = parser.parse_args()
+
+    ids = load_ids(args.ids)
+    with (open(args.log, errors="replace") if args.log else sys.stdin) as f:
+        dumps = list(parse_dumps(f))
+    if not dumps:
+        sys.exit("no complete TRACE BEGIN/END block found")
+
+    events = [
+        {"pid": PID, "tid": TID_IRQ, "ph": "M", "name": "thread_name", "args": {"name": "IRQ"}},
+        {"pid": PID, "tid": TID_TASK, "ph": "M", "name": "thread_name", "args": {"name": "BleTask"}},
+        {"pid": PID, "tid": TID_LATENCY, "ph": "M", "name": "thread_name", "args": {"name": "IRQ to task"}},
+    ]
+    latencies = []
+    # the last dump in the log is the most recent one
+    ticks_per_us, overwritten, records = dumps[-1]
+    events += to_events(unwrap(records), ids, ticks_per_us, latencies)
+
+    with (open(args.output, "w") if args.output else sys.stdout) as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, f)
+
+    sys.stderr.write("%d records, %d overwritten before the dump\n" % (len(records), overwritten))
+    if latencies:
+        sys.stderr.write("IRQ to task latency: n %d, min %.1f us, avg %.1f us, p99 %.1f us, max %.1f us\n"
+                         % (len(latencies), min(latencies), sum(latencies) / len(latencies),
+                            percentile(latencies, 0.99), max(latencies)))
+
+
+if __name__ == "__main__":
+    main()
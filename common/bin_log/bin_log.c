@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "bin_log.h"
+
+void BinLogPrintLine(const char *line, void *ctx)
+{
+    (void)ctx;
+
+    printf("%s\r\n", line);
+}
+
+int BinLogInit(BinLog *log, BinLogRecord *buf, uint32_t capacity)
+{
+    if (log == NULL || buf == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        buf[i].seq = 0;
+    }
+
+    log->buf = buf;
+    log->mask = capacity - 1;
+    log->head = 0;
+    log->tail = 0;
+    log->drops = 0;
+
+    return 0;
+}
+
+uint32_t BinLogDrain(BinLog *log, BinLogOutput out, void *ctx, uint32_t max)
+{
+    char line[BIN_LOG_LINE_MAX];
+    uint32_t count = 0;
+
+    uint32_t drops = __atomic_exchange_n(&log->drops, 0, __ATOMIC_RELAXED);
+    if (drops != 0) {
+        (void)snprintf(line, sizeof(line), "BLOG DROP %u", (unsigned)drops);
+        out(line, ctx);
+    }
+
+    while (count < max) {
+        uint32_t tail = log->tail;
+        const BinLogRecord *rec = &log->buf[tail & log->mask];
+
+        /* A claimed slot is published only once its writer has filled it */
+        if (__atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE) != tail + 1) {
+            break;
+        }
+
+        int len = snprintf(line, sizeof(line), "BLOG %08x %04x", (unsigned)rec->timestamp, (unsigned)rec->id);
+        for (uint16_t i = 0; i < rec->argc; i++) {
+            len += snprintf(line + len, sizeof(line) - len, " %x", (unsigned)rec->args[i]);
+        }
+
+        /* The slot may be reused by writers from here on */
+        __atomic_store_n(&log->tail, tail + 1, __ATOMIC_RELEASE);
+
+        out(line, ctx);
+        count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_BIN_LOG_H
+#define VENDOR_TELINK_COMMON_BIN_LOG_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BIN_LOG_MAX_ARGS 4
+
+/* "BLOG " + timestamp + ID + BIN_LOG_MAX_ARGS arguments, all in hex with separators */
+#define BIN_LOG_LINE_MAX 64
+
+/**
+ *  @brief  Message catalog helper. A catalog is an X-macro list of X(name) entries, the format
+ *          string of each message is the literal macro name##_FMT. The firmware expands the list
+ *          with BIN_LOG_ENUM to get the message IDs, so the format strings never reach the image,
+ *          tools/bin_log_decode.py reads them from the header. Builds that print in place use
+ *          name##_FMT directly, which keeps the format literal for -Wformat.
+ */
+#define BIN_LOG_ENUM(name) name,
+
+/**
+ * @brief      printf format check only, never called, see BIN_LOG_FORMAT_CHECK
+ */
+static inline __attribute__((format(printf, 1, 2))) void BinLogFormatCheck(const char *fmt, ...)
+{
+    (void)fmt;
+}
+
+/* Lets -Wformat check the catalog format against the arguments, generates no code and evaluates nothing */
+#define BIN_LOG_FORMAT_CHECK(fmt, ...)                      \
+    do {                                                    \
+        if (0) {                                            \
+            BinLogFormatCheck((fmt), ##__VA_ARGS__);        \
+        }                                                   \
+    } while (0)
+
+/**
+ *  @brief  One message: timestamp, catalog ID and the raw 32-bit arguments
+ */
+typedef struct {
+    volatile uint32_t seq;  /* write position + 1 once the record is complete */
+    uint32_t timestamp;
+    uint16_t id;
+    uint16_t argc;
+    uint32_t args[BIN_LOG_MAX_ARGS];
+} BinLogRecord;
+
+/**
+ *  @brief  Lock-free multi-producer/single-consumer message ring.
+ *          Any number of writers, including interrupt handlers, may call BinLogWrite() concurrently:
+ *          a writer claims its slot with a compare-and-swap of head and publishes it through seq.
+ *          A full ring drops the new message and counts it. Only the consumer writes tail.
+ */
+typedef struct {
+    BinLogRecord *buf;
+    uint32_t mask;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t drops;
+} BinLog;
+
+/**
+ * @brief      Line sink of BinLogDrain()
+ * @param[in]  line  NUL terminated line without line break
+ * @param[in]  ctx   context passed to BinLogDrain()
+ * @return     none
+ */
+typedef void (*BinLogOutput)(const char *line, void *ctx);
+
+/**
+ * @brief      Line sink that prints to the UART with a CR LF line break, for BinLogDrain() and the other
+ *             line based dumps (trace ring, stack watermarks)
+ * @param[in]  line  NUL terminated line without line break
+ * @param[in]  ctx   unused
+ * @return     none
+ */
+void BinLogPrintLine(const char *line, void *ctx);
+
+/**
+ * @brief      Initialize the ring over a caller provided buffer
+ * @param[in]  log       ring descriptor
+ * @param[in]  buf       storage of capacity records
+ * @param[in]  capacity  number of records, must be a power of two
+ * @return     0 on success, -1 on invalid parameters
+ */
+int BinLogInit(BinLog *log, BinLogRecord *buf, uint32_t capacity);
+
+/**
+ * @brief      Append a message. Inline so it can be used from RAM code interrupt handlers.
+ * @param[in]  log        ring descriptor
+ * @param[in]  timestamp  current timer tick
+ * @param[in]  id         catalog ID
+ * @param[in]  args       message arguments
+ * @param[in]  argc       number of arguments, more than BIN_LOG_MAX_ARGS are cut off
+ * @return     none
+ */
+static inline void BinLogWrite(BinLog *log, uint32_t timestamp, uint16_t id, const uint32_t *args, uint32_t argc)
+{
+    uint32_t pos = __atomic_load_n(&log->head, __ATOMIC_RELAXED);
+
+    do {
+        if (pos - __atomic_load_n(&log->tail, __ATOMIC_ACQUIRE) > log->mask) {
+            __atomic_fetch_add(&log->drops, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&log->head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    BinLogRecord *rec = &log->buf[pos & log->mask];
+    if (argc > BIN_LOG_MAX_ARGS) {
+        argc = BIN_LOG_MAX_ARGS;
+    }
+    rec->timestamp = timestamp;
+    rec->id = id;
+    rec->argc = (uint16_t)argc;
+    for (uint32_t i = 0; i < argc; i++) {
+        rec->args[i] = args[i];
+    }
+
+    __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief      Append a message with up to BIN_LOG_MAX_ARGS integer arguments, e.g.
+ *             BIN_LOG_WRITE(&log, now, APP_LOG_CONNECT, handle, interval)
+ */
+#define BIN_LOG_WRITE(log, timestamp, id, ...)                                                              \
+    do {                                                                                                    \
+        const uint32_t binLogArgs_[] = {0, ##__VA_ARGS__};                                                  \
+        _Static_assert(sizeof(binLogArgs_) <= sizeof(uint32_t) * (BIN_LOG_MAX_ARGS + 1), "too many args");  \
+        BinLogWrite((log), (timestamp), (id), &binLogArgs_[1], sizeof(binLogArgs_) / sizeof(uint32_t) - 1); \
+    } while (0)
+
+/**
+ * @brief      Consume up to max messages, oldest first, as text lines that tools/bin_log_decode.py
+ *             understands: "BLOG <ts> <id> [<arg>...]" in hex, preceded by "BLOG DROP <n>" when
+ *             messages were lost since the previous call. Consumer side, call from one task only.
+ * @param[in]  log  ring descriptor
+ * @param[in]  out  line sink
+ * @param[in]  ctx  passed to out
+ * @param[in]  max  maximum number of messages
+ * @return     number of messages consumed
+ */
+uint32_t BinLogDrain(BinLog *log, BinLogOutput out, void *ctx, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_BIN_LOG_H */
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <los_task.h>
+
+#include <drivers.h>
+
+#include "bin_log_task.h"
+
+#define BIN_LOG_TASK_PRIORITY   OS_TASK_PRIORITY_LOWEST
+/* Messages per drain pass and pause when the ring runs empty */
+#define BIN_LOG_DRAIN_BATCH     16
+#define BIN_LOG_DRAIN_MS        20
+
+static BinLog *g_binLogTaskLog;
+
+STATIC VOID BinLogTask(VOID)
+{
+    char line[BIN_LOG_LINE_MAX];
+
+    (void)snprintf(line, sizeof(line), "BLOG BEGIN %u", (unsigned)SYSTEM_TIMER_TICK_1US);
+    BinLogPrintLine(line, NULL);
+
+    while (1) {
+        if (BinLogDrain(g_binLogTaskLog, BinLogPrintLine, NULL, BIN_LOG_DRAIN_BATCH) == 0) {
+            LOS_Msleep(BIN_LOG_DRAIN_MS);
+        }
+    }
+}
+
+uint32_t BinLogTaskStart(BinLog *log, BinLogRecord *buf, uint32_t capacity, uint32_t stackSize)
+{
+    if (g_binLogTaskLog != NULL || BinLogInit(log, buf, capacity) != 0) {
+        return LOS_NOK;
+    }
+    g_binLogTaskLog = log;
+
+    UINT32 taskId = 0;
+    TSK_INIT_PARAM_S taskParam = {0};
+    taskParam.pfnTaskEntry = (TSK_ENTRY_FUNC)BinLogTask;
+    taskParam.uwArg = 0;
+    taskParam.uwStackSize = stackSize;
+    taskParam.pcName = "BinLogTask";
+    taskParam.usTaskPrio = BIN_LOG_TASK_PRIORITY;
+
+    return LOS_TaskCreate(&taskId, &taskParam);
+}
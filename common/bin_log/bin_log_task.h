@@ -0,0 +1,46 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_BIN_LOG_TASK_H
+#define VENDOR_TELINK_COMMON_BIN_LOG_TASK_H
+
+#include <stdint.h>
+
+#include "bin_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief      Initialize the ring of a product's message catalog and start the task that drains it
+ *             to the UART with BinLogPrintLine(). The task runs at OS_TASK_PRIORITY_LOWEST, below every
+ *             application task, so formatting only takes idle time. One log per image.
+ * @param[in]  log        ring descriptor the product's log macro writes to
+ * @param[in]  buf        storage of capacity records
+ * @param[in]  capacity   number of records, must be a power of two
+ * @param[in]  stackSize  task stack size in bytes
+ * @return     LOS_OK, LOS_NOK for invalid parameters or a second log, or the error of LOS_TaskCreate()
+ */
+uint32_t BinLogTaskStart(BinLog *log, BinLogRecord *buf, uint32_t capacity, uint32_t stackSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_BIN_LOG_TASK_H */
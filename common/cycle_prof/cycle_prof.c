@@ -0,0 +1,38 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "cycle_prof.h"
+
+void CycleProfReset(CycleProfPoint *point)
+{
+    const char *name = point->name;
+
+    memset(point, 0, sizeof(*point));
+    point->name = name;
+}
+
+uint32_t CycleProfAvg(const CycleProfPoint *point)
+{
+    if (point->count == 0) {
+        return 0;
+    }
+
+    return (uint32_t)(point->sum / point->count);
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_CYCLE_PROF_H
+#define VENDOR_TELINK_COMMON_CYCLE_PROF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Set CYCLE_PROF_ENABLE=1 in the defines of the user to build the measurement points in */
+#ifndef CYCLE_PROF_ENABLE
+#define CYCLE_PROF_ENABLE 0
+#endif
+
+/* Bucket i counts durations of [2^i, 2^(i+1)) cycles, the last bucket also takes everything longer */
+#define CYCLE_PROF_HIST_BUCKETS 24
+
+/**
+ *  @brief  Latency statistics of one measurement point, in CPU cycles.
+ *          A zero initialized point is valid, only name needs to be set.
+ */
+typedef struct {
+    const char *name;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[CYCLE_PROF_HIST_BUCKETS];
+} CycleProfPoint;
+
+/**
+ * @brief      Read the low word of the RISC-V mcycle counter
+ * @return     current CPU cycle count
+ */
+static inline uint32_t CycleProfNow(void)
+{
+#if defined(__riscv)
+    uint32_t cycles;
+    __asm__ volatile("csrr %0, mcycle" : "=r"(cycles));
+    return cycles;
+#elif defined(__x86_64__) || defined(__i386__)
+    /* host builds of code using the profiler */
+    return (uint32_t)__builtin_ia32_rdtsc();
+#else
+#error "cycle_prof needs the RISC-V mcycle counter"
+#endif
+}
+
+/**
+ * @brief      Clear the statistics, the name is kept
+ * @param[in]  point  measurement point
+ * @return     none
+ */
+void CycleProfReset(CycleProfPoint *point);
+
+/**
+ * @brief      Histogram bucket of a duration, floor(log2) clamped to the last bucket. Spelled out instead
+ *             of __builtin_clz(), which may become a libgcc call in flash on cores without Zbb.
+ * @param[in]  cycles  duration in CPU cycles
+ * @return     bucket index
+ */
+static inline int CycleProfBucket(uint32_t cycles)
+{
+    int bucket = 0;
+
+    for (int shift = 16; shift > 0; shift >>= 1) {
+        if (cycles >= (1u << shift)) {
+            cycles >>= shift;
+            bucket += shift;
+        }
+    }
+
+    return (bucket < CYCLE_PROF_HIST_BUCKETS) ? bucket : CYCLE_PROF_HIST_BUCKETS - 1;
+}
+
+/**
+ * @brief      Account one measured duration, not reentrant per point. Inline, so RAM code and interrupt
+ *             handlers can record without a call into flash.
+ * @param[in]  point   measurement point
+ * @param[in]  cycles  duration in CPU cycles
+ * @return     none
+ */
+static inline void CycleProfRecord(CycleProfPoint *point, uint32_t cycles)
+{
+    if (point->count == 0 || cycles < point->min) {
+        point->min = cycles;
+    }
+    if (cycles > point->max) {
+        point->max = cycles;
+    }
+    point->count++;
+    point->sum += cycles;
+    point->hist[CycleProfBucket(cycles)]++;
+}
+
+/**
+ * @brief      Average duration
+ * @param[in]  point  measurement point
+ * @return     average in CPU cycles, 0 if nothing was recorded
+ */
+uint32_t CycleProfAvg(const CycleProfPoint *point);
+
+#if CYCLE_PROF_ENABLE
+#define CYCLE_PROF_BEGIN(tag)       uint32_t cycleProfStart_##tag = CycleProfNow()
+#define CYCLE_PROF_END(tag, point)  CycleProfRecord((point), CycleProfNow() - cycleProfStart_##tag)
+#else
+/* Nothing is evaluated, so point may refer to objects that only exist when profiling is enabled */
+#define CYCLE_PROF_BEGIN(tag)
+#define CYCLE_PROF_END(tag, point)
+#endif /* CYCLE_PROF_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_CYCLE_PROF_H */
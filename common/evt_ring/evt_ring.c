@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "evt_ring.h"
+
+int EvtRingInit(EvtRing *ring, void *buf, uint16_t elemSize, uint16_t capacity)
+{
+    if (ring == NULL || buf == NULL || elemSize == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+
+    ring->buf = (uint8_t *)buf;
+    ring->elemSize = elemSize;
+    ring->capacity = capacity;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->drops = 0;
+    ring->highWater = 0;
+
+    return 0;
+}
+
+int EvtRingPush(EvtRing *ring, const void *elem)
+{
+    uint32_t head = ring->head;
+    uint32_t used = head - ring->tail;
+
+    if (used >= ring->capacity) {
+        ring->drops++;
+        return -1;
+    }
+
+    (void)memcpy(ring->buf + (head & (ring->capacity - 1)) * ring->elemSize, elem, ring->elemSize);
+
+    /* element must be visible before the consumer can see the new head */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ring->head = head + 1;
+
+    if (used + 1 > ring->highWater) {
+        ring->highWater = used + 1;
+    }
+
+    return 0;
+}
+
+int EvtRingPop(EvtRing *ring, void *elem)
+{
+    uint32_t tail = ring->tail;
+
+    if (tail == ring->head) {
+        return -1;
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    (void)memcpy(elem, ring->buf + (tail & (ring->capacity - 1)) * ring->elemSize, ring->elemSize);
+
+    /* slot must be read out before the producer may reuse it */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ring->tail = tail + 1;
+
+    return 0;
+}
+
+uint32_t EvtRingCount(const EvtRing *ring)
+{
+    return ring->head - ring->tail;
+}
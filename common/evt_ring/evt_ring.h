@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_EVT_RING_H
+#define VENDOR_TELINK_COMMON_EVT_RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  @brief  Lock-free single-producer/single-consumer ring of fixed-size elements.
+ *          The producer may run in interrupt or BLE stack context, the consumer in a task.
+ *          Only the producer writes head, drops and highWater; only the consumer writes tail.
+ */
+typedef struct {
+    uint8_t *buf;
+    uint16_t elemSize;
+    uint16_t capacity;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    uint32_t drops;
+    uint32_t highWater;
+} EvtRing;
+
+/**
+ * @brief      Initialize the ring over a caller provided buffer
+ * @param[in]  ring      ring descriptor
+ * @param[in]  buf       storage of capacity * elemSize bytes
+ * @param[in]  elemSize  size of one element in bytes
+ * @param[in]  capacity  number of elements, must be a power of two
+ * @return     0 on success, -1 on invalid parameters
+ */
+int EvtRingInit(EvtRing *ring, void *buf, uint16_t elemSize, uint16_t capacity);
+
+/**
+ * @brief      Copy an element into the ring, producer side
+ * @param[in]  ring  ring descriptor
+ * @param[in]  elem  element of elemSize bytes
+ * @return     0 on success, -1 if the ring is full (the element is dropped and counted)
+ */
+int EvtRingPush(EvtRing *ring, const void *elem);
+
+/**
+ * @brief      Copy the oldest element out of the ring, consumer side
+ * @param[in]  ring  ring descriptor
+ * @param[out] elem  element of elemSize bytes
+ * @return     0 on success, -1 if the ring is empty
+ */
+int EvtRingPop(EvtRing *ring, void *elem);
+
+uint32_t EvtRingCount(const EvtRing *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_EVT_RING_H */
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include "gpio_debounce.h"
+
+void GpioDebounceInit(GpioDebounce *db, uint8_t level, uint32_t windowTicks)
+{
+    db->windowTicks = windowTicks;
+    db->lastEdge = 0;
+    db->burstStart = 0;
+    db->stable = level;
+    db->level = level;
+    db->pending = 0;
+}
+
+void GpioDebounceEdge(GpioDebounce *db, uint8_t level, uint32_t timestamp)
+{
+    if (!db->pending) {
+        db->burstStart = timestamp;
+        db->pending = 1;
+    }
+    db->lastEdge = timestamp;
+    db->level = level;
+}
+
+void GpioDebounceSetLevel(GpioDebounce *db, uint8_t level)
+{
+    db->level = level;
+}
+
+int GpioDebouncePoll(GpioDebounce *db, uint32_t now, uint8_t *level, uint32_t *timestamp)
+{
+    if (GpioDebounceRemaining(db, now) != 0 || !db->pending) {
+        return 0;
+    }
+
+    db->pending = 0;
+
+    /* A glitch that ended on the stable level is no change */
+    if (db->level == db->stable) {
+        return 0;
+    }
+
+    db->stable = db->level;
+    *level = db->stable;
+    *timestamp = db->burstStart;
+
+    return 1;
+}
+
+uint32_t GpioDebounceRemaining(const GpioDebounce *db, uint32_t now)
+{
+    if (!db->pending) {
+        return UINT32_MAX;
+    }
+
+    /* Signed, an edge stamped after now (sampled before the edge was taken in) is no quiet time */
+    int32_t quiet = (int32_t)(now - db->lastEdge);
+
+    return (quiet >= (int32_t)db->windowTicks) ? 0 : (db->windowTicks - (uint32_t)quiet);
+}
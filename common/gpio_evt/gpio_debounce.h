@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_GPIO_DEBOUNCE_H
+#define VENDOR_TELINK_COMMON_GPIO_DEBOUNCE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  @brief  Software debouncer of one input. Raw edges restart a quiet window, the level is reported
+ *          once no edge was seen for the whole window and it differs from the last reported one.
+ *          Timestamps are free running 32-bit timer ticks, wrap-around is handled.
+ *          Uses no kernel or driver API so it builds and runs on the host as well.
+ */
+typedef struct {
+    uint32_t windowTicks;
+    uint32_t lastEdge;      /* timestamp of the most recent raw edge */
+    uint32_t burstStart;    /* timestamp of the first raw edge since the last report */
+    uint8_t stable;         /* last reported level */
+    uint8_t level;          /* most recent raw level */
+    uint8_t pending;        /* raw edges seen since the last report */
+} GpioDebounce;
+
+/**
+ * @brief      Initialize the debouncer
+ * @param[in]  db           debouncer
+ * @param[in]  level        current level of the input
+ * @param[in]  windowTicks  quiet time before a level is accepted, 0 accepts every edge
+ * @return     none
+ */
+void GpioDebounceInit(GpioDebounce *db, uint8_t level, uint32_t windowTicks);
+
+/**
+ * @brief      Feed one raw edge, in timestamp order
+ * @param[in]  db         debouncer
+ * @param[in]  level      level after the edge
+ * @param[in]  timestamp  time of the edge
+ * @return     none
+ */
+void GpioDebounceEdge(GpioDebounce *db, uint8_t level, uint32_t timestamp);
+
+/**
+ * @brief      Replace the most recent raw level with a fresh read of the input, for when edges may have
+ *             been lost before reaching GpioDebounceEdge()
+ * @param[in]  db     debouncer
+ * @param[in]  level  current level of the input
+ * @return     none
+ */
+void GpioDebounceSetLevel(GpioDebounce *db, uint8_t level);
+
+/**
+ * @brief      Check whether the input has settled
+ * @param[in]  db         debouncer
+ * @param[in]  now        current time
+ * @param[out] level      new stable level
+ * @param[out] timestamp  time of the first edge of the burst that led to it
+ * @return     1 if a new stable level is reported, 0 otherwise
+ */
+int GpioDebouncePoll(GpioDebounce *db, uint32_t now, uint8_t *level, uint32_t *timestamp);
+
+/**
+ * @brief      Time until GpioDebouncePoll() may report something
+ * @param[in]  db   debouncer
+ * @param[in]  now  current time, edges stamped after it keep the window open
+ * @return     ticks to wait, 0 if a poll is due now, UINT32_MAX if nothing is pending
+ */
+uint32_t GpioDebounceRemaining(const GpioDebounce *db, uint32_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_GPIO_DEBOUNCE_H */
@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+
+#include <los_event.h>
+#include <los_interrupt.h>
+#include <los_task.h>
+#include <los_tick.h>
+
+#include <gpio_if.h>
+#include <drivers.h>
+
+#include "evt_ring.h"
+#include "gpio_debounce.h"
+#include "gpio_fast.h"
+#include "gpio_evt.h"
+
+#define GPIO_EVT_WAKE 0x1
+
+_Static_assert((GPIO_EVT_RING_LEN & (GPIO_EVT_RING_LEN - 1)) == 0, "GPIO_EVT_RING_LEN must be a power of two");
+
+typedef struct {
+    uint32_t timestamp;
+    uint16_t hdfIndex;
+    uint16_t level;
+} GpioEvtEdge;
+
+typedef struct {
+    GpioFast io;
+    GpioDebounce db;
+} GpioEvtPin;
+
+typedef struct {
+    uint16_t hdfIndex;
+    GpioEvtCallback cb;
+    void *ctx;
+} GpioEvtSubscriber;
+
+static struct {
+    EvtRing ring;
+    GpioEvtEdge ringBuff[GPIO_EVT_RING_LEN];
+    GpioEvtPin pins[GPIO_EVT_MAX_PINS];
+    uint16_t pinCount;
+    GpioEvtSubscriber subs[GPIO_EVT_MAX_SUBSCRIBERS];
+    uint16_t subCount;
+    EVENT_CB_S wake;
+    uint8_t started;
+    uint32_t edges;
+    uint32_t events;
+} g_gpioEvt;
+
+static GpioEvtPin *GpioEvtFindPin(uint16_t hdfIndex)
+{
+    for (uint16_t i = 0; i < g_gpioEvt.pinCount; i++) {
+        if (g_gpioEvt.pins[i].io.hdfIndex == hdfIndex) {
+            return &g_gpioEvt.pins[i];
+        }
+    }
+
+    return NULL;
+}
+
+void GpioEvtInit(void)
+{
+    (void)EvtRingInit(&g_gpioEvt.ring, g_gpioEvt.ringBuff, sizeof(GpioEvtEdge), GPIO_EVT_RING_LEN);
+    g_gpioEvt.pinCount = 0;
+    g_gpioEvt.subCount = 0;
+    g_gpioEvt.started = 0;
+    g_gpioEvt.edges = 0;
+    g_gpioEvt.events = 0;
+}
+
+/*
+ * Called through the HDF GPIO interrupt dispatch, which runs from flash, and calls flash-resident code
+ * itself (EvtRingPush(), LOS_EventWrite()), so it stays in flash as well.
+ */
+int32_t GpioEvtIsr(uint16_t gpio, void *data)
+{
+    (void)data;
+
+    GpioEvtPin *pin = GpioEvtFindPin(gpio);
+    if (pin == NULL) {
+        return 0;
+    }
+
+    GpioEvtEdge edge = {
+        .timestamp = stimer_get_tick(),
+        .hdfIndex = gpio,
+        .level = GpioFastRead(&pin->io),
+    };
+
+    /* GPIO interrupt sources may preempt each other, the ring has a single producer */
+    UINT32 intSave = LOS_IntLock();
+    (void)EvtRingPush(&g_gpioEvt.ring, &edge);
+    LOS_IntRestore(intSave);
+
+    if (g_gpioEvt.started) {
+        (void)LOS_EventWrite(&g_gpioEvt.wake, GPIO_EVT_WAKE);
+    }
+
+    return 0;
+}
+
+int GpioEvtAddPin(uint16_t hdfIndex, uint32_t debounceMs)
+{
+    if (g_gpioEvt.pinCount >= GPIO_EVT_MAX_PINS || GpioEvtFindPin(hdfIndex) != NULL) {
+        return -1;
+    }
+
+    GpioEvtPin *pin = &g_gpioEvt.pins[g_gpioEvt.pinCount];
+
+    if (GpioSetDir(hdfIndex, GPIO_DIR_IN) != 0) {
+        return -1;
+    }
+    (void)GpioFastInit(&pin->io, hdfIndex);
+    GpioDebounceInit(&pin->db, (uint8_t)GpioFastRead(&pin->io), debounceMs * SYSTEM_TIMER_TICK_1MS);
+
+    /* Published before the interrupt can look the pin up */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    g_gpioEvt.pinCount++;
+
+    if (GpioSetIrq(hdfIndex, GPIO_IRQ_TRIGGER_RISING | GPIO_IRQ_TRIGGER_FALLING, GpioEvtIsr, NULL) != 0 ||
+        GpioEnableIrq(hdfIndex) != 0) {
+        g_gpioEvt.pinCount--;
+        return -1;
+    }
+
+    return 0;
+}
+
+int GpioEvtSubscribe(uint16_t hdfIndex, GpioEvtCallback cb, void *ctx)
+{
+    if (g_gpioEvt.subCount >= GPIO_EVT_MAX_SUBSCRIBERS) {
+        return -1;
+    }
+
+    GpioEvtSubscriber *sub = &g_gpioEvt.subs[g_gpioEvt.subCount];
+    sub->hdfIndex = hdfIndex;
+    sub->cb = cb;
+    sub->ctx = ctx;
+    g_gpioEvt.subCount++;
+
+    return 0;
+}
+
+static void GpioEvtDeliver(const GpioEvt *evt)
+{
+    g_gpioEvt.events++;
+
+    for (uint16_t i = 0; i < g_gpioEvt.subCount; i++) {
+        const GpioEvtSubscriber *sub = &g_gpioEvt.subs[i];
+        if (sub->hdfIndex == GPIO_EVT_ANY_PIN || sub->hdfIndex == evt->hdfIndex) {
+            sub->cb(evt, sub->ctx);
+        }
+    }
+}
+
+uint32_t GpioEvtProcess(uint32_t now)
+{
+    GpioEvtEdge edge;
+
+    while (EvtRingPop(&g_gpioEvt.ring, &edge) == 0) {
+        GpioEvtPin *pin = GpioEvtFindPin(edge.hdfIndex);
+        if (pin != NULL) {
+            GpioDebounceEdge(&pin->db, (uint8_t)edge.level, edge.timestamp);
+        }
+        g_gpioEvt.edges++;
+    }
+
+    uint32_t next = UINT32_MAX;
+
+    for (uint16_t i = 0; i < g_gpioEvt.pinCount; i++) {
+        GpioEvtPin *pin = &g_gpioEvt.pins[i];
+        uint8_t level;
+        uint32_t timestamp;
+
+        /* Edges lost to a full ring leave a stale raw level behind, take the settled one from the pin */
+        if (GpioDebounceRemaining(&pin->db, now) == 0) {
+            GpioDebounceSetLevel(&pin->db, (uint8_t)GpioFastRead(&pin->io));
+        }
+
+        if (GpioDebouncePoll(&pin->db, now, &level, &timestamp)) {
+            GpioEvt evt = {
+                .hdfIndex = pin->io.hdfIndex,
+                .level = level,
+                .timestamp = timestamp,
+            };
+            GpioEvtDeliver(&evt);
+        }
+
+        uint32_t remaining = GpioDebounceRemaining(&pin->db, now);
+        if (remaining < next) {
+            next = remaining;
+        }
+    }
+
+    return next;
+}
+
+STATIC VOID GpioEvtTask(VOID)
+{
+    UINT32 timeout = LOS_WAIT_FOREVER;
+
+    while (1) {
+        (void)LOS_EventRead(&g_gpioEvt.wake, GPIO_EVT_WAKE, LOS_WAITMODE_OR | LOS_WAITMODE_CLR, timeout);
+
+        uint32_t next = GpioEvtProcess(stimer_get_tick());
+        if (next == UINT32_MAX) {
+            timeout = LOS_WAIT_FOREVER;
+        } else {
+            /* Round up, waking before the window closed would only spin */
+            timeout = LOS_MS2Tick((next + SYSTEM_TIMER_TICK_1MS - 1) / SYSTEM_TIMER_TICK_1MS);
+            if (timeout == 0) {
+                timeout = 1;
+            }
+        }
+    }
+}
+
+uint32_t GpioEvtStart(uint16_t prio, uint32_t stackSize)
+{
+    UINT32 ret = LOS_EventInit(&g_gpioEvt.wake);
+    if (ret != LOS_OK) {
+        return ret;
+    }
+
+    UINT32 taskId = 0;
+    TSK_INIT_PARAM_S taskParam = {0};
+    taskParam.pfnTaskEntry = (TSK_ENTRY_FUNC)GpioEvtTask;
+    taskParam.uwArg = 0;
+    taskParam.uwStackSize = stackSize;
+    taskParam.pcName = "GpioEvtTask";
+    taskParam.usTaskPrio = prio;
+    ret = LOS_TaskCreate(&taskId, &taskParam);
+    if (ret != LOS_OK) {
+        return ret;
+    }
+
+    g_gpioEvt.started = 1;
+
+    return LOS_OK;
+}
+
+void GpioEvtGetStats(GpioEvtStats *stats)
+{
+    stats->edges = g_gpioEvt.edges;
+    stats->events = g_gpioEvt.events;
+    stats->drops = g_gpioEvt.ring.drops;
+    stats->highWater = g_gpioEvt.ring.highWater;
+}
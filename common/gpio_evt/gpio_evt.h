@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_GPIO_EVT_H
+#define VENDOR_TELINK_COMMON_GPIO_EVT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef GPIO_EVT_MAX_PINS
+#define GPIO_EVT_MAX_PINS 4
+#endif
+
+#ifndef GPIO_EVT_MAX_SUBSCRIBERS
+#define GPIO_EVT_MAX_SUBSCRIBERS 4
+#endif
+
+/* Raw edges buffered between the interrupt handler and the consumer task, a power of two */
+#ifndef GPIO_EVT_RING_LEN
+#define GPIO_EVT_RING_LEN 64
+#endif
+
+/* Subscribe to all pins */
+#define GPIO_EVT_ANY_PIN 0xFFFF
+
+/**
+ *  @brief  Debounced input change
+ */
+typedef struct {
+    uint16_t hdfIndex;
+    uint16_t level;         /* GPIO_VAL_LOW or GPIO_VAL_HIGH */
+    uint32_t timestamp;     /* stimer tick of the first raw edge of the change */
+} GpioEvt;
+
+/**
+ * @brief      Subscriber callback, runs in the consumer task
+ * @param[in]  evt  debounced change
+ * @param[in]  ctx  context passed to GpioEvtSubscribe()
+ * @return     none
+ */
+typedef void (*GpioEvtCallback)(const GpioEvt *evt, void *ctx);
+
+/**
+ *  @brief  Counters of the subsystem
+ */
+typedef struct {
+    uint32_t edges;         /* raw edges taken from the ring */
+    uint32_t events;        /* debounced changes delivered */
+    uint32_t drops;         /* raw edges lost to a full ring */
+    uint32_t highWater;     /* peak ring occupancy */
+} GpioEvtStats;
+
+/**
+ * @brief      Initialize the ring and the pin table, before any other call
+ * @param[in]  none
+ * @return     none
+ */
+void GpioEvtInit(void);
+
+/**
+ * @brief      Configure a pin as input and capture its edges. The interrupt handler only records
+ *             the pin, its level and an stimer timestamp.
+ * @param[in]  hdfIndex    HDF GPIO index from board_config.h
+ * @param[in]  debounceMs  quiet time before a level is accepted
+ * @return     0 on success, -1 if the pin table is full or HDF rejects the pin
+ */
+int GpioEvtAddPin(uint16_t hdfIndex, uint32_t debounceMs);
+
+/**
+ * @brief      Register a callback for the debounced changes of one pin or of GPIO_EVT_ANY_PIN
+ * @param[in]  hdfIndex  HDF GPIO index or GPIO_EVT_ANY_PIN
+ * @param[in]  cb        callback
+ * @param[in]  ctx       passed to cb
+ * @return     0 on success, -1 if the subscriber table is full
+ */
+int GpioEvtSubscribe(uint16_t hdfIndex, GpioEvtCallback cb, void *ctx);
+
+/**
+ * @brief      Start the consumer task that debounces the edges and calls the subscribers
+ * @param[in]  prio       LiteOS task priority
+ * @param[in]  stackSize  task stack size in bytes, it also holds the subscriber callbacks
+ * @return     LOS_OK or the error of LOS_EventInit()/LOS_TaskCreate()
+ */
+uint32_t GpioEvtStart(uint16_t prio, uint32_t stackSize);
+
+/**
+ * @brief      GPIO interrupt handler installed by GpioEvtAddPin(), exposed for benchmarks
+ * @param[in]  gpio  HDF GPIO index
+ * @param[in]  data  unused
+ * @return     0
+ */
+int32_t GpioEvtIsr(uint16_t gpio, void *data);
+
+/**
+ * @brief      One pass of the consumer: take the recorded edges, debounce them and call the
+ *             subscribers. Run by the consumer task, exposed for benchmarks without it.
+ * @param[in]  now  current stimer tick
+ * @return     stimer ticks until the next debounce window closes, UINT32_MAX if none is open
+ */
+uint32_t GpioEvtProcess(uint32_t now);
+
+void GpioEvtGetStats(GpioEvtStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_GPIO_EVT_H */
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+
+#include <device_resource_if.h>
+#include <hdf_base.h>
+#include <drivers.h>
+
+#include "gpio_fast.h"
+
+/*
+ * GPIO controller node of the B91 HCS (device/soc/telink/b91/hcs): pinMap lists, per HDF GPIO index,
+ * the gpio_pin_e the B91 GPIO driver drives, so the fast path and HDF always agree on the wiring.
+ */
+#define GPIO_FAST_HCS_MATCH_ATTR    "gpio_config"
+#define GPIO_FAST_HCS_PIN_MAP       "pinMap"
+
+static const struct DeviceResourceNode *GpioFastConfigNode(const struct DeviceResourceIface **iface)
+{
+    *iface = DeviceResourceGetIfaceInstance(HDF_CONFIG_SOURCE);
+    if (*iface == NULL || (*iface)->GetRootNode == NULL || (*iface)->GetNodeByMatchAttr == NULL ||
+        (*iface)->GetUint16ArrayElem == NULL) {
+        return NULL;
+    }
+
+    return (*iface)->GetNodeByMatchAttr((*iface)->GetRootNode(), GPIO_FAST_HCS_MATCH_ATTR);
+}
+
+bool GpioFastInit(GpioFast *io, uint16_t hdfIndex)
+{
+    const struct DeviceResourceIface *iface = NULL;
+    uint16_t pin = 0;
+
+    io->in = NULL;
+    io->out = NULL;
+    io->mask = 0;
+    io->hdfIndex = hdfIndex;
+
+    const struct DeviceResourceNode *node = GpioFastConfigNode(&iface);
+    if (node == NULL || iface->GetUint16ArrayElem(node, GPIO_FAST_HCS_PIN_MAP, hdfIndex, &pin, 0) != HDF_SUCCESS ||
+        pin == 0) {
+        return false;
+    }
+
+    /* gpio_pin_e holds the port in the high byte and the pin mask in the low byte */
+    io->in = &reg_gpio_in(pin);
+    io->out = &reg_gpio_out(pin);
+    io->mask = pin & 0xff;
+
+    return true;
+}
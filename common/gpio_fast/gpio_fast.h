@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_GPIO_FAST_H
+#define VENDOR_TELINK_COMMON_GPIO_FAST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <gpio_if.h>
+#include <los_interrupt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  @brief  Pin resolved to its port input and output registers. Accesses through it bypass the
+ *          HDF service dispatch, so they are cheap enough for BLE stack callbacks and ISRs.
+ *          Pins missing from the pin map of the HCS keep going through HDF GpioWrite()/GpioRead().
+ */
+typedef struct {
+    volatile uint8_t *in;
+    volatile uint8_t *out;
+    uint8_t mask;
+    uint16_t hdfIndex;
+} GpioFast;
+
+/**
+ * @brief      Resolve an HDF GPIO index through the pin map of the GPIO controller in the HCS,
+ *             the pin direction must already be set via GpioSetDir()
+ * @param[out] io        resolved pin
+ * @param[in]  hdfIndex  HDF GPIO index from board_config.h
+ * @return     true if the register path is used, false if accesses fall back to HDF
+ */
+bool GpioFastInit(GpioFast *io, uint16_t hdfIndex);
+
+/**
+ * @brief      Set the output level. The port register is shared by up to eight pins, so its
+ *             read-modify-write runs with interrupts locked and may be called from tasks and ISRs.
+ * @param[in]  io   resolved pin
+ * @param[in]  val  GPIO_VAL_LOW or GPIO_VAL_HIGH
+ * @return     none
+ */
+static inline void GpioFastWrite(const GpioFast *io, uint16_t val)
+{
+    if (io->out == NULL) {
+        GpioWrite(io->hdfIndex, val);
+        return;
+    }
+
+    UINT32 intSave = LOS_IntLock();
+    if (val == GPIO_VAL_LOW) {
+        *io->out &= (uint8_t)~io->mask;
+    } else {
+        *io->out |= io->mask;
+    }
+    LOS_IntRestore(intSave);
+}
+
+/**
+ * @brief      Invert the output level, atomic like GpioFastWrite()
+ * @param[in]  io  resolved pin
+ * @return     none
+ */
+static inline void GpioFastToggle(const GpioFast *io)
+{
+    if (io->out == NULL) {
+        uint16_t val = GPIO_VAL_LOW;
+        GpioRead(io->hdfIndex, &val);
+        GpioWrite(io->hdfIndex, (val == GPIO_VAL_LOW) ? GPIO_VAL_HIGH : GPIO_VAL_LOW);
+        return;
+    }
+
+    UINT32 intSave = LOS_IntLock();
+    *io->out ^= io->mask;
+    LOS_IntRestore(intSave);
+}
+
+/**
+ * @brief      Read the input level, the pin may be configured as input or output
+ * @param[in]  io  resolved pin
+ * @return     GPIO_VAL_LOW or GPIO_VAL_HIGH
+ */
+static inline uint16_t GpioFastRead(const GpioFast *io)
+{
+    if (io->in == NULL) {
+        uint16_t val = GPIO_VAL_LOW;
+        GpioRead(io->hdfIndex, &val);
+        return val;
+    }
+
+    return (*io->in & io->mask) ? GPIO_VAL_HIGH : GPIO_VAL_LOW;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_GPIO_FAST_H */
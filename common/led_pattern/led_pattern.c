@@ -0,0 +1,244 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+
+#include <los_swtmr.h>
+#include <los_tick.h>
+
+#include <gpio_if.h>
+
+#include "led_pattern.h"
+
+#define LED_PATTERN_NO_TIMER 0xFFFFFFFF
+
+_Static_assert(LOSCFG_BASE_CORE_TICK_PER_SECOND >= 100 * LED_PATTERN_PWM_FRAME, "breathe PWM below 100 Hz flickers");
+
+static struct {
+    LedPatternLed *leds;
+    uint16_t count;
+    uint32_t timerId;
+    uint32_t tickMs;
+    uint32_t now;       /* engine ticks since start */
+    uint32_t timerTicks;    /* timer runs per engine tick, more than 1 when the timer also drives the PWM */
+    uint32_t timerPos;
+    uint8_t pwm;        /* a row breathes, the timer runs at the kernel tick */
+    uint8_t pwmPos;     /* kernel tick within the PWM period */
+    CycleProfPoint *probe;
+    uint32_t probePeriodMs;
+    uint32_t probeTicks;
+    uint32_t probeLast;
+} g_ledPattern = {
+    .timerId = LED_PATTERN_NO_TIMER,
+};
+
+static uint32_t LedPatternMsToTicks(uint32_t ms, uint32_t tickMs)
+{
+    return (ms + tickMs / 2) / tickMs;
+}
+
+static uint8_t LedPatternBreatheDuty(const LedPatternLed *led, uint32_t pos)
+{
+    uint32_t half = led->period / 2;
+    if (half == 0) {
+        return 0;
+    }
+
+    /* Triangle ramp up and down, squared so the fade looks even to the eye */
+    uint32_t ramp = (pos < half) ? pos : (led->period - pos);
+    uint32_t duty = ramp * LED_PATTERN_PWM_FRAME / half;
+
+    return duty * duty / LED_PATTERN_PWM_FRAME;
+}
+
+static uint8_t LedPatternLevel(const LedPatternLed *led)
+{
+    const LedPatternDesc *desc = led->desc;
+    uint32_t pos = (led->period == 0) ? 0 : ((g_ledPattern.now + led->phase) % led->period);
+
+    switch (desc->type) {
+        case LED_PATTERN_ON:
+            return GPIO_VAL_HIGH;
+        case LED_PATTERN_BLINK:
+            return (pos < led->on) ? GPIO_VAL_HIGH : GPIO_VAL_LOW;
+        case LED_PATTERN_SEQUENCE:
+            /* period holds the whole sequence, on the length of one step */
+            return (led->on != 0 && (desc->sequence >> (pos / led->on)) & 1) ? GPIO_VAL_HIGH : GPIO_VAL_LOW;
+        default:
+            return GPIO_VAL_LOW;
+    }
+}
+
+static void LedPatternSetLevel(LedPatternLed *led, uint8_t level)
+{
+    /* Only edges touch the pin */
+    if (level != led->level) {
+        led->level = level;
+        GpioFastWrite(&led->io, level);
+    }
+}
+
+static void LedPatternStep(void)
+{
+    if (g_ledPattern.probe != NULL && g_ledPattern.probeTicks != 0 &&
+        g_ledPattern.now % g_ledPattern.probeTicks == 0) {
+        uint32_t now = CycleProfNow();
+        if (g_ledPattern.probeLast != 0) {
+            CycleProfRecord(g_ledPattern.probe, now - g_ledPattern.probeLast);
+        }
+        g_ledPattern.probeLast = now;
+    }
+
+    for (uint16_t i = 0; i < g_ledPattern.count; i++) {
+        LedPatternLed *led = &g_ledPattern.leds[i];
+        if (led->desc->type == LED_PATTERN_BREATHE) {
+            /* The PWM timer turns the duty into pin levels */
+            uint32_t pos = (led->period == 0) ? 0 : ((g_ledPattern.now + led->phase) % led->period);
+            led->duty = LedPatternBreatheDuty(led, pos);
+        } else {
+            LedPatternSetLevel(led, LedPatternLevel(led));
+        }
+    }
+
+    g_ledPattern.now++;
+}
+
+static void LedPatternPwmStep(void)
+{
+    for (uint16_t i = 0; i < g_ledPattern.count; i++) {
+        LedPatternLed *led = &g_ledPattern.leds[i];
+        if (led->desc->type == LED_PATTERN_BREATHE) {
+            LedPatternSetLevel(led, (g_ledPattern.pwmPos < led->duty) ? GPIO_VAL_HIGH : GPIO_VAL_LOW);
+        }
+    }
+
+    g_ledPattern.pwmPos = (g_ledPattern.pwmPos + 1) % LED_PATTERN_PWM_FRAME;
+}
+
+static void LedPatternTick(UINTPTR arg)
+{
+    (void)arg;
+
+    /* The ramp is updated first, so the PWM applies the new duty in the same kernel tick */
+    if (++g_ledPattern.timerPos >= g_ledPattern.timerTicks) {
+        g_ledPattern.timerPos = 0;
+        LedPatternStep();
+    }
+    if (g_ledPattern.pwm) {
+        LedPatternPwmStep();
+    }
+}
+
+static uint32_t LedPatternTimerStart(UINT32 interval, SWTMR_PROC_FUNC handler, uint32_t *timerId)
+{
+#if (LOSCFG_BASE_CORE_SWTMR_ALIGN == 1)
+    uint32_t ret = LOS_SwtmrCreate(interval, LOS_SWTMR_MODE_PERIOD, handler,
+                                   timerId, 0, OS_SWTMR_ROUSES_ALLOW, OS_SWTMR_ALIGN_SENSITIVE);
+#else
+    uint32_t ret = LOS_SwtmrCreate(interval, LOS_SWTMR_MODE_PERIOD, handler, timerId, 0);
+#endif /* LOSCFG_BASE_CORE_SWTMR_ALIGN */
+    if (ret != LOS_OK) {
+        *timerId = LED_PATTERN_NO_TIMER;
+        return ret;
+    }
+
+    return LOS_SwtmrStart(*timerId);
+}
+
+static void LedPatternTimerDelete(uint32_t *timerId)
+{
+    if (*timerId == LED_PATTERN_NO_TIMER) {
+        return;
+    }
+
+    LOS_SwtmrDelete(*timerId);
+    *timerId = LED_PATTERN_NO_TIMER;
+}
+
+uint32_t LedPatternStart(const LedPatternDesc *table, LedPatternLed *leds, uint16_t count, uint32_t tickMs)
+{
+    uint32_t ret;
+    uint16_t breathe = 0;
+
+    LedPatternStop();
+
+    /* Patterns are converted with the tick the timer really runs at */
+    UINT32 interval = LOS_MS2Tick(tickMs);
+    if (interval == 0) {
+        interval = 1;
+    }
+    tickMs = interval * OS_SYS_MS_PER_SECOND / LOSCFG_BASE_CORE_TICK_PER_SECOND;
+    if (tickMs == 0) {
+        tickMs = 1;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        const LedPatternDesc *desc = &table[i];
+        LedPatternLed *led = &leds[i];
+
+        led->desc = desc;
+        led->level = GPIO_VAL_LOW;
+        led->duty = 0;
+        led->phase = LedPatternMsToTicks(desc->phaseMs, tickMs);
+        if (desc->type == LED_PATTERN_SEQUENCE) {
+            led->on = LedPatternMsToTicks(desc->periodMs, tickMs);
+            led->period = led->on * ((desc->steps > 32) ? 32 : desc->steps);
+        } else {
+            led->on = LedPatternMsToTicks(desc->onMs, tickMs);
+            led->period = LedPatternMsToTicks(desc->periodMs, tickMs);
+        }
+        breathe += (desc->type == LED_PATTERN_BREATHE);
+
+        GpioSetDir(desc->hdfIndex, GPIO_DIR_OUT);
+        GpioFastInit(&led->io, desc->hdfIndex);
+        GpioFastWrite(&led->io, GPIO_VAL_LOW);
+    }
+
+    g_ledPattern.leds = leds;
+    g_ledPattern.count = count;
+    g_ledPattern.tickMs = tickMs;
+    g_ledPattern.now = 0;
+    g_ledPattern.pwm = (breathe != 0);
+    g_ledPattern.timerTicks = g_ledPattern.pwm ? interval : 1;
+    g_ledPattern.timerPos = 0;
+    g_ledPattern.pwmPos = 0;
+    g_ledPattern.probeTicks = LedPatternMsToTicks(g_ledPattern.probePeriodMs, tickMs);
+    g_ledPattern.probeLast = 0;
+
+    ret = LedPatternTimerStart(g_ledPattern.pwm ? 1 : interval, LedPatternTick, &g_ledPattern.timerId);
+    if (ret != LOS_OK) {
+        LedPatternStop();
+    }
+
+    return ret;
+}
+
+void LedPatternStop(void)
+{
+    LedPatternTimerDelete(&g_ledPattern.timerId);
+}
+
+void LedPatternSetProbe(CycleProfPoint *interval, uint32_t periodMs)
+{
+    g_ledPattern.probeLast = 0;
+    g_ledPattern.probePeriodMs = periodMs;
+    if (g_ledPattern.tickMs != 0) {
+        g_ledPattern.probeTicks = LedPatternMsToTicks(periodMs, g_ledPattern.tickMs);
+    }
+    g_ledPattern.probe = interval;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_LED_PATTERN_H
+#define VENDOR_TELINK_COMMON_LED_PATTERN_H
+
+#include <stdint.h>
+
+#include "cycle_prof.h"
+#include "gpio_fast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Breathe is software PWM: for tables with a breathe row the one pattern timer runs at the kernel tick and
+ * steps the patterns every engine tick. One PWM period is this many kernel ticks, 8 ms or 125 Hz at 1000 ticks
+ * per second.
+ */
+#define LED_PATTERN_PWM_FRAME 8
+
+typedef enum {
+    LED_PATTERN_OFF,
+    LED_PATTERN_ON,
+    LED_PATTERN_BLINK,
+    LED_PATTERN_BREATHE,
+    LED_PATTERN_SEQUENCE,
+} LedPatternType;
+
+/**
+ *  @brief  One row of the pattern table, usually const
+ */
+typedef struct {
+    uint16_t hdfIndex;  /* HDF GPIO index from board_config.h */
+    uint8_t type;       /* LedPatternType */
+    uint8_t steps;      /* sequence: number of steps, 1..32 */
+    uint16_t periodMs;  /* blink, breathe: length of one cycle; sequence: length of one step */
+    uint16_t onMs;      /* blink: on time at the start of the cycle */
+    uint16_t phaseMs;   /* start offset, shifts LEDs running the same pattern against each other */
+    uint32_t sequence;  /* sequence: bit i is the level of step i */
+} LedPatternDesc;
+
+/**
+ *  @brief  Run-time state of one LED, one per table row, owned by the engine while it runs
+ */
+typedef struct {
+    const LedPatternDesc *desc;
+    GpioFast io;
+    uint32_t period;    /* in engine ticks */
+    uint32_t on;
+    uint32_t phase;
+    uint8_t level;
+    uint8_t duty;       /* breathe: high kernel ticks per PWM period, updated every engine tick */
+} LedPatternLed;
+
+/**
+ * @brief      Configure the LEDs as outputs and start the software timer driving all of them, at the kernel
+ *             tick if a row breathes
+ * @param[in]  table   pattern table, must stay valid while the engine runs
+ * @param[out] leds    state, one per table row
+ * @param[in]  count   number of table rows
+ * @param[in]  tickMs  engine tick, the time resolution of all patterns, rounded to whole kernel ticks
+ * @return     LOS_OK or the error of LOS_SwtmrCreate()/LOS_SwtmrStart(), the timer does not run on error
+ */
+uint32_t LedPatternStart(const LedPatternDesc *table, LedPatternLed *leds, uint16_t count, uint32_t tickMs);
+
+/**
+ * @brief      Stop and delete the timer, the LEDs keep their last level
+ * @return     none
+ */
+void LedPatternStop(void);
+
+/**
+ * @brief      Record the cycles between engine ticks periodMs apart, for jitter measurement against other ways
+ *             of driving the LEDs at the same period
+ * @param[in]  interval  statistics to fill from the timer callback, NULL to stop
+ * @param[in]  periodMs  time between two samples, rounded to whole engine ticks
+ * @return     none
+ */
+void LedPatternSetProbe(CycleProfPoint *interval, uint32_t periodMs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_LED_PATTERN_H */
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+
+#include <los_task.h>
+
+#include "stack_wm.h"
+
+/* "STACK " + task name + 4 numbers + labels */
+#define STACK_WM_LINE_MAX (LOS_TASK_NAMELEN + 80)
+
+#define STACK_WM_ALIGN 16
+#define PERCENT        100
+
+void StackWmReport(StackWmOutput out, void *ctx)
+{
+    char line[STACK_WM_LINE_MAX];
+    TSK_INFO_S info;
+
+    for (UINT32 taskId = 0; taskId < LOSCFG_BASE_CORE_TSK_LIMIT; taskId++) {
+        /* Fails for unused task control blocks */
+        if (LOS_TaskInfoGet(taskId, &info) != LOS_OK) {
+            continue;
+        }
+
+        UINT32 suggest = info.uwPeakUsed + info.uwPeakUsed * STACK_WM_MARGIN_PERCENT / PERCENT;
+        suggest = (suggest + STACK_WM_ALIGN - 1) & ~(UINT32)(STACK_WM_ALIGN - 1);
+
+        (void)snprintf(line, sizeof(line), "STACK %s size %u peak %u (%u%%) suggest %u%s", info.acName,
+                       (unsigned)info.uwStackSize, (unsigned)info.uwPeakUsed,
+                       (unsigned)((info.uwStackSize != 0) ? info.uwPeakUsed * PERCENT / info.uwStackSize : 0),
+                       (unsigned)suggest, info.bOvf ? " OVERFLOW" : "");
+        out(line, ctx);
+    }
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_STACK_WM_H
+#define VENDOR_TELINK_COMMON_STACK_WM_H
+
+#include <stdint.h>
+
+#include <los_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stack size of a task from its GN arg, 0 keeps the kernel default */
+#define STACK_WM_SIZE(size) (((size) != 0) ? (size) : LOSCFG_BASE_CORE_TSK_DEFAULT_STACK_SIZE)
+
+/* Headroom on top of the measured peak for the suggested size, in percent */
+#define STACK_WM_MARGIN_PERCENT 25
+
+/**
+ * @brief      Line sink of StackWmReport()
+ * @param[in]  line  NUL terminated line without line break
+ * @param[in]  ctx   context passed to StackWmReport()
+ * @return     none
+ */
+typedef void (*StackWmOutput)(const char *line, void *ctx);
+
+/**
+ * @brief      Report the stack watermark of every task, one line per task:
+ *             "STACK <name> size <bytes> peak <bytes> (<percent>%) suggest <bytes>", with " OVERFLOW"
+ *             appended when the kernel found the stack top overwritten. The peak comes from the
+ *             kernel's stack fill pattern, so it covers everything since the task was created.
+ * @param[in]  out  line sink
+ * @param[in]  ctx  passed to out
+ * @return     none
+ */
+void StackWmReport(StackWmOutput out, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_STACK_WM_H */
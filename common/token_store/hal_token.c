@@ -16,48 +16,85 @@
  *
  *****************************************************************************/
 
+#include <los_mux.h>
+#include <los_task.h>
+
 #include "hal_token.h"
 #include "ohos_errno.h"
 #include "ohos_types.h"
+#include "token_flash_b91.h"
+#include "token_store.h"
+
+static TokenStore g_tokenStore;
+static BOOL g_tokenStoreReady = FALSE;
+static UINT32 g_tokenMux;
+static BOOL g_tokenMuxReady = FALSE;
+
+/**
+ * @brief      Take the token mutex, creating it on first use. Only the creation runs under the
+ *             scheduler lock; flash erase and programming run with the mutex held, so other tasks
+ *             keep being scheduled while a write takes its few ms.
+ */
+static BOOL OEMTokenLock(void)
+{
+    LOS_TaskLock();
+    if (!g_tokenMuxReady) {
+        g_tokenMuxReady = (LOS_MuxCreate(&g_tokenMux) == LOS_OK);
+    }
+    LOS_TaskUnlock();
+
+    return g_tokenMuxReady && (LOS_MuxPend(g_tokenMux, LOS_WAIT_FOREVER) == LOS_OK);
+}
+
+/**
+ * @brief      Access one slot of the token store, serialized by the token mutex
+ */
+static int OEMAccessSlot(TokenSlot slot, char *readBuf, const char *writeBuf, unsigned int len)
+{
+    int ret;
+
+    if (!OEMTokenLock()) {
+        return EC_FAILURE;
+    }
+    if (!g_tokenStoreReady) {
+        g_tokenStoreReady = (TokenStoreInit(&g_tokenStore, TokenFlashB91()) == TOKEN_STORE_OK);
+    }
+    if (!g_tokenStoreReady) {
+        ret = TOKEN_STORE_ERR_PARAM;
+    } else if (writeBuf != NULL) {
+        ret = TokenStoreWrite(&g_tokenStore, slot, writeBuf, len);
+    } else {
+        ret = TokenStoreRead(&g_tokenStore, slot, readBuf, len);
+    }
+    (void)LOS_MuxPost(g_tokenMux);
+
+    return (ret == TOKEN_STORE_OK) ? EC_SUCCESS : EC_FAILURE;
+}
 
 static int OEMReadToken(char *token, unsigned int len)
 {
-    // OEM need add here, read token from device
-    (void)(token);
-    (void)(len);
-    return EC_SUCCESS;
+    return OEMAccessSlot(TOKEN_SLOT_TOKEN, token, NULL, len);
 }
 
 static int OEMWriteToken(const char *token, unsigned int len)
 {
-    // OEM need add here, write token to device
-    (void)(token);
-    (void)(len);
-    return EC_SUCCESS;
+    return OEMAccessSlot(TOKEN_SLOT_TOKEN, NULL, token, len);
 }
 
+/* AcKey, ProdId and ProdKey are provisioned at the factory through TokenStoreWrite() */
 static int OEMGetAcKey(char *acKey, unsigned int len)
 {
-    // OEM need add here, get AcKey
-    (void)(acKey);
-    (void)(len);
-    return EC_SUCCESS;
+    return OEMAccessSlot(TOKEN_SLOT_AC_KEY, acKey, NULL, len);
 }
 
 static int OEMGetProdId(char *productId, unsigned int len)
 {
-    // OEM need add here, get ProdId
-    (void)(productId);
-    (void)(len);
-    return EC_SUCCESS;
+    return OEMAccessSlot(TOKEN_SLOT_PROD_ID, productId, NULL, len);
 }
 
 static int OEMGetProdKey(char *productKey, unsigned int len)
 {
-    // OEM need add here, get ProdKey
-    (void)(productKey);
-    (void)(len);
-    return EC_SUCCESS;
+    return OEMAccessSlot(TOKEN_SLOT_PROD_KEY, productKey, NULL, len);
 }
 
 
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "token_flash_file.h"
+
+/* Sectors A and B sit back to back at the start of the file */
+#define TOKEN_FILE_SECTORS  2
+
+static int TokenFlashFileRead(void *ctx, uint32_t addr, void *buf, uint32_t len)
+{
+    TokenFlashFile *ff = (TokenFlashFile *)ctx;
+
+    ff->reads++;
+    if (fseek(ff->file, (long)addr, SEEK_SET) != 0 || fread(buf, 1, len, ff->file) != len) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int TokenFlashFileWrite(void *ctx, uint32_t addr, const void *buf, uint32_t len)
+{
+    TokenFlashFile *ff = (TokenFlashFile *)ctx;
+    const uint8_t *src = (const uint8_t *)buf;
+    uint8_t cells[256];
+    int ret = 0;
+
+    ff->writes++;
+    if (len > ff->budget) {
+        len = ff->budget;
+        ret = -1;
+    }
+    if (ff->budget != UINT32_MAX) {
+        ff->budget -= len;
+    }
+
+    /* Programming only clears bits: read, AND, write back */
+    for (uint32_t off = 0; off < len; off += sizeof(cells)) {
+        uint32_t n = len - off;
+        if (n > sizeof(cells)) {
+            n = sizeof(cells);
+        }
+        if (fseek(ff->file, (long)(addr + off), SEEK_SET) != 0 || fread(cells, 1, n, ff->file) != n) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            cells[i] &= src[off + i];
+        }
+        if (fseek(ff->file, (long)(addr + off), SEEK_SET) != 0 || fwrite(cells, 1, n, ff->file) != n) {
+            return -1;
+        }
+    }
+    fflush(ff->file);
+
+    return ret;
+}
+
+static int TokenFlashFileErase(void *ctx, uint32_t addr)
+{
+    TokenFlashFile *ff = (TokenFlashFile *)ctx;
+    uint8_t erased[256];
+    uint32_t len = ff->flash.sectorSize;
+    int ret = 0;
+
+    ff->erases++;
+    if (len > ff->budget) {
+        /* Interrupted erase: the start of the sector is erased, the rest keeps its old content */
+        len = ff->budget;
+        ret = -1;
+    }
+    if (ff->budget != UINT32_MAX) {
+        ff->budget -= len;
+    }
+
+    memset(erased, 0xFF, sizeof(erased));
+    addr -= addr % ff->flash.sectorSize;
+    if (fseek(ff->file, (long)addr, SEEK_SET) != 0) {
+        return -1;
+    }
+    for (uint32_t off = 0; off < len; off += sizeof(erased)) {
+        uint32_t n = len - off;
+        if (n > sizeof(erased)) {
+            n = sizeof(erased);
+        }
+        if (fwrite(erased, 1, n, ff->file) != n) {
+            return -1;
+        }
+    }
+    fflush(ff->file);
+
+    return ret;
+}
+
+int TokenFlashFileOpen(TokenFlashFile *ff, const char *path, uint32_t sectorSize)
+{
+    memset(ff, 0, sizeof(TokenFlashFile));
+    ff->flash.read = TokenFlashFileRead;
+    ff->flash.write = TokenFlashFileWrite;
+    ff->flash.erase = TokenFlashFileErase;
+    ff->flash.ctx = ff;
+    ff->flash.sectorSize = sectorSize;
+    ff->flash.sector[0] = 0;
+    ff->flash.sector[1] = sectorSize;
+    ff->budget = UINT32_MAX;
+
+    ff->file = fopen(path, "r+b");
+    if (ff->file != NULL) {
+        return 0;
+    }
+
+    ff->file = fopen(path, "w+b");
+    if (ff->file == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < TOKEN_FILE_SECTORS; i++) {
+        if (TokenFlashFileErase(ff, ff->flash.sector[i]) != 0) {
+            TokenFlashFileClose(ff);
+            return -1;
+        }
+    }
+    ff->erases = 0;
+
+    return 0;
+}
+
+void TokenFlashFileClose(TokenFlashFile *ff)
+{
+    if (ff->file != NULL) {
+        fclose(ff->file);
+        ff->file = NULL;
+    }
+}
+
+void TokenFlashFileSetBudget(TokenFlashFile *ff, uint32_t budget)
+{
+    ff->budget = budget;
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_TOKEN_FLASH_FILE_H
+#define VENDOR_TELINK_COMMON_TOKEN_FLASH_FILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "token_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * File-backed NOR flash stand-in to run the token store on the host, e.g.
+ *
+ *   gcc -I common/token_store -I common/token_store/host common/token_store/token_store.c \
+ *       common/token_store/host/token_flash_file.c my_test.c
+ *
+ * Like NOR flash, erase sets a sector to 0xFF and programming can only clear bits. A power
+ * loss is simulated by a byte budget shared by erase and programming, an erase costs a byte
+ * per byte of the sector: once it is used up, the erase or write stops in the middle and the
+ * call fails.
+ */
+typedef struct {
+    TokenFlash flash;
+    FILE *file;
+    uint32_t budget;    /* bytes that may still be erased or programmed, UINT32_MAX for no limit */
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t erases;
+} TokenFlashFile;
+
+/**
+ * @brief      Open or create the backing file, a new file starts erased
+ * @param[out] ff          flash stand-in, ff->flash is passed to TokenStoreInit()
+ * @param[in]  path        backing file
+ * @param[in]  sectorSize  sector size in bytes
+ * @return     0 on success, -1 on a file error
+ */
+int TokenFlashFileOpen(TokenFlashFile *ff, const char *path, uint32_t sectorSize);
+
+/**
+ * @brief      Close the backing file
+ * @param[in]  ff  flash stand-in
+ * @return     none
+ */
+void TokenFlashFileClose(TokenFlashFile *ff);
+
+/**
+ * @brief      Simulate a power loss after the given number of erased and programmed bytes
+ * @param[in]  ff      flash stand-in
+ * @param[in]  budget  bytes, UINT32_MAX to disable
+ * @return     none
+ */
+void TokenFlashFileSetBudget(TokenFlashFile *ff, uint32_t budget);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_TOKEN_FLASH_FILE_H */
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+
+#include <drivers.h>
+
+#include "token_flash_b91.h"
+
+#define TOKEN_FLASH_SECTOR_SIZE 0x1000
+
+/*
+ * The image header of the B91 holds the image size at this offset, the ROM boot loader and OTA rely on it.
+ * Sectors below the end of the image would be erased under the running firmware.
+ */
+#define TOKEN_FLASH_IMAGE_SIZE_OFFSET   0x18
+
+/* MAC address, RF calibration and two SMP pairing sectors of the BLE SDK at the top of flash */
+#define TOKEN_FLASH_SDK_SECTORS 4
+
+_Static_assert((TELINK_TOKEN_FLASH_ADDR_A) % TOKEN_FLASH_SECTOR_SIZE == 0, "token sector A is not sector aligned");
+_Static_assert((TELINK_TOKEN_FLASH_ADDR_B) % TOKEN_FLASH_SECTOR_SIZE == 0, "token sector B is not sector aligned");
+_Static_assert((TELINK_TOKEN_FLASH_ADDR_A) != (TELINK_TOKEN_FLASH_ADDR_B), "token sectors A and B must differ");
+
+/* The driver splits page writes itself and keeps interrupts off while the flash is busy */
+static int TokenFlashB91Read(void *ctx, uint32_t addr, void *buf, uint32_t len)
+{
+    (void)ctx;
+
+    flash_read_page(addr, len, (unsigned char *)buf);
+
+    return 0;
+}
+
+static int TokenFlashB91Write(void *ctx, uint32_t addr, const void *buf, uint32_t len)
+{
+    (void)ctx;
+
+    flash_write_page(addr, len, (unsigned char *)buf);
+
+    return 0;
+}
+
+static int TokenFlashB91Erase(void *ctx, uint32_t addr)
+{
+    (void)ctx;
+
+    flash_erase_sector(addr);
+
+    return 0;
+}
+
+/**
+ * @brief      Check a sector against the layout the running device reports: the image size from the
+ *             image header and the flash size from the JEDEC capacity code of the flash ID
+ */
+static int TokenFlashB91SectorOk(uint32_t addr)
+{
+    uint32_t imageSize = 0;
+
+    flash_read_page(TOKEN_FLASH_IMAGE_SIZE_OFFSET, sizeof(imageSize), (unsigned char *)&imageSize);
+    uint32_t flashSize = 1u << ((flash_read_mid() >> 16) & 0x1f);
+
+    if (addr % TOKEN_FLASH_SECTOR_SIZE != 0 || addr < imageSize ||
+        addr + TOKEN_FLASH_SECTOR_SIZE > flashSize - TOKEN_FLASH_SDK_SECTORS * TOKEN_FLASH_SECTOR_SIZE) {
+        return 0;
+    }
+
+    return 1;
+}
+
+int TokenFlashB91Init(TokenFlash *flash, uint32_t sectorA, uint32_t sectorB)
+{
+    if (flash == NULL || sectorA == sectorB || !TokenFlashB91SectorOk(sectorA) || !TokenFlashB91SectorOk(sectorB)) {
+        return -1;
+    }
+
+    flash->read = TokenFlashB91Read;
+    flash->write = TokenFlashB91Write;
+    flash->erase = TokenFlashB91Erase;
+    flash->ctx = NULL;
+    flash->sectorSize = TOKEN_FLASH_SECTOR_SIZE;
+    flash->sector[0] = sectorA;
+    flash->sector[1] = sectorB;
+
+    return 0;
+}
+
+const TokenFlash *TokenFlashB91(void)
+{
+    static TokenFlash flash;
+    static int8_t state;    /* 0 unchecked, 1 usable, -1 rejected */
+
+    if (state == 0) {
+        state = (TokenFlashB91Init(&flash, TELINK_TOKEN_FLASH_ADDR_A, TELINK_TOKEN_FLASH_ADDR_B) == 0) ? 1 : -1;
+    }
+
+    return (state > 0) ? &flash : NULL;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_TOKEN_FLASH_B91_H
+#define VENDOR_TELINK_COMMON_TOKEN_FLASH_B91_H
+
+#include "token_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief      Internal flash of the B91, sectors set by telink_token_flash_addr_a/b
+ * @return     flash access for TokenStoreInit(), NULL if the sectors fail TokenFlashB91Init()
+ */
+const TokenFlash *TokenFlashB91(void);
+
+/**
+ * @brief      Internal flash of the B91 on other sectors, e.g. a scratch store for tests and benches.
+ *             The sectors must be sector aligned, distinct, behind the firmware image and clear of
+ *             the sectors the BLE SDK keeps at the top of flash.
+ * @param[out] flash    flash access for TokenStoreInit()
+ * @param[in]  sectorA  address of sector A
+ * @param[in]  sectorB  address of sector B
+ * @return     0 on success, -1 if a sector violates the flash layout
+ */
+int TokenFlashB91Init(TokenFlash *flash, uint32_t sectorA, uint32_t sectorB);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_TOKEN_FLASH_B91_H */
@@ -0,0 +1,232 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "token_store.h"
+
+/* Magic and CRC are programmed last and excluded from the CRC */
+#define TOKEN_RECORD_HEAD   offsetof(TokenRecord, seq)
+
+/* Chunk used to verify a record after programming */
+#define TOKEN_VERIFY_CHUNK  32
+
+#define TOKEN_SLOT_SIZE(name, size)     [TOKEN_SLOT_##name] = (size),
+#define TOKEN_SLOT_OFFSET(name, size)   [TOKEN_SLOT_##name] = offsetof(TokenRecord, data_##name),
+
+static const uint16_t g_slotSize[TOKEN_SLOT_COUNT] = {
+    TOKEN_SLOT_TABLE(TOKEN_SLOT_SIZE)
+};
+
+static const uint16_t g_slotOffset[TOKEN_SLOT_COUNT] = {
+    TOKEN_SLOT_TABLE(TOKEN_SLOT_OFFSET)
+};
+
+/**
+ * @brief      CRC-32 (IEEE 802.3, reflected), nibble table to keep the flash footprint small
+ */
+static uint32_t TokenCrc32(const uint8_t *data, uint32_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (uint32_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+
+    return ~crc;
+}
+
+static uint32_t TokenRecordCrc(const TokenRecord *rec)
+{
+    return TokenCrc32((const uint8_t *)rec + TOKEN_RECORD_HEAD, sizeof(TokenRecord) - TOKEN_RECORD_HEAD);
+}
+
+static int TokenRecordValid(const TokenRecord *rec)
+{
+    if (rec->magic != TOKEN_STORE_MAGIC || rec->size != sizeof(TokenRecord)) {
+        return 0;
+    }
+
+    for (int i = 0; i < TOKEN_SLOT_COUNT; i++) {
+        if (rec->len[i] > g_slotSize[i]) {
+            return 0;
+        }
+    }
+
+    return rec->crc == TokenRecordCrc(rec);
+}
+
+/**
+ * @brief      Pick the valid record with the newest sequence number, wrap-around aware
+ */
+static void TokenStoreLoad(TokenStore *store)
+{
+    const TokenFlash *flash = store->flash;
+    TokenRecord rec;
+
+    store->active = -1;
+    for (int8_t i = 0; i < 2; i++) {
+        if (flash->read(flash->ctx, flash->sector[i], &rec, sizeof(rec)) != 0 || !TokenRecordValid(&rec)) {
+            continue;
+        }
+        if (store->active >= 0 && (int32_t)(rec.seq - store->cache.seq) <= 0) {
+            continue;
+        }
+        memcpy(&store->cache, &rec, sizeof(rec));
+        store->active = i;
+    }
+
+    if (store->active < 0) {
+        memset(&store->cache, 0, sizeof(TokenRecord));
+    }
+    store->loaded = 1;
+}
+
+static int TokenStoreVerify(const TokenStore *store, uint32_t addr)
+{
+    const TokenFlash *flash = store->flash;
+    const uint8_t *expected = (const uint8_t *)&store->cache;
+    uint8_t chunk[TOKEN_VERIFY_CHUNK];
+
+    for (uint32_t off = 0; off < sizeof(TokenRecord); off += sizeof(chunk)) {
+        uint32_t n = sizeof(TokenRecord) - off;
+        if (n > sizeof(chunk)) {
+            n = sizeof(chunk);
+        }
+        if (flash->read(flash->ctx, addr + off, chunk, n) != 0 || memcmp(chunk, expected + off, n) != 0) {
+            return TOKEN_STORE_ERR_FLASH;
+        }
+    }
+
+    return TOKEN_STORE_OK;
+}
+
+/**
+ * @brief      Program the cached record into the inactive sector: body first, magic and CRC last
+ */
+static int TokenStoreCommit(TokenStore *store)
+{
+    const TokenFlash *flash = store->flash;
+    TokenRecord *rec = &store->cache;
+    int8_t target = (store->active == 0) ? 1 : 0;
+    uint32_t addr = flash->sector[target];
+
+    rec->magic = TOKEN_STORE_MAGIC;
+    /* 0 stays reserved for "no record" */
+    if (++rec->seq == 0) {
+        rec->seq = 1;
+    }
+    rec->size = sizeof(TokenRecord);
+    rec->crc = TokenRecordCrc(rec);
+
+    if (flash->erase(flash->ctx, addr) != 0 ||
+        flash->write(flash->ctx, addr + TOKEN_RECORD_HEAD, (const uint8_t *)rec + TOKEN_RECORD_HEAD,
+                     sizeof(TokenRecord) - TOKEN_RECORD_HEAD) != 0 ||
+        flash->write(flash->ctx, addr, rec, TOKEN_RECORD_HEAD) != 0) {
+        return TOKEN_STORE_ERR_FLASH;
+    }
+
+    if (TokenStoreVerify(store, addr) != TOKEN_STORE_OK) {
+        return TOKEN_STORE_ERR_FLASH;
+    }
+
+    store->active = target;
+
+    return TOKEN_STORE_OK;
+}
+
+int TokenStoreInit(TokenStore *store, const TokenFlash *flash)
+{
+    if (store == NULL || flash == NULL || flash->sectorSize < sizeof(TokenRecord)) {
+        return TOKEN_STORE_ERR_PARAM;
+    }
+
+    memset(store, 0, sizeof(TokenStore));
+    store->flash = flash;
+    store->active = -1;
+
+    return TOKEN_STORE_OK;
+}
+
+int TokenStoreRead(TokenStore *store, TokenSlot slot, void *buf, uint32_t len)
+{
+    if (store == NULL || store->flash == NULL || buf == NULL || (unsigned)slot >= TOKEN_SLOT_COUNT ||
+        len > g_slotSize[slot]) {
+        return TOKEN_STORE_ERR_PARAM;
+    }
+
+    if (!store->loaded) {
+        TokenStoreLoad(store);
+    }
+
+    uint32_t stored = store->cache.len[slot];
+    if (stored == 0) {
+        return TOKEN_STORE_ERR_EMPTY;
+    }
+    if (stored > len) {
+        stored = len;
+    }
+
+    memcpy(buf, (const uint8_t *)&store->cache + g_slotOffset[slot], stored);
+    memset((uint8_t *)buf + stored, 0, len - stored);
+
+    return TOKEN_STORE_OK;
+}
+
+int TokenStoreWrite(TokenStore *store, TokenSlot slot, const void *buf, uint32_t len)
+{
+    if (store == NULL || store->flash == NULL || buf == NULL || (unsigned)slot >= TOKEN_SLOT_COUNT ||
+        len == 0 || len > g_slotSize[slot]) {
+        return TOKEN_STORE_ERR_PARAM;
+    }
+
+    if (!store->loaded) {
+        TokenStoreLoad(store);
+    }
+
+    uint8_t *data = (uint8_t *)&store->cache + g_slotOffset[slot];
+    memcpy(data, buf, len);
+    memset(data + len, 0, g_slotSize[slot] - len);
+    store->cache.len[slot] = (uint16_t)len;
+
+    int ret = TokenStoreCommit(store);
+    if (ret != TOKEN_STORE_OK) {
+        /* The RAM copy no longer matches flash, reload the surviving record on the next access */
+        store->loaded = 0;
+    }
+
+    return ret;
+}
+
+void TokenStoreInvalidate(TokenStore *store)
+{
+    if (store != NULL) {
+        store->loaded = 0;
+    }
+}
+
+uint32_t TokenStoreSeq(const TokenStore *store)
+{
+    return (store != NULL && store->loaded) ? store->cache.seq : 0;
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_TOKEN_STORE_H
+#define VENDOR_TELINK_COMMON_TOKEN_STORE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Token store.
+ *
+ * All slots are kept in one record that is written alternately to two flash sectors (A/B).
+ * A record carries a sequence number and a CRC-32 over everything but its first 8 bytes
+ * (magic and CRC), which are programmed last. A write never touches the sector of the current
+ * record, so a power loss during a write leaves the previous record intact, and loading picks
+ * the valid record with the newest sequence number. After the first load every read is served
+ * from the RAM copy.
+ *
+ * The store uses no kernel or driver API, flash access goes through TokenFlash, so it builds
+ * and runs on the host as well (see host/token_flash_file.h). It is not thread safe.
+ */
+
+/* Slot name and capacity in bytes */
+#define TOKEN_SLOT_TABLE(X) \
+    X(TOKEN, 151) \
+    X(AC_KEY, 48) \
+    X(PROD_ID, 16) \
+    X(PROD_KEY, 48)
+
+#define TOKEN_SLOT_ENUM(name, size)     TOKEN_SLOT_##name,
+
+typedef enum {
+    TOKEN_SLOT_TABLE(TOKEN_SLOT_ENUM)
+    TOKEN_SLOT_COUNT,
+} TokenSlot;
+
+#define TOKEN_STORE_OK          0
+#define TOKEN_STORE_ERR_PARAM   (-1)
+#define TOKEN_STORE_ERR_EMPTY   (-2)    /* slot never written */
+#define TOKEN_STORE_ERR_FLASH   (-3)
+
+#define TOKEN_STORE_MAGIC       0x314B5454  /* "TTK1" */
+
+/**
+ *  @brief  Flash access, all functions return 0 on success
+ */
+typedef struct {
+    int (*read)(void *ctx, uint32_t addr, void *buf, uint32_t len);
+    int (*write)(void *ctx, uint32_t addr, const void *buf, uint32_t len); /* only clears bits */
+    int (*erase)(void *ctx, uint32_t addr);                                /* one sector */
+    void *ctx;
+    uint32_t sectorSize;
+    uint32_t sector[2];     /* addresses of the A and B sectors */
+} TokenFlash;
+
+#define TOKEN_SLOT_FIELD(name, size)    uint8_t data_##name[size];
+
+/**
+ *  @brief  Record as stored in flash (little endian, packed)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t crc;
+    uint32_t seq;
+    uint16_t size;                      /* sizeof(TokenRecord), rejects records of another layout */
+    uint16_t len[TOKEN_SLOT_COUNT];     /* bytes written to each slot, 0 if never written */
+    TOKEN_SLOT_TABLE(TOKEN_SLOT_FIELD)
+} TokenRecord;
+
+typedef struct {
+    const TokenFlash *flash;
+    TokenRecord cache;
+    int8_t active;      /* sector of the current record, -1 if flash holds none */
+    uint8_t loaded;
+} TokenStore;
+
+/**
+ * @brief      Initialize the store, flash is not accessed until the first read or write
+ * @param[in]  store  store
+ * @param[in]  flash  flash access, must outlive the store
+ * @return     TOKEN_STORE_OK, TOKEN_STORE_ERR_PARAM if a record does not fit in a sector
+ */
+int TokenStoreInit(TokenStore *store, const TokenFlash *flash);
+
+/**
+ * @brief      Read a slot, loads the newest valid record on the first call
+ * @param[in]  store  store
+ * @param[in]  slot   slot
+ * @param[out] buf    value, zero padded if len exceeds the written length
+ * @param[in]  len    size of buf, at most the slot capacity
+ * @return     TOKEN_STORE_OK or a negative TOKEN_STORE_ERR_* code
+ */
+int TokenStoreRead(TokenStore *store, TokenSlot slot, void *buf, uint32_t len);
+
+/**
+ * @brief      Write a slot, the whole record goes to the sector not holding the current one
+ * @param[in]  store  store
+ * @param[in]  slot   slot
+ * @param[in]  buf    value
+ * @param[in]  len    length of the value, at most the slot capacity
+ * @return     TOKEN_STORE_OK or a negative TOKEN_STORE_ERR_* code
+ */
+int TokenStoreWrite(TokenStore *store, TokenSlot slot, const void *buf, uint32_t len);
+
+/**
+ * @brief      Drop the RAM copy, the next access reloads it from flash
+ * @param[in]  store  store
+ * @return     none
+ */
+void TokenStoreInvalidate(TokenStore *store);
+
+/**
+ * @brief      Sequence number of the current record
+ * @param[in]  store  store
+ * @return     sequence number, 0 if no record was loaded or written yet
+ */
+uint32_t TokenStoreSeq(const TokenStore *store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_TOKEN_STORE_H */
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+# All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Decode deferred binary log lines (common/bin_log) back into text.
+
+The firmware prints "BLOG <ts> <id> [<arg>...]" lines. The format string of each ID
+comes from the message catalog header the firmware was built with: the X(name) entries
+give the IDs in order, the "#define name_FMT" literals their format strings.
+
+    python3 bin_log_decode.py --catalog ../../led_demo/led_demo/app_log.h uart.log
+
+Other lines of the log are passed through unchanged, so the output reads like the
+plain printf console. Arguments are 32-bit integers, %s and floating point
+conversions are not supported and print the raw value. Only the standard library is used.
+"""
+
+import argparse
+import re
+import sys
+
+CATALOG_ENTRY = re.compile(r"\bX\(\s*(\w+)\s*\)")
+FORMAT_DEFINE = re.compile(r"^\s*#define\s+(\w+)_FMT\s+((?:\"(?:[^\"\\]|\\.)*\"\s*)+)", re.MULTILINE)
+STRING_PART = re.compile(r"\"((?:[^\"\\]|\\.)*)\"")
+BEGIN_LINE = re.compile(r"BLOG BEGIN (\d+)")
+DROP_LINE = re.compile(r"BLOG DROP (\d+)")
+RECORD_LINE = re.compile(r"BLOG ([0-9a-fA-F]{8}) ([0-9a-fA-F]{4})((?: [0-9a-fA-F]{1,8})*)\s*$")
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|j|z|t)?([diouxXcsp%])")
+
+TIMESTAMP_WRAP = 1 << 32
+ESCAPES = {"n": "\n", "r": "", "t": "\t", "\\": "\\", "\"": "\""}
+
+
+def unescape(text):
+    return re.sub(r"\\(.)", lambda m: ESCAPES.get(m.group(1), m.group(1)), text)
+
+
+def load_catalog(path):
+    """Map message ID to format string, IDs count up from 0 in catalog order like the BIN_LOG_ENUM enum."""
+    with open(path) as f:
+        text = f.read()
+    formats = {name: unescape("".join(STRING_PART.findall(literal))).rstrip("\n")
+               for name, literal in FORMAT_DEFINE.findall(text)}
+    catalog = {}
+    for index, name in enumerate(CATALOG_ENTRY.findall(text)):
+        catalog[index] = (name, formats.get(name, ""))
+    return catalog
+
+
+def signed(value):
+    return value - TIMESTAMP_WRAP if value & 0x80000000 else value
+
+
+def render(fmt, args):
+    """printf with the raw 32-bit arguments, one argument per conversion."""
+    pending = list(args)
+
+    def convert(match):
+        flags, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+        value = pending.pop(0) if pending else 0
+        if conv in "di":
+            return ("%" + flags + "d") % signed(value)
+        if conv == "u":
+            return ("%" + flags + "d") % value
+        if conv == "c":
+            return chr(value & 0xff)
+        if conv in "sp":
+            return "0x%08x" % value
+        return ("%" + flags + conv) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(lines, catalog, out):
+    ticks_per_us = 0
+    start = None
+    for line in lines:
+        begin = BEGIN_LINE.search(line)
+        if begin:
+            ticks_per_us = int(begin.group(1))
+            start = None
+            continue
+        drop = DROP_LINE.search(line)
+        if drop:
+            out.write("[bin_log: %s messages dropped]\n" % drop.group(1))
+            continue
+        record = RECORD_LINE.search(line)
+        if not record:
+            out.write(line)
+            continue
+
+        timestamp = int(record.group(1), 16)
+        msg_id = int(record.group(2), 16)
+        args = [int(arg, 16) for arg in record.group(3).split()]
+        name, fmt = catalog.get(msg_id, ("ID_%d" % msg_id, " ".join(["%x"] * len(args))))
+
+        if start is None:
+            start = timestamp
+        if ticks_per_us:
+            stamp = "%12.1f us" % (((timestamp - start) % TIMESTAMP_WRAP) / ticks_per_us)
+        else:
+            stamp = "%08x" % timestamp
+        out.write("[%s] %s: %s\n" % (stamp, name, render(fmt, args)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", nargs="?", help="UART log, stdin if omitted")
+    parser.add_argument("--catalog", required=True, help="header with the X(name) message catalog")
+    args = parser.parse_args()
+
+    catalog = load_catalog(args.catalog)
+    if not catalog:
+        sys.exit("no X(name) entries in " + args.catalog)
+
+    with (open(args.log, errors="replace") if args.log else sys.stdin) as f:
+        decode(f, catalog, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
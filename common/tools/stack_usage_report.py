@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+# All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Static stack usage report from GCC -fstack-usage / -fcallgraph-info output.
+
+Build with telink_stack_usage_enable = true. GCC then writes a .su file with the
+frame size of every function, and a .ci call graph next to each object file. Run:
+
+    python3 stack_usage_report.py out/<board>/<product>
+
+The largest frames are listed first. With .ci files present, the worst case stack
+depth is also computed for every task entry function, by default the functions
+whose name ends in "Task". Calls into code built without the flags, such as the
+kernel or libc, and indirect calls have unknown cost. Recursion cannot be bounded.
+Both are flagged on the result, so treat it as a lower bound and compare it with
+the run-time watermark. Only the standard library is used.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SU_LINE = re.compile(r"^(.*):(\d+):(\d+):(\S+)\t(\d+)\t(\S+)$")
+CI_NODE = re.compile(r"node:\s*\{\s*title:\s*\"([^\"]+)\"\s*label:\s*\"([^\"]*)\"")
+CI_EDGE = re.compile(r"edge:\s*\{\s*sourcename:\s*\"([^\"]+)\"\s*targetname:\s*\"([^\"]+)\"")
+CI_FRAME = re.compile(r"(\d+) bytes \(([\w,]+)\)")
+
+
+def find_files(root, suffix):
+    for base, _, files in os.walk(root):
+        for name in files:
+            if name.endswith(suffix):
+                yield os.path.join(base, name)
+
+
+def load_su(root):
+    """List of (bytes, qualifier, function, location) from all .su files."""
+    frames = []
+    for path in find_files(root, ".su"):
+        with open(path, errors="replace") as f:
+            for line in f:
+                match = SU_LINE.match(line.rstrip("\n"))
+                if match:
+                    src, row, _, func, size, qualifier = match.groups()
+                    frames.append((int(size), qualifier, func, "%s:%s" % (os.path.basename(src), row)))
+    return frames
+
+
+def load_ci(root):
+    """Frame sizes and call edges from all .ci files, None if there are none."""
+    frames = {}
+    calls = {}
+    found = False
+    for path in find_files(root, ".ci"):
+        found = True
+        with open(path, errors="replace") as f:
+            text = f.read()
+        for title, label in CI_NODE.findall(text):
+            frame = CI_FRAME.search(label)
+            if frame:
+                frames[title] = (int(frame.group(1)), frame.group(2))
+            else:
+                frames.setdefault(title, None)
+        for source, target in CI_EDGE.findall(text):
+            calls.setdefault(source, set()).add(target)
+    return (frames, calls) if found else None
+
+
+def worst_depth(func, frames, calls, memo, stack):
+    """(bytes, path, flags) of the deepest call chain from func."""
+    if func in memo:
+        return memo[func]
+    if func in stack:
+        return 0, [func], {"recursion"}
+
+    frame = frames.get(func)
+    if frame is None:
+        return 0, [func + " (?)"], {"unknown"}
+    size, qualifier = frame
+    flags = set() if qualifier == "static" else {"dynamic"}
+
+    stack.add(func)
+    best = (0, [], set())
+    for callee in sorted(calls.get(func, ())):
+        depth, path, callee_flags = worst_depth(callee, frames, calls, memo, stack)
+        flags |= callee_flags
+        if depth > best[0] or not best[1]:
+            best = (depth, path, callee_flags)
+    stack.discard(func)
+
+    result = (size + best[0], [func] + best[1], flags)
+    memo[func] = result
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("root", help="build output directory to search for .su and .ci files")
+    parser.add_argument("--entry", action="append", help="task entry function, may be repeated")
+    parser.add_argument("--top", type=int, default=20, help="number of largest frames to list")
+    args = parser.parse_args()
+
+    frames = load_su(args.root)
+    if not frames:
+        sys.exit("no .su files under %s, build with telink_stack_usage_enable = true" % args.root)
+
+    print("Largest frames:")
+    for size, qualifier, func, location in sorted(frames, reverse=True)[:args.top]:
+        print("  %6d  %-16s %-40s %s" % (size, qualifier, func, location))
+
+    graph = load_ci(args.root)
+    if graph is None:
+        print("\nNo .ci files, the compiler may not support -fcallgraph-info: no depth analysis")
+        return
+    ci_frames, calls = graph
+
+    entries = args.entry or sorted(name for name in ci_frames if name.endswith("Task"))
+    print("\nWorst case depth per task entry:")
+    memo = {}
+    for entry in entries:
+        if entry not in ci_frames:
+            print("  %-24s not found" % entry)
+            continue
+        depth, path, flags = worst_depth(entry, ci_frames, calls, memo, set())
+        note = " [%s]" % ", ".join(sorted(flags)) if flags else ""
+        print("  %-24s %6d bytes%s" % (entry, depth, note))
+        print("  %-24s %s" % ("", " -> ".join(path)))
+
+
+if __name__ == "__main__":
+    main()
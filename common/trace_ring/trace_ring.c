@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "trace_ring.h"
+
+/* "TRACE BEGIN " + 3 x 10 digits + separators */
+#define TRACE_LINE_MAX 48
+
+int TraceRingInit(TraceRing *ring, TraceRecord *buf, uint32_t capacity)
+{
+    if (ring == NULL || buf == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+
+    ring->buf = buf;
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->enabled = 1;
+
+    return 0;
+}
+
+void TraceRingDump(TraceRing *ring, uint32_t ticksPerUs, TraceRingOutput out, void *ctx)
+{
+    char line[TRACE_LINE_MAX];
+
+    ring->enabled = 0;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    uint32_t head = ring->head;
+    uint32_t capacity = ring->mask + 1;
+    uint32_t count = (head < capacity) ? head : capacity;
+
+    (void)snprintf(line, sizeof(line), "TRACE BEGIN %u %u %u", (unsigned)ticksPerUs, (unsigned)count,
+                   (unsigned)(head - count));
+    out(line, ctx);
+
+    for (uint32_t i = head - count; i != head; i++) {
+        const TraceRecord *rec = &ring->buf[i & ring->mask];
+        (void)snprintf(line, sizeof(line), "TRACE %08x %04x %04x", (unsigned)rec->timestamp, (unsigned)rec->id,
+                       (unsigned)rec->arg);
+        out(line, ctx);
+    }
+
+    out("TRACE END", ctx);
+
+    ring->head = 0;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    ring->enabled = 1;
+}
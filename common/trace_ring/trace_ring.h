@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_TELINK_COMMON_TRACE_RING_H
+#define VENDOR_TELINK_COMMON_TRACE_RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  @brief  One trace record: timestamp in timer ticks, event ID and a free 16-bit argument
+ */
+typedef struct {
+    uint32_t timestamp;
+    uint16_t id;
+    uint16_t arg;
+} TraceRecord;
+
+/**
+ *  @brief  Circular trace buffer that keeps the most recent records.
+ *          Any number of writers, including interrupt handlers, may call TraceRingWrite() concurrently:
+ *          each write claims its slot with one atomic increment of head and never blocks.
+ */
+typedef struct {
+    TraceRecord *buf;
+    uint32_t mask;
+    volatile uint32_t head;
+    volatile uint8_t enabled;
+} TraceRing;
+
+/**
+ * @brief      Line sink of TraceRingDump()
+ * @param[in]  line  NUL terminated line without line break
+ * @param[in]  ctx   context passed to TraceRingDump()
+ * @return     none
+ */
+typedef void (*TraceRingOutput)(const char *line, void *ctx);
+
+/**
+ * @brief      Initialize the ring over a caller provided buffer and start recording
+ * @param[in]  ring      ring descriptor
+ * @param[in]  buf       storage of capacity records
+ * @param[in]  capacity  number of records, must be a power of two
+ * @return     0 on success, -1 on invalid parameters
+ */
+int TraceRingInit(TraceRing *ring, TraceRecord *buf, uint32_t capacity);
+
+/**
+ * @brief      Append a record, overwriting the oldest one when the ring is full. Inline so it can be
+ *             used from RAM code interrupt handlers.
+ * @param[in]  ring       ring descriptor
+ * @param[in]  timestamp  current timer tick
+ * @param[in]  id         event ID
+ * @param[in]  arg        event argument
+ * @return     none
+ */
+static inline void TraceRingWrite(TraceRing *ring, uint32_t timestamp, uint16_t id, uint16_t arg)
+{
+    if (!ring->enabled) {
+        return;
+    }
+
+    uint32_t slot = __atomic_fetch_add(&ring->head, 1, __ATOMIC_RELAXED) & ring->mask;
+    ring->buf[slot].timestamp = timestamp;
+    ring->buf[slot].id = id;
+    ring->buf[slot].arg = arg;
+}
+
+/**
+ * @brief      Write the ring, oldest record first, as text lines that tools/trace_decode.py understands:
+ *             "TRACE BEGIN <ticksPerUs> <records> <overwritten>", one "TRACE <ts> <id> <arg>" line per
+ *             record in hex, then "TRACE END". Recording is paused during the dump and the ring is
+ *             cleared afterwards.
+ * @param[in]  ring        ring descriptor
+ * @param[in]  ticksPerUs  timer ticks per microsecond, for the decoder
+ * @param[in]  out         line sink
+ * @param[in]  ctx         passed to out
+ * @return     none
+ */
+void TraceRingDump(TraceRing *ring, uint32_t ticksPerUs, TraceRingOutput out, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VENDOR_TELINK_COMMON_TRACE_RING_H */
@@ -19,9 +19,9 @@
 #include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
-#include <time.h>
 
 #include <los_task.h>
+#include <los_tick.h>
 #include <los_arch_interrupt.h>
 
 #include <ohos_init.h>
@@ -32,41 +32,103 @@
 
 #include <board_config.h>
 
+#include "app_log.h"
+#include "cycle_prof.h"
+#include "stack_wm.h"
+#if TELINK_GPIO_IRQ_SAMPLE_ENABLE
+#include "gpio_evt.h"
+#endif /* TELINK_GPIO_IRQ_SAMPLE_ENABLE */
+#if TELINK_LED_PATTERN_ENABLE
+#include "led_pattern.h"
+#else
+#include "gpio_fast.h"
+#endif /* TELINK_LED_PATTERN_ENABLE */
+
 #define LED_TASK_PRIORITY LOSCFG_BASE_CORE_TSK_DEFAULT_PRIO
 #define PROTO_TASK_PRIORITY (OS_TASK_PRIORITY_LOWEST-1)
 
 #define DELAY 1000
 
+/* HelloWorldTask prints the LED update jitter every this many lines */
+#define JITTER_REPORT_LINES 10
+
+#if TELINK_STACK_REPORT_ENABLE
+#define STACK_REPORT_LINES  ((TELINK_STACK_REPORT_MS + DELAY - 1) / DELAY)
+#endif /* TELINK_STACK_REPORT_ENABLE */
+
+/* Cycles between LED updates DELAY apart, from the timer callback or from LedTask */
+static CycleProfPoint g_ledInterval = {.name = "led_interval"};
+
+#if TELINK_LED_PATTERN_ENABLE
+/* Resolution of blink and of the breathe ramp, the breathe PWM runs the pattern timer at the kernel tick */
+#define LED_PATTERN_TICK_MS 10
+
+static const LedPatternDesc g_ledPatterns[] = {
+    {.hdfIndex = LED_BLUE_HDF, .type = LED_PATTERN_BLINK, .periodMs = 2 * DELAY, .onMs = DELAY},
+    {.hdfIndex = LED_WHITE_HDF, .type = LED_PATTERN_BREATHE, .periodMs = 3000},
+};
+
+static LedPatternLed g_leds[sizeof(g_ledPatterns) / sizeof(g_ledPatterns[0])];
+#endif /* TELINK_LED_PATTERN_ENABLE */
+
+static void LedReportJitter(void)
+{
+    APP_LOG(APP_LOG_LED_JITTER, (unsigned)g_ledInterval.min, (unsigned)CycleProfAvg(&g_ledInterval),
+            (unsigned)g_ledInterval.max, (unsigned)(g_ledInterval.max - g_ledInterval.min));
+    CycleProfReset(&g_ledInterval);
+}
+
 STATIC VOID HelloWorldTask(VOID)
 {
-    while (1) {
-        time_t t = time(NULL);
-        printf("Hello World, time: %lld\r\n", (long long)t);
+    for (int line = 1;; line++) {
+        APP_LOG(APP_LOG_HELLO, (unsigned)(LOS_TickCountGet() / LOSCFG_BASE_CORE_TICK_PER_SECOND));
+        if (line % JITTER_REPORT_LINES == 0) {
+            LedReportJitter();
+        }
+#if TELINK_STACK_REPORT_ENABLE
+        if (line % STACK_REPORT_LINES == 0) {
+            StackWmReport(BinLogPrintLine, NULL);
+        }
+#endif /* TELINK_STACK_REPORT_ENABLE */
         LOS_TaskDelay(DELAY);
     }
 }
 
+#if !TELINK_LED_PATTERN_ENABLE
+/* One task per LED, kept to compare RAM and jitter against the pattern engine */
 STATIC VOID LedTask(VOID)
 {
+    GpioFast led;
+    UINT32 last = 0;
+    UINT16 level = GPIO_VAL_HIGH;
+
     GpioSetDir(LED_BLUE_HDF, GPIO_DIR_OUT);
+    GpioFastInit(&led, LED_BLUE_HDF);
 
     while (1) {
-        GpioWrite(LED_BLUE_HDF, GPIO_VAL_HIGH);
-        LOS_Msleep(DELAY);
-
-        GpioWrite(LED_BLUE_HDF, GPIO_VAL_LOW);
+        /* Sampled on every update, at the period the pattern engine probe uses */
+        UINT32 now = CycleProfNow();
+        if (last != 0) {
+            CycleProfRecord(&g_ledInterval, now - last);
+        }
+        last = now;
+
+        GpioFastWrite(&led, level);
+        level = (level == GPIO_VAL_HIGH) ? GPIO_VAL_LOW : GPIO_VAL_HIGH;
         LOS_Msleep(DELAY);
     }
 }
+#endif /* !TELINK_LED_PATTERN_ENABLE */
 
 #if TELINK_GPIO_IRQ_SAMPLE_ENABLE
-_attribute_ram_code_ int32_t gpio_handler(uint16_t gpio, void *data)
-{
-    UNUSED(gpio);
-    UNUSED(data);
-    printf("=== %s:%d\r\n", __func__, __LINE__);
+#define GPIO_EVT_TASK_PRIORITY LOSCFG_BASE_CORE_TSK_DEFAULT_PRIO
+#define BUTTON_DEBOUNCE_MS     20
 
-    return 0;
+/* Runs in GpioEvtTask with the debounced level, the interrupt handler only records the edge */
+static void ButtonHandler(const GpioEvt *evt, void *ctx)
+{
+    UNUSED(ctx);
+    APP_LOG(APP_LOG_GPIO_EVT, (unsigned)evt->hdfIndex, (unsigned)evt->level, (unsigned)evt->timestamp);
 }
 #endif /* TELINK_GPIO_IRQ_SAMPLE_ENABLE */
 
@@ -75,9 +137,12 @@ void AppMain(void)
     UINT32 ret;
     UINT32 taskId = 0;
     TSK_INIT_PARAM_S taskParam = {0};
+
+    AppLogInit();
+
     taskParam.pfnTaskEntry = (TSK_ENTRY_FUNC)HelloWorldTask;
     taskParam.uwArg = 0;
-    taskParam.uwStackSize = LOSCFG_BASE_CORE_TSK_DEFAULT_STACK_SIZE;
+    taskParam.uwStackSize = STACK_WM_SIZE(TELINK_HELLO_TASK_STACK_SIZE);
     taskParam.pcName = "HelloWorldTask";
     taskParam.usTaskPrio = PROTO_TASK_PRIORITY;
     ret = LOS_TaskCreate(&taskId, &taskParam);
@@ -85,21 +150,44 @@ void AppMain(void)
         HILOG_ERROR(HILOG_MODULE_APP, "ret of LOS_TaskCreate(HelloWorldTask) = %#x", ret);
     }
 
+#if TELINK_LED_PATTERN_ENABLE
+    UINT16 ledCount = sizeof(g_ledPatterns) / sizeof(g_ledPatterns[0]);
+    LedPatternSetProbe(&g_ledInterval, DELAY);
+    ret = LedPatternStart(g_ledPatterns, g_leds, ledCount, LED_PATTERN_TICK_MS);
+    if (ret != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "ret of LedPatternStart() = %#x", ret);
+    }
+    /*
+     * Runs in the existing software timer task, only the state of each LED is added. The timer and task control
+     * blocks come from pools sized at build time, they are not counted on either side.
+     */
+    APP_LOG(APP_LOG_LED_RAM, (unsigned)sizeof(g_leds), (unsigned)ledCount);
+#else
     taskParam.pfnTaskEntry = (TSK_ENTRY_FUNC)LedTask;
+    taskParam.uwStackSize = STACK_WM_SIZE(TELINK_LED_TASK_STACK_SIZE);
     taskParam.pcName = "LedTask";
     ret = LOS_TaskCreate(&taskId, &taskParam);
     if (ret != LOS_OK) {
         HILOG_ERROR(HILOG_MODULE_APP, "ret of LOS_TaskCreate(LedTask) = %#x", ret);
     }
+    APP_LOG(APP_LOG_LED_RAM, (unsigned)taskParam.uwStackSize, 1u);
+#endif /* TELINK_LED_PATTERN_ENABLE */
 
 #if TELINK_GPIO_IRQ_SAMPLE_ENABLE
     GpioSetDir(SW1_2_GPIO_HDF, GPIO_DIR_OUT);
     GpioWrite(SW1_2_GPIO_HDF, GPIO_VAL_HIGH);
 
-    GpioSetDir(SW1_3_GPIO_HDF, GPIO_DIR_IN);
     gpio_set_up_down_res(SW1_3_GPIO, GPIO_PIN_PULLDOWN_100K);
-    GpioSetIrq(SW1_3_GPIO_HDF, GPIO_IRQ_TRIGGER_RISING, gpio_handler, NULL);
-    GpioEnableIrq(SW1_3_GPIO_HDF);
+
+    GpioEvtInit();
+    if (GpioEvtAddPin(SW1_3_GPIO_HDF, BUTTON_DEBOUNCE_MS) != 0) {
+        HILOG_ERROR(HILOG_MODULE_APP, "GpioEvtAddPin(SW1_3_GPIO_HDF) failed");
+    }
+    (void)GpioEvtSubscribe(SW1_3_GPIO_HDF, ButtonHandler, NULL);
+    ret = GpioEvtStart(GPIO_EVT_TASK_PRIORITY, STACK_WM_SIZE(TELINK_GPIO_EVT_TASK_STACK_SIZE));
+    if (ret != LOS_OK) {
+        HILOG_ERROR(HILOG_MODULE_APP, "ret of GpioEvtStart() = %#x", ret);
+    }
 #endif /* TELINK_GPIO_IRQ_SAMPLE_ENABLE */
 }
 
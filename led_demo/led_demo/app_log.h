@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#ifndef VENDOR_LED_DEMO_APP_LOG_H
+#define VENDOR_LED_DEMO_APP_LOG_H
+
+#include <stdio.h>
+
+#include <drivers.h>
+
+#include "bin_log.h"
+
+/**
+ *  @brief  Message catalog of led_demo, decode the deferred output with
+ *          common/tools/bin_log_decode.py --catalog app_log.h. Arguments are 32-bit integers.
+ */
+#define APP_LOG_HELLO_FMT       "Hello World, uptime: %u s\r\n"
+#define APP_LOG_GPIO_EVT_FMT    "gpio %u: level %u at stimer %u\r\n"
+#define APP_LOG_LED_RAM_FMT     "LED RAM: %u bytes for %u LEDs\r\n"
+#define APP_LOG_LED_JITTER_FMT  "led_interval: min %u, avg %u, max %u, jitter %u cycles\r\n"
+
+#define APP_LOG_CATALOG(X)      \
+    X(APP_LOG_HELLO)            \
+    X(APP_LOG_GPIO_EVT)         \
+    X(APP_LOG_LED_RAM)          \
+    X(APP_LOG_LED_JITTER)
+
+typedef enum {
+    APP_LOG_CATALOG(BIN_LOG_ENUM)
+    APP_LOG_COUNT,
+} AppLogId;
+
+#if TELINK_BIN_LOG_ENABLE
+extern BinLog g_appLog;
+
+/* Only the ID and the arguments are recorded, BinLogTask formats and prints them later */
+#define APP_LOG(id, ...)                                                        \
+    do {                                                                        \
+        BIN_LOG_FORMAT_CHECK(id##_FMT, ##__VA_ARGS__);                          \
+        BIN_LOG_WRITE(&g_appLog, stimer_get_tick(), (id), ##__VA_ARGS__);       \
+    } while (0)
+#else
+#define APP_LOG(id, ...)  printf(id##_FMT, ##__VA_ARGS__)
+#endif /* TELINK_BIN_LOG_ENABLE */
+
+/**
+ * @brief      Start the lowest-priority task that drains the log to the UART, nothing without bin_log
+ * @param[in]  none
+ * @return     none
+ */
+void AppLogInit(void);
+
+#endif /* VENDOR_LED_DEMO_APP_LOG_H */
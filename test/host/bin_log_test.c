@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Unit test of common/bin_log: 4 writer threads against one draining consumer. Every message must come out
+ * exactly once and intact, or be counted as dropped.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bin_log.h"
+
+#include "host_test.h"
+
+#define RING_LEN            16
+#define WRITER_THREADS      4
+#define WRITES_PER_THREAD   50000
+#define WRITER_YIELD_EVERY  16
+#define ID_MESSAGE          7
+
+static BinLog g_log;
+static BinLogRecord g_logBuff[RING_LEN];
+
+static struct {
+    uint32_t received[WRITER_THREADS];
+    uint32_t nextSeq[WRITER_THREADS];
+    uint32_t dropped;
+    uint32_t torn;
+    uint32_t reordered;
+    uint32_t lines;
+    char last[BIN_LOG_LINE_MAX];
+} g_sink;
+
+static volatile int g_writersDone;
+
+static void CollectLine(const char *line, void *ctx)
+{
+    unsigned ts;
+    unsigned id;
+    unsigned writer;
+    unsigned seq;
+    unsigned check;
+    unsigned drops;
+
+    (void)ctx;
+
+    g_sink.lines++;
+    (void)snprintf(g_sink.last, sizeof(g_sink.last), "%s", line);
+
+    if (sscanf(line, "BLOG DROP %u", &drops) == 1) {
+        g_sink.dropped += drops;
+        return;
+    }
+    if (sscanf(line, "BLOG %x %x %x %x %x", &ts, &id, &writer, &seq, &check) != 5 || id != ID_MESSAGE ||
+        writer >= WRITER_THREADS || ts != seq || check != (seq ^ 0xa5a5a5a5u)) {
+        g_sink.torn++;
+        return;
+    }
+
+    /* a writer's own messages keep their order, drops only leave gaps */
+    if (seq < g_sink.nextSeq[writer]) {
+        g_sink.reordered++;
+    }
+    g_sink.nextSeq[writer] = seq + 1;
+    g_sink.received[writer]++;
+}
+
+static void *WriterThread(void *arg)
+{
+    uint32_t writer = (uint32_t)(uintptr_t)arg;
+
+    for (uint32_t seq = 0; seq < WRITES_PER_THREAD; seq++) {
+        BIN_LOG_WRITE(&g_log, seq, ID_MESSAGE, writer, seq, seq ^ 0xa5a5a5a5u);
+        /* let the consumer in regularly, also on a single CPU */
+        if ((seq % WRITER_YIELD_EVERY) == 0) {
+            (void)sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *ConsumerThread(void *arg)
+{
+    (void)arg;
+
+    while (!__atomic_load_n(&g_writersDone, __ATOMIC_ACQUIRE)) {
+        if (BinLogDrain(&g_log, CollectLine, NULL, 16) == 0) {
+            (void)sched_yield();
+        }
+    }
+    /* pick up what was written after the last pass */
+    while (BinLogDrain(&g_log, CollectLine, NULL, RING_LEN) != 0) {
+    }
+    (void)BinLogDrain(&g_log, CollectLine, NULL, 0);
+
+    return NULL;
+}
+
+static void TestInit(void)
+{
+    HOST_CHECK_EQ(BinLogInit(&g_log, g_logBuff, 48), -1);
+    HOST_CHECK_EQ(BinLogInit(&g_log, NULL, RING_LEN), -1);
+    HOST_CHECK_EQ(BinLogInit(&g_log, g_logBuff, RING_LEN), 0);
+    HOST_CHECK_EQ(BinLogDrain(&g_log, CollectLine, NULL, RING_LEN), 0);
+}
+
+static void TestFormat(void)
+{
+    memset(&g_sink, 0, sizeof(g_sink));
+    (void)BinLogInit(&g_log, g_logBuff, 4);
+
+    BIN_LOG_WRITE(&g_log, 0x1234, 2);
+    BIN_LOG_WRITE(&g_log, 0xffffffff, 0xabcd, 1, 0xffffffff, 0, 0x10);
+    HOST_CHECK_EQ(BinLogDrain(&g_log, CollectLine, NULL, 1), 1);
+    HOST_CHECK(strcmp(g_sink.last, "BLOG 00001234 0002") == 0);
+    HOST_CHECK_EQ(BinLogDrain(&g_log, CollectLine, NULL, 4), 1);
+    HOST_CHECK(strcmp(g_sink.last, "BLOG ffffffff abcd 1 ffffffff 0 10") == 0);
+
+    /* a full ring drops the newest messages and reports them before the next message */
+    for (int i = 0; i < 6; i++) {
+        BIN_LOG_WRITE(&g_log, i, 1, i);
+    }
+    HOST_CHECK_EQ(BinLogDrain(&g_log, CollectLine, NULL, 1), 1);
+    HOST_CHECK_EQ(g_sink.dropped, 2);
+    HOST_CHECK(strcmp(g_sink.last, "BLOG 00000000 0001 0") == 0);
+    HOST_CHECK_EQ(BinLogDrain(&g_log, CollectLine, NULL, 4), 3);
+    HOST_CHECK(strcmp(g_sink.last, "BLOG 00000003 0001 3") == 0);
+}
+
+static void TestConcurrentWriters(void)
+{
+    pthread_t writers[WRITER_THREADS];
+    pthread_t consumer;
+
+    memset(&g_sink, 0, sizeof(g_sink));
+    g_writersDone = 0;
+    (void)BinLogInit(&g_log, g_logBuff, RING_LEN);
+
+    HOST_CHECK_EQ(pthread_create(&consumer, NULL, ConsumerThread, NULL), 0);
+    for (uintptr_t i = 0; i < WRITER_THREADS; i++) {
+        HOST_CHECK_EQ(pthread_create(&writers[i], NULL, WriterThread, (void *)i), 0);
+    }
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        (void)pthread_join(writers[i], NULL);
+    }
+    __atomic_store_n(&g_writersDone, 1, __ATOMIC_RELEASE);
+    (void)pthread_join(consumer, NULL);
+
+    uint32_t received = 0;
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        received += g_sink.received[i];
+    }
+
+    HOST_CHECK_EQ(g_sink.torn, 0);
+    HOST_CHECK_EQ(g_sink.reordered, 0);
+    HOST_CHECK_EQ(received + g_sink.dropped, WRITER_THREADS * WRITES_PER_THREAD);
+    HOST_CHECK(received > 0);
+    HOST_CHECK_EQ(g_log.head, g_log.tail);
+    printf("    %u received, %u dropped\n", (unsigned)received, (unsigned)g_sink.dropped);
+}
+
+int main(void)
+{
+    HOST_RUN(TestInit);
+    HOST_RUN(TestFormat);
+    HOST_RUN(TestConcurrentWriters);
+
+    return HOST_RESULT("bin_log_test");
+}
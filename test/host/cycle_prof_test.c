@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Statistics and histogram buckets of common/cycle_prof */
+
+#include <stdint.h>
+
+#include "cycle_prof.h"
+
+#include "host_test.h"
+
+static void TestBucket(void)
+{
+    HOST_CHECK_EQ(CycleProfBucket(0), 0);
+    HOST_CHECK_EQ(CycleProfBucket(1), 0);
+    HOST_CHECK_EQ(CycleProfBucket(2), 1);
+    HOST_CHECK_EQ(CycleProfBucket(3), 1);
+    HOST_CHECK_EQ(CycleProfBucket(4), 2);
+    HOST_CHECK_EQ(CycleProfBucket(1000), 9);
+    HOST_CHECK_EQ(CycleProfBucket(65535), 15);
+    HOST_CHECK_EQ(CycleProfBucket(65536), 16);
+
+    /* every power of two starts its own bucket until the last one takes the rest */
+    for (int i = 0; i < 32; i++) {
+        int expected = (i < CYCLE_PROF_HIST_BUCKETS) ? i : CYCLE_PROF_HIST_BUCKETS - 1;
+        HOST_CHECK_EQ(CycleProfBucket(1u << i), expected);
+        if (i > 0) {
+            HOST_CHECK_EQ(CycleProfBucket((1u << i) - 1), (i - 1 < CYCLE_PROF_HIST_BUCKETS) ? i - 1 : expected);
+        }
+    }
+    HOST_CHECK_EQ(CycleProfBucket(UINT32_MAX), CYCLE_PROF_HIST_BUCKETS - 1);
+}
+
+static void TestRecord(void)
+{
+    CycleProfPoint point = {.name = "test"};
+
+    HOST_CHECK_EQ(CycleProfAvg(&point), 0);
+
+    CycleProfRecord(&point, 100);
+    CycleProfRecord(&point, 300);
+    CycleProfRecord(&point, 50);
+    CycleProfRecord(&point, UINT32_MAX);
+
+    HOST_CHECK_EQ(point.count, 4);
+    HOST_CHECK_EQ(point.min, 50);
+    HOST_CHECK_EQ(point.max, UINT32_MAX);
+    HOST_CHECK_EQ(point.sum, 450ULL + UINT32_MAX);
+    HOST_CHECK_EQ(CycleProfAvg(&point), (450ULL + UINT32_MAX) / 4);
+    HOST_CHECK_EQ(point.hist[5], 1);
+    HOST_CHECK_EQ(point.hist[6], 1);
+    HOST_CHECK_EQ(point.hist[8], 1);
+    HOST_CHECK_EQ(point.hist[CYCLE_PROF_HIST_BUCKETS - 1], 1);
+
+    CycleProfReset(&point);
+    HOST_CHECK_EQ(point.count, 0);
+    HOST_CHECK_EQ(point.hist[5], 0);
+    HOST_CHECK(point.name != NULL);
+}
+
+int main(void)
+{
+    HOST_RUN(TestBucket);
+    HOST_RUN(TestRecord);
+
+    return HOST_RESULT("cycle_prof_test");
+}
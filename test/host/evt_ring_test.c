@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Unit test of common/evt_ring: wrap-around, full ring, drop and count accounting */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "evt_ring.h"
+
+#include "host_test.h"
+
+#define RING_LEN    4
+
+typedef struct {
+    uint32_t seq;
+    uint8_t pad[3];
+} TestElem;
+
+static EvtRing g_ring;
+static TestElem g_ringBuff[RING_LEN];
+
+static void TestInit(void)
+{
+    HOST_CHECK_EQ(EvtRingInit(&g_ring, g_ringBuff, sizeof(TestElem), 3), -1);
+    HOST_CHECK_EQ(EvtRingInit(&g_ring, g_ringBuff, 0, RING_LEN), -1);
+    HOST_CHECK_EQ(EvtRingInit(&g_ring, NULL, sizeof(TestElem), RING_LEN), -1);
+    HOST_CHECK_EQ(EvtRingInit(&g_ring, g_ringBuff, sizeof(TestElem), RING_LEN), 0);
+    HOST_CHECK_EQ(EvtRingCount(&g_ring), 0);
+
+    TestElem elem;
+    HOST_CHECK_EQ(EvtRingPop(&g_ring, &elem), -1);
+}
+
+static void TestFullAndDrop(void)
+{
+    TestElem elem = {0};
+
+    (void)EvtRingInit(&g_ring, g_ringBuff, sizeof(TestElem), RING_LEN);
+
+    for (uint32_t i = 0; i < RING_LEN; i++) {
+        elem.seq = i;
+        HOST_CHECK_EQ(EvtRingPush(&g_ring, &elem), 0);
+        HOST_CHECK_EQ(EvtRingCount(&g_ring), i + 1);
+    }
+
+    /* a full ring refuses and counts, the queued elements are untouched */
+    elem.seq = 100;
+    HOST_CHECK_EQ(EvtRingPush(&g_ring, &elem), -1);
+    HOST_CHECK_EQ(EvtRingPush(&g_ring, &elem), -1);
+    HOST_CHECK_EQ(g_ring.drops, 2);
+    HOST_CHECK_EQ(g_ring.highWater, RING_LEN);
+    HOST_CHECK_EQ(EvtRingCount(&g_ring), RING_LEN);
+
+    for (uint32_t i = 0; i < RING_LEN; i++) {
+        HOST_CHECK_EQ(EvtRingPop(&g_ring, &elem), 0);
+        HOST_CHECK_EQ(elem.seq, i);
+    }
+    HOST_CHECK_EQ(EvtRingPop(&g_ring, &elem), -1);
+    HOST_CHECK_EQ(EvtRingCount(&g_ring), 0);
+
+    /* one slot freed, one push accepted */
+    HOST_CHECK_EQ(EvtRingPush(&g_ring, &elem), 0);
+    HOST_CHECK_EQ(g_ring.drops, 2);
+}
+
+static void TestWrap(void)
+{
+    TestElem elem = {0};
+    uint32_t pushSeq = 0;
+    uint32_t popSeq = 0;
+
+    (void)EvtRingInit(&g_ring, g_ringBuff, sizeof(TestElem), RING_LEN);
+
+    /* indexes run freely and are masked on access, start right below the 32-bit wrap */
+    g_ring.head = UINT32_MAX - 5;
+    g_ring.tail = UINT32_MAX - 5;
+
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < 3; i++) {
+            elem.seq = pushSeq++;
+            HOST_CHECK_EQ(EvtRingPush(&g_ring, &elem), 0);
+        }
+        HOST_CHECK_EQ(EvtRingCount(&g_ring), 3);
+        for (int i = 0; i < 3; i++) {
+            HOST_CHECK_EQ(EvtRingPop(&g_ring, &elem), 0);
+            HOST_CHECK_EQ(elem.seq, popSeq++);
+        }
+        HOST_CHECK_EQ(EvtRingCount(&g_ring), 0);
+    }
+
+    HOST_CHECK(g_ring.head < RING_LEN * 8);
+    HOST_CHECK_EQ(g_ring.drops, 0);
+    HOST_CHECK_EQ(g_ring.highWater, 3);
+
+    /* full detection still works across the wrap */
+    g_ring.head = UINT32_MAX - 1;
+    g_ring.tail = UINT32_MAX - 1;
+    for (int i = 0; i < RING_LEN; i++) {
+        HOST_CHECK_EQ(EvtRingPush(&g_ring, &elem), 0);
+    }
+    HOST_CHECK_EQ(EvtRingCount(&g_ring), RING_LEN);
+    HOST_CHECK_EQ(EvtRingPush(&g_ring, &elem), -1);
+    HOST_CHECK_EQ(g_ring.drops, 1);
+}
+
+int main(void)
+{
+    HOST_RUN(TestInit);
+    HOST_RUN(TestFullAndDrop);
+    HOST_RUN(TestWrap);
+
+    return HOST_RESULT("evt_ring_test");
+}
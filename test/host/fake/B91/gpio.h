@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Host stand-in for the B91 GPIO driver: the port registers are plain memory, see fake_drivers.c */
+
+#ifndef HOST_FAKE_B91_GPIO_H
+#define HOST_FAKE_B91_GPIO_H
+
+#include <tl_common.h>
+
+#define GPIO_GROUPA 0x000
+#define GPIO_GROUPB 0x100
+#define GPIO_GROUPC 0x200
+#define GPIO_GROUPD 0x300
+#define GPIO_GROUPE 0x400
+#define GPIO_GROUPF 0x500
+
+#define FAKE_GPIO_PORTS 6
+
+/* Port in the high byte, pin mask in the low byte, as in the SDK */
+typedef enum {
+    GPIO_PA0 = GPIO_GROUPA | BIT(0), GPIO_PA1 = GPIO_GROUPA | BIT(1), GPIO_PA2 = GPIO_GROUPA | BIT(2),
+    GPIO_PA3 = GPIO_GROUPA | BIT(3), GPIO_PA4 = GPIO_GROUPA | BIT(4), GPIO_PA5 = GPIO_GROUPA | BIT(5),
+    GPIO_PA6 = GPIO_GROUPA | BIT(6), GPIO_PA7 = GPIO_GROUPA | BIT(7),
+    GPIO_PB0 = GPIO_GROUPB | BIT(0), GPIO_PB1 = GPIO_GROUPB | BIT(1), GPIO_PB2 = GPIO_GROUPB | BIT(2),
+    GPIO_PB3 = GPIO_GROUPB | BIT(3), GPIO_PB4 = GPIO_GROUPB | BIT(4), GPIO_PB5 = GPIO_GROUPB | BIT(5),
+    GPIO_PB6 = GPIO_GROUPB | BIT(6), GPIO_PB7 = GPIO_GROUPB | BIT(7),
+    GPIO_PC0 = GPIO_GROUPC | BIT(0), GPIO_PC1 = GPIO_GROUPC | BIT(1), GPIO_PC2 = GPIO_GROUPC | BIT(2),
+    GPIO_PC3 = GPIO_GROUPC | BIT(3), GPIO_PC4 = GPIO_GROUPC | BIT(4), GPIO_PC5 = GPIO_GROUPC | BIT(5),
+    GPIO_PC6 = GPIO_GROUPC | BIT(6), GPIO_PC7 = GPIO_GROUPC | BIT(7),
+} gpio_pin_e;
+
+typedef enum {
+    GPIO_PIN_UP_DOWN_FLOAT = 0,
+    GPIO_PIN_PULLUP_1M = 1,
+    GPIO_PIN_PULLDOWN_100K = 2,
+    GPIO_PIN_PULLUP_10K = 3,
+} gpio_pull_type_e;
+
+/* in, ie, oen, out, pol, ds, gpio, irq of each port */
+extern volatile u8 g_fakeGpioReg[FAKE_GPIO_PORTS][8];
+
+#define reg_gpio_in(i)      (g_fakeGpioReg[((i) >> 8) & 0xf][0])
+#define reg_gpio_out(i)     (g_fakeGpioReg[((i) >> 8) & 0xf][3])
+
+static inline void gpio_set_up_down_res(gpio_pin_e pin, gpio_pull_type_e type)
+{
+    (void)pin;
+    (void)type;
+}
+
+#endif /* HOST_FAKE_B91_GPIO_H */
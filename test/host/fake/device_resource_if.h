@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Host stand-in for the HCS access interface of the HDF. fake_hdf.c serves a single node, the GPIO
+ * controller with the pin map of the simulated board.
+ */
+
+#ifndef HOST_FAKE_DEVICE_RESOURCE_IF_H
+#define HOST_FAKE_DEVICE_RESOURCE_IF_H
+
+#include <stdint.h>
+
+typedef enum {
+    HDF_CONFIG_SOURCE = 0,
+    INVALID_CONFIG_SOURCE,
+} DeviceResourceType;
+
+struct DeviceResourceNode {
+    const char *name;
+    const char *matchAttr;
+};
+
+struct DeviceResourceIface {
+    const struct DeviceResourceNode *(*GetRootNode)(void);
+    const struct DeviceResourceNode *(*GetNodeByMatchAttr)(const struct DeviceResourceNode *node,
+        const char *attrValue);
+    int32_t (*GetElemNum)(const struct DeviceResourceNode *node, const char *attrName);
+    int32_t (*GetUint16ArrayElem)(const struct DeviceResourceNode *node, const char *attrName, uint32_t index,
+        uint16_t *value, uint16_t def);
+};
+
+struct DeviceResourceIface *DeviceResourceGetIfaceInstance(DeviceResourceType type);
+
+#endif /* HOST_FAKE_DEVICE_RESOURCE_IF_H */
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Host stand-in for drivers.h of the Telink B91 SDK. The system timer is simulated: it only moves
+ * when FakeClockAdvanceUs() is called, so tests are deterministic.
+ */
+
+#ifndef HOST_FAKE_DRIVERS_H
+#define HOST_FAKE_DRIVERS_H
+
+#include <tl_common.h>
+
+#include <B91/gpio.h>
+
+#define SYSTEM_TIMER_TICK_1US       16
+#define SYSTEM_TIMER_TICK_1MS       16000
+#define SYSTEM_TIMER_TICK_1S        16000000
+
+extern volatile u32 g_fakeSysTick;
+
+static inline u32 clock_time(void)
+{
+    return g_fakeSysTick;
+}
+
+static inline u32 stimer_get_tick(void)
+{
+    return g_fakeSysTick;
+}
+
+static inline u32 clock_time_exceed(u32 ref, u32 us)
+{
+    return (u32)(clock_time() - ref) > us * SYSTEM_TIMER_TICK_1US;
+}
+
+/**
+ * @brief      Move the simulated system timer forward
+ * @param[in]  us  microseconds
+ * @return     none
+ */
+void FakeClockAdvanceUs(u32 us);
+
+/* Interrupt masking of the RISC-V core, nesting is tracked so tests can check it */
+extern volatile u32 g_fakeIrqDisabled;
+
+static inline u32 core_interrupt_disable(void)
+{
+    return g_fakeIrqDisabled++;
+}
+
+static inline u32 core_restore_interrupt(u32 en)
+{
+    g_fakeIrqDisabled = en;
+    return 0;
+}
+
+extern volatile u32 reg_system_irq_mask;
+#define FLD_SYSTEM_TRIG_PAST_EN     BIT(2)
+
+void random_generator_init(void);
+void rf_drv_ble_init(void);
+int pm_is_MCU_deepRetentionWakeup(void);
+
+/* Value returned by pm_is_MCU_deepRetentionWakeup(), host only */
+extern int g_fakeRetentionWake;
+
+/* Internal flash, backed by a RAM image of FAKE_FLASH_SIZE bytes filled with 0xFF */
+#define FAKE_FLASH_SIZE             0x100000
+
+extern u8 g_fakeFlash[FAKE_FLASH_SIZE];
+
+void flash_read_page(unsigned long addr, unsigned long len, unsigned char *buf);
+void flash_write_page(unsigned long addr, unsigned long len, unsigned char *buf);
+void flash_erase_sector(unsigned long addr);
+
+#endif /* HOST_FAKE_DRIVERS_H */
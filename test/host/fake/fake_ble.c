@@ -0,0 +1,592 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Telink BLE SDK API of stack/ble/ble.h on top of the simulated controller */
+
+#include <string.h>
+
+#include <app_config.h>
+
+#include "sim_controller.h"
+
+#define SIM_ATT_HEADER_LEN  3
+#define SIM_UUID_CCC        0x2902
+
+u32 flash_sector_mac_address = 0xFF000;
+
+void blc_initMacAddress(int flash_addr, u8 *mac_public, u8 *mac_random_static)
+{
+    static const u8 mac[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+    UNUSED(flash_addr);
+    memcpy(mac_public, mac, sizeof(mac));
+    memcpy(mac_random_static, mac, sizeof(mac));
+    mac_random_static[5] |= 0xC0;
+}
+
+void blc_app_loadCustomizedParameters(void)
+{
+}
+
+void blc_ll_initBasicMCU(void)
+{
+}
+
+void blc_ll_initStandby_module(u8 *public_adr)
+{
+    UNUSED(public_adr);
+}
+
+ble_sts_t blc_ll_initAclConnRxFifo(u8 *pRxbuf, int fifo_size, int fifo_number)
+{
+    UNUSED(pRxbuf);
+
+    if (fifo_size < CAL_LL_ACL_RX_FIFO_SIZE(g_sim.maxRxOctets) || (fifo_number & (fifo_number - 1)) != 0) {
+        return LL_ERR_INVALID_PARAMETER;
+    }
+    g_sim.rxFifoNum = (u8)fifo_number;
+
+    return BLE_SUCCESS;
+}
+
+static ble_sts_t SimInitTxFifo(int fifo_size, int fifo_number)
+{
+    if (fifo_size < CAL_LL_ACL_TX_FIFO_SIZE(g_sim.maxTxOctets) || fifo_number < 3 ||
+        ((fifo_number - 1) & (fifo_number - 2)) != 0) {
+        return LL_ERR_INVALID_PARAMETER;
+    }
+    g_sim.txFifoNum = (u8)fifo_number;
+
+    return BLE_SUCCESS;
+}
+
+ble_sts_t blc_controller_check_appBufferInitialization(void)
+{
+    g_sim.appBufferChecks++;
+
+    return (g_sim.txFifoNum != 0 && g_sim.rxFifoNum != 0) ? BLE_SUCCESS : LL_ERR_INVALID_PARAMETER;
+}
+
+ble_sts_t blc_att_requestMtuSizeExchange(u16 connHandle, u16 mtu_size)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    if (conn == NULL) {
+        return HCI_ERR_UNKNOWN_CONN_ID;
+    }
+    conn->mtu = min(min(mtu_size, g_sim.rxMtu), g_sim.peerMtu);
+
+    return BLE_SUCCESS;
+}
+
+u16 blc_att_getEffectiveMtuSize(u16 connHandle)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    return (conn == NULL) ? 23 : conn->mtu;
+}
+
+void blc_ll_init2MPhyCodedPhy_feature(void)
+{
+}
+
+ble_sts_t blc_ll_setPhy(u16 connHandle, u8 all_phys, u8 tx_phys, u8 rx_phys, le_ci_prefer_t phy_options)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    UNUSED(all_phys);
+    UNUSED(rx_phys);
+    UNUSED(phy_options);
+
+    if (conn == NULL) {
+        return HCI_ERR_UNKNOWN_CONN_ID;
+    }
+
+    conn->phyReqs++;
+    conn->phyReq = tx_phys;
+    if (g_sim.acceptPhyReq) {
+        u8 phy = (tx_phys & PHY_PREFER_2M) ? BLE_PHY_2M : (tx_phys & PHY_PREFER_CODED) ? BLE_PHY_CODED : BLE_PHY_1M;
+        SimQueuePhyUpdate(connHandle, phy);
+    }
+
+    return BLE_SUCCESS;
+}
+
+ble_sts_t blc_hci_le_setEventMask_cmd(u32 evtMask)
+{
+    g_sim.hciEventMask = evtMask;
+
+    return BLE_SUCCESS;
+}
+
+void blc_hci_registerControllerEventHandler(hci_event_handler_t handler)
+{
+    g_sim.hciHandler = handler;
+}
+
+void bls_att_setAttributeTable(u8 *p)
+{
+    g_sim.attTable = (const attribute_t *)p;
+}
+
+static ble_sts_t SimSetAdvParam(u16 intervalMin, u16 intervalMax)
+{
+    g_sim.advParamCalls++;
+    if (g_sim.advParamFail != BLE_SUCCESS) {
+        ble_sts_t status = g_sim.advParamFail;
+        g_sim.advParamFail = BLE_SUCCESS;
+        return status;
+    }
+    if (g_sim.advEnabled) {
+        return HCI_ERR_CONTROLLER_BUSY;
+    }
+
+    g_sim.advIntervalMin = intervalMin;
+    g_sim.advIntervalMax = intervalMax;
+
+    return BLE_SUCCESS;
+}
+
+static ble_sts_t SimSetAdvEnable(int adv_enable)
+{
+    g_sim.advEnableCalls++;
+    if (adv_enable && !g_sim.advEnabled) {
+        g_sim.nextAdvTick = clock_time();
+    }
+    g_sim.advEnabled = (u8)(adv_enable != 0);
+
+    return BLE_SUCCESS;
+}
+
+/**
+ * @brief      Account a notification in the TX FIFO of the link
+ */
+static ble_sts_t SimPushNotify(u16 connHandle, u16 attHandle, const u8 *p, int len)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    if (conn == NULL || !conn->up) {
+        return HCI_ERR_UNKNOWN_CONN_ID;
+    }
+    if (len + SIM_ATT_HEADER_LEN > conn->mtu) {
+        return LL_ERR_INVALID_PARAMETER;
+    }
+
+    /* one FIFO entry is kept back by the controller */
+    u8 capacity = (g_sim.txFifoNum > 1) ? g_sim.txFifoNum - 1 : 8;
+    if (conn->txFifo >= capacity) {
+        conn->notifyRefused++;
+        return LL_ERR_TX_FIFO_NOT_ENOUGH;
+    }
+
+    /* the SDK leaves the CCC check to the application, the simulation only counts misses */
+    if (g_sim.attTable != NULL && attHandle < g_sim.attTable[0].attNum) {
+        const attribute_t *ccc = &g_sim.attTable[attHandle + 1];
+        if (ccc->uuidLen == 2 && MAKE_U16(ccc->uuid[1], ccc->uuid[0]) == SIM_UUID_CCC &&
+            !(ccc->pAttrValue[0] & BIT(0))) {
+            conn->notifyNoCcc++;
+        }
+    }
+
+    conn->txFifo++;
+    conn->notifyOk++;
+    conn->notifyBytes += len;
+    conn->lastNotifyHandle = attHandle;
+    conn->lastNotifyLen = (u16)len;
+    memcpy(conn->lastNotifyData, p, min(len, (int)sizeof(conn->lastNotifyData)));
+    if (g_sim.notifyHook != NULL) {
+        g_sim.notifyHook(connHandle, attHandle, p, (u16)len);
+    }
+
+    return BLE_SUCCESS;
+}
+
+static void SimRequestConnParam(u16 connHandle, u16 min_interval, u16 max_interval, u16 latency, u16 timeout)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    if (conn == NULL) {
+        return;
+    }
+
+    conn->paramReqs++;
+    conn->paramReqMin = min_interval;
+    conn->paramReqMax = max_interval;
+    conn->paramReqLatency = latency;
+    conn->paramReqTimeout = timeout;
+    if (g_sim.acceptParamReq) {
+        SimQueueConnUpdate(connHandle, max_interval, latency, timeout);
+    }
+}
+
+static ble_sts_t SimTerminate(u16 connHandle, u8 reason)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    g_sim.terminateRequests++;
+    if (conn == NULL) {
+        return HCI_ERR_UNKNOWN_CONN_ID;
+    }
+
+    conn->terminateReason = reason;
+    SimQueueDisconnect(connHandle, HCI_ERR_CONN_TERM_BY_LOCAL_HOST);
+
+    return BLE_SUCCESS;
+}
+
+static u8 SimTxFifoNumber(u16 connHandle)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    return (conn == NULL) ? 0 : conn->txFifo;
+}
+
+static u8 SimRawRssi(u16 connHandle)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    return (conn == NULL) ? 0 : (u8)(conn->rssi + 110);
+}
+
+static u16 SimConnInterval(u16 connHandle)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    return (conn == NULL || !conn->up) ? 0 : conn->interval;
+}
+
+#if TELINK_SDK_B91_BLE_SINGLE
+
+ble_sts_t bls_ll_setAdvParam(u16 intervalMin, u16 intervalMax, adv_type_t advType, own_addr_type_t ownAddrType,
+                             u8 peerAddrType, u8 *peerAddr, adv_chn_map_t adv_channelMap,
+                             adv_fp_type_t advFilterPolicy)
+{
+    UNUSED(advType);
+    UNUSED(ownAddrType);
+    UNUSED(peerAddrType);
+    UNUSED(peerAddr);
+    UNUSED(adv_channelMap);
+    UNUSED(advFilterPolicy);
+
+    return SimSetAdvParam(intervalMin, intervalMax);
+}
+
+ble_sts_t bls_ll_setAdvData(u8 *data, u8 len)
+{
+    UNUSED(data);
+    g_sim.advDataLen = len;
+
+    return (len <= 31) ? BLE_SUCCESS : LL_ERR_INVALID_PARAMETER;
+}
+
+ble_sts_t bls_ll_setScanRspData(u8 *data, u8 len)
+{
+    UNUSED(data);
+    g_sim.scanRspLen = len;
+
+    return (len <= 31) ? BLE_SUCCESS : LL_ERR_INVALID_PARAMETER;
+}
+
+ble_sts_t bls_ll_setAdvEnable(int adv_enable)
+{
+    return SimSetAdvEnable(adv_enable);
+}
+
+ble_sts_t bls_ll_terminateConnection(u8 reason)
+{
+    return SimTerminate(BLS_CONN_HANDLE, reason);
+}
+
+u16 bls_ll_getConnectionInterval(void)
+{
+    return SimConnInterval(BLS_CONN_HANDLE);
+}
+
+ble_sts_t blc_ll_initAclConnTxFifo(u8 *pTxbuf, int fifo_size, int fifo_number)
+{
+    UNUSED(pTxbuf);
+
+    return SimInitTxFifo(fifo_size, fifo_number);
+}
+
+ble_sts_t blc_ll_setAclConnMaxOctetsNumber(u8 maxRxOct, u8 maxTxOct)
+{
+    g_sim.maxRxOctets = maxRxOct;
+    g_sim.maxTxOctets = maxTxOct;
+
+    return BLE_SUCCESS;
+}
+
+ble_sts_t blc_ll_exchangeDataLength(u8 opcode, u16 maxTxOct)
+{
+    UNUSED(opcode);
+
+    return (maxTxOct <= g_sim.maxTxOctets) ? BLE_SUCCESS : LL_ERR_INVALID_PARAMETER;
+}
+
+u8 blc_ll_getTxFifoNumber(void)
+{
+    return SimTxFifoNumber(BLS_CONN_HANDLE);
+}
+
+u8 blc_ll_getLatestAvgRSSI(void)
+{
+    return SimRawRssi(BLS_CONN_HANDLE);
+}
+
+ble_sts_t blc_att_setRxMtuSize(u16 mtu_size)
+{
+    g_sim.rxMtu = mtu_size;
+
+    return BLE_SUCCESS;
+}
+
+void blc_l2cap_initMtuBuffer(u8 *pMTU_rx_buff, u16 mtu_rx_size, u8 *pMTU_tx_buff, u16 mtu_tx_size)
+{
+    UNUSED(pMTU_rx_buff);
+    UNUSED(mtu_rx_size);
+    UNUSED(pMTU_tx_buff);
+    UNUSED(mtu_tx_size);
+}
+
+ble_sts_t bls_att_pushNotifyData(u16 attHandle, u8 *p, int len)
+{
+    return SimPushNotify(BLS_CONN_HANDLE, attHandle, p, len);
+}
+
+void blc_gap_peripheral_init(void)
+{
+}
+
+void blc_l2cap_register_handler(void *p)
+{
+    g_sim.dataHandler = (int (*)(u16, u8 *))p;
+}
+
+int blc_l2cap_packet_receive(u16 connHandle, u8 *p)
+{
+    return SimAttServe(connHandle, p);
+}
+
+void blc_ll_initAdvertising_module(void)
+{
+}
+
+void blc_ll_initConnection_module(void)
+{
+}
+
+void blc_ll_initSlaveRole_module(void)
+{
+}
+
+void blc_ll_initPowerManagement_module(void)
+{
+}
+
+void bls_pm_setSuspendMask(u8 mask)
+{
+    UNUSED(mask);
+}
+
+u32 bls_pm_getSystemWakeupTick(void)
+{
+    return g_sim.pmWakeupTick;
+}
+
+void blc_ll_recoverDeepRetention(void)
+{
+}
+
+void bls_app_registerEventCallback(u8 e, blt_event_callback_t p)
+{
+    if (e < BLT_EV_MAX_NUM) {
+        g_sim.evtCb[e] = p;
+    }
+}
+
+void bls_l2cap_requestConnParamUpdate(u16 min_interval, u16 max_interval, u16 latency, u16 timeout)
+{
+    SimRequestConnParam(BLS_CONN_HANDLE, min_interval, max_interval, latency, timeout);
+}
+
+void blt_sdk_main_loop(void)
+{
+    SimMainLoop();
+}
+
+void irq_blt_sdk_handler(void)
+{
+    SimIrq();
+}
+
+#else
+
+ble_sts_t blc_ll_setAdvParam(u16 intervalMin, u16 intervalMax, adv_type_t advType, own_addr_type_t ownAddrType,
+                             u8 peerAddrType, u8 *peerAddr, adv_chn_map_t adv_channelMap,
+                             adv_fp_type_t advFilterPolicy)
+{
+    UNUSED(advType);
+    UNUSED(ownAddrType);
+    UNUSED(peerAddrType);
+    UNUSED(peerAddr);
+    UNUSED(adv_channelMap);
+    UNUSED(advFilterPolicy);
+
+    return SimSetAdvParam(intervalMin, intervalMax);
+}
+
+ble_sts_t blc_ll_setAdvData(u8 *data, u8 len)
+{
+    UNUSED(data);
+    g_sim.advDataLen = len;
+
+    return (len <= 31) ? BLE_SUCCESS : LL_ERR_INVALID_PARAMETER;
+}
+
+ble_sts_t blc_ll_setScanRspData(u8 *data, u8 len)
+{
+    UNUSED(data);
+    g_sim.scanRspLen = len;
+
+    return (len <= 31) ? BLE_SUCCESS : LL_ERR_INVALID_PARAMETER;
+}
+
+ble_sts_t blc_ll_setAdvEnable(int adv_enable)
+{
+    return SimSetAdvEnable(adv_enable);
+}
+
+ble_sts_t blc_ll_disconnect(u16 connHandle, u8 reason)
+{
+    return SimTerminate(connHandle, reason);
+}
+
+u16 blc_ll_getAclConnectionInterval(u16 connHandle)
+{
+    return SimConnInterval(connHandle);
+}
+
+ble_sts_t blc_ll_initAclConnSlaveTxFifo(u8 *pTxbuf, int fifo_size, int fifo_number, int conn_number)
+{
+    UNUSED(pTxbuf);
+    UNUSED(conn_number);
+
+    return SimInitTxFifo(fifo_size, fifo_number);
+}
+
+ble_sts_t blc_ll_setAclConnMaxOctetsNumber(u8 maxRxOct, u8 maxTxOct_master, u8 maxTxOct_slave)
+{
+    UNUSED(maxTxOct_master);
+    g_sim.maxRxOctets = maxRxOct;
+    g_sim.maxTxOctets = maxTxOct_slave;
+
+    return BLE_SUCCESS;
+}
+
+ble_sts_t blc_ll_sendDateLengthExtendReq(u16 connHandle, u16 maxTxOct)
+{
+    if (SimGetConn(connHandle) == NULL) {
+        return HCI_ERR_UNKNOWN_CONN_ID;
+    }
+
+    return (maxTxOct <= g_sim.maxTxOctets) ? BLE_SUCCESS : LL_ERR_INVALID_PARAMETER;
+}
+
+ble_sts_t blc_ll_setMaxConnectionNumber(int max_master_num, int max_slave_num)
+{
+    if (max_master_num != 0 || max_slave_num < 1 || max_slave_num > SLAVE_MAX_NUM) {
+        return LL_ERR_INVALID_PARAMETER;
+    }
+    g_sim.maxSlaves = (u8)max_slave_num;
+
+    return BLE_SUCCESS;
+}
+
+u8 blc_ll_getTxFifoNumber(u16 connHandle)
+{
+    return SimTxFifoNumber(connHandle);
+}
+
+u8 blc_ll_getLatestAvgRSSI(u16 connHandle)
+{
+    return SimRawRssi(connHandle);
+}
+
+ble_sts_t blc_att_setSlaveRxMTUSize(u16 mtu_size)
+{
+    g_sim.rxMtu = mtu_size;
+
+    return BLE_SUCCESS;
+}
+
+void blc_l2cap_initAclConnSlaveMtuBuffer(u8 *pMTU_rx_buff, u16 mtu_rx_size, u8 *pMTU_tx_buff, u16 mtu_tx_size)
+{
+    UNUSED(pMTU_rx_buff);
+    UNUSED(mtu_rx_size);
+    UNUSED(pMTU_tx_buff);
+    UNUSED(mtu_tx_size);
+}
+
+ble_sts_t blc_gatt_pushHandleValueNotify(u16 connHandle, u16 attHandle, u8 *p, int len)
+{
+    return SimPushNotify(connHandle, attHandle, p, len);
+}
+
+void blc_gap_init(void)
+{
+}
+
+void blc_hci_registerControllerDataHandler(blc_hci_data_handler_t handler)
+{
+    g_sim.dataHandler = handler;
+}
+
+int blc_l2cap_pktHandler(u16 connHandle, u8 *raw_pkt)
+{
+    return SimAttServe(connHandle, raw_pkt);
+}
+
+void blc_ll_initLegacyAdvertising_module(void)
+{
+}
+
+void blc_ll_initAclConnection_module(void)
+{
+}
+
+void blc_ll_initAclSlaveRole_module(void)
+{
+}
+
+void blc_l2cap_sendConnParamUpdateReq(u16 connHandle, u16 min_interval, u16 max_interval, u16 latency, u16 timeout)
+{
+    SimRequestConnParam(connHandle, min_interval, max_interval, latency, timeout);
+}
+
+void blc_sdk_main_loop(void)
+{
+    SimMainLoop();
+}
+
+void blc_sdk_irq_handler(void)
+{
+    SimIrq();
+}
+
+#endif /* TELINK_SDK_B91_BLE_SINGLE */
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <drivers.h>
+
+volatile u32 g_fakeSysTick = 0x1000;
+volatile u32 g_fakeIrqDisabled;
+volatile u32 reg_system_irq_mask;
+volatile u8 g_fakeGpioReg[FAKE_GPIO_PORTS][8];
+
+int g_fakeRetentionWake;
+
+u8 g_fakeFlash[FAKE_FLASH_SIZE];
+
+__attribute__((constructor)) static void FakeFlashInit(void)
+{
+    memset(g_fakeFlash, 0xFF, sizeof(g_fakeFlash));
+}
+
+void FakeClockAdvanceUs(u32 us)
+{
+    g_fakeSysTick += us * SYSTEM_TIMER_TICK_1US;
+}
+
+void random_generator_init(void)
+{
+}
+
+void rf_drv_ble_init(void)
+{
+}
+
+int pm_is_MCU_deepRetentionWakeup(void)
+{
+    return g_fakeRetentionWake;
+}
+
+void flash_read_page(unsigned long addr, unsigned long len, unsigned char *buf)
+{
+    if (addr + len <= FAKE_FLASH_SIZE) {
+        memcpy(buf, &g_fakeFlash[addr], len);
+    }
+}
+
+/* NOR flash: programming only clears bits */
+void flash_write_page(unsigned long addr, unsigned long len, unsigned char *buf)
+{
+    for (unsigned long i = 0; i < len && addr + i < FAKE_FLASH_SIZE; i++) {
+        g_fakeFlash[addr + i] &= buf[i];
+    }
+}
+
+void flash_erase_sector(unsigned long addr)
+{
+    addr &= ~0xFFFUL;
+    if (addr < FAKE_FLASH_SIZE) {
+        memset(&g_fakeFlash[addr], 0xFF, 0x1000);
+    }
+}
@@ -0,0 +1,302 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <drivers.h>
+#include <board_config.h>
+
+#include <device_resource_if.h>
+#include <gpio_if.h>
+#include <hdf_base.h>
+#include <hiview_log.h>
+
+/* HDF GPIO indexes of board_config.h and the pins the simulated board wires them to */
+static const gpio_pin_e g_fakeHdfPin[] = {
+    [LED_BLUE_HDF] = GPIO_PB4,
+    [LED_GREEN_HDF] = GPIO_PB5,
+    [LED_WHITE_HDF] = GPIO_PB6,
+    [LED_RED_HDF] = GPIO_PB7,
+    [SW1_2_GPIO_HDF] = SW1_2_GPIO,
+    [SW1_3_GPIO_HDF] = SW1_3_GPIO,
+};
+
+#define FAKE_HDF_GPIO_NUM   (sizeof(g_fakeHdfPin) / sizeof(g_fakeHdfPin[0]))
+
+static struct {
+    uint8_t dir;
+    uint8_t irqEnabled;
+    uint16_t irqMode;
+    GpioIrqFunc irqFunc;
+    void *irqArg;
+} g_fakeHdfGpio[FAKE_HDF_GPIO_NUM];
+
+uint32_t g_fakeHdfGpioCalls;
+
+static volatile u8 *FakeGpioReg(uint16_t gpio, int reg)
+{
+    return &g_fakeGpioReg[(g_fakeHdfPin[gpio] >> 8) & 0xf][reg];
+}
+
+static void FakeGpioSetBit(volatile u8 *reg, uint16_t gpio, uint16_t val)
+{
+    u8 mask = g_fakeHdfPin[gpio] & 0xff;
+
+    if (val == GPIO_VAL_LOW) {
+        *reg &= (u8)~mask;
+    } else {
+        *reg |= mask;
+    }
+}
+
+int32_t GpioRead(uint16_t gpio, uint16_t *val)
+{
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM || val == NULL) {
+        return -1;
+    }
+
+    int reg = (g_fakeHdfGpio[gpio].dir == GPIO_DIR_OUT) ? 3 : 0;
+    *val = (*FakeGpioReg(gpio, reg) & (g_fakeHdfPin[gpio] & 0xff)) ? GPIO_VAL_HIGH : GPIO_VAL_LOW;
+
+    return 0;
+}
+
+int32_t GpioWrite(uint16_t gpio, uint16_t val)
+{
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return -1;
+    }
+
+    FakeGpioSetBit(FakeGpioReg(gpio, 3), gpio, val);
+
+    return 0;
+}
+
+int32_t GpioSetDir(uint16_t gpio, uint16_t dir)
+{
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return -1;
+    }
+
+    g_fakeHdfGpio[gpio].dir = (uint8_t)dir;
+
+    return 0;
+}
+
+int32_t GpioGetDir(uint16_t gpio, uint16_t *dir)
+{
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return -1;
+    }
+
+    *dir = g_fakeHdfGpio[gpio].dir;
+
+    return 0;
+}
+
+int32_t GpioSetIrq(uint16_t gpio, uint16_t mode, GpioIrqFunc func, void *arg)
+{
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return -1;
+    }
+
+    g_fakeHdfGpio[gpio].irqMode = mode;
+    g_fakeHdfGpio[gpio].irqFunc = func;
+    g_fakeHdfGpio[gpio].irqArg = arg;
+
+    return 0;
+}
+
+int32_t GpioUnsetIrq(uint16_t gpio, void *arg)
+{
+    (void)arg;
+
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return -1;
+    }
+
+    g_fakeHdfGpio[gpio].irqFunc = NULL;
+    g_fakeHdfGpio[gpio].irqEnabled = 0;
+
+    return 0;
+}
+
+int32_t GpioEnableIrq(uint16_t gpio)
+{
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return -1;
+    }
+
+    g_fakeHdfGpio[gpio].irqEnabled = 1;
+
+    return 0;
+}
+
+int32_t GpioDisableIrq(uint16_t gpio)
+{
+    g_fakeHdfGpioCalls++;
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return -1;
+    }
+
+    g_fakeHdfGpio[gpio].irqEnabled = 0;
+
+    return 0;
+}
+
+void FakeGpioSetInput(uint16_t gpio, uint16_t val)
+{
+    if (gpio >= FAKE_HDF_GPIO_NUM) {
+        return;
+    }
+
+    volatile u8 *in = FakeGpioReg(gpio, 0);
+    u8 mask = g_fakeHdfPin[gpio] & 0xff;
+    uint16_t old = (*in & mask) ? GPIO_VAL_HIGH : GPIO_VAL_LOW;
+
+    FakeGpioSetBit(in, gpio, val);
+    if (old == val || !g_fakeHdfGpio[gpio].irqEnabled || g_fakeHdfGpio[gpio].irqFunc == NULL) {
+        return;
+    }
+
+    uint16_t edge = (val == GPIO_VAL_HIGH) ? GPIO_IRQ_TRIGGER_RISING : GPIO_IRQ_TRIGGER_FALLING;
+    if (g_fakeHdfGpio[gpio].irqMode & edge) {
+        /* the handler runs in interrupt context */
+        u32 irq = core_interrupt_disable();
+        g_fakeHdfGpio[gpio].irqFunc(gpio, g_fakeHdfGpio[gpio].irqArg);
+        core_restore_interrupt(irq);
+    }
+}
+
+static const struct DeviceResourceNode g_fakeHcsRoot = {.name = "root"};
+static const struct DeviceResourceNode g_fakeHcsGpio = {.name = "gpio_config", .matchAttr = "gpio_config"};
+
+static const struct DeviceResourceNode *FakeHcsGetRootNode(void)
+{
+    return &g_fakeHcsRoot;
+}
+
+static const struct DeviceResourceNode *FakeHcsGetNodeByMatchAttr(const struct DeviceResourceNode *node,
+    const char *attrValue)
+{
+    if (node != &g_fakeHcsRoot || attrValue == NULL || strcmp(attrValue, g_fakeHcsGpio.matchAttr) != 0) {
+        return NULL;
+    }
+
+    return &g_fakeHcsGpio;
+}
+
+static int32_t FakeHcsGetElemNum(const struct DeviceResourceNode *node, const char *attrName)
+{
+    if (node != &g_fakeHcsGpio || strcmp(attrName, "pinMap") != 0) {
+        return HDF_FAILURE;
+    }
+
+    return FAKE_HDF_GPIO_NUM;
+}
+
+static int32_t FakeHcsGetUint16ArrayElem(const struct DeviceResourceNode *node, const char *attrName,
+    uint32_t index, uint16_t *value, uint16_t def)
+{
+    *value = def;
+    if (node != &g_fakeHcsGpio || strcmp(attrName, "pinMap") != 0 || index >= FAKE_HDF_GPIO_NUM) {
+        return HDF_FAILURE;
+    }
+
+    *value = g_fakeHdfPin[index];
+    return HDF_SUCCESS;
+}
+
+static struct DeviceResourceIface g_fakeHcsIface = {
+    .GetRootNode = FakeHcsGetRootNode,
+    .GetNodeByMatchAttr = FakeHcsGetNodeByMatchAttr,
+    .GetElemNum = FakeHcsGetElemNum,
+    .GetUint16ArrayElem = FakeHcsGetUint16ArrayElem,
+};
+
+struct DeviceResourceIface *DeviceResourceGetIfaceInstance(DeviceResourceType type)
+{
+    return (type == HDF_CONFIG_SOURCE) ? &g_fakeHcsIface : NULL;
+}
+
+#define FAKE_LOG_LINES      1024
+#define FAKE_LOG_LINE_MAX   192
+
+static char g_fakeLog[FAKE_LOG_LINES][FAKE_LOG_LINE_MAX];
+static unsigned g_fakeLogCount;
+
+void HiLogPrintf(uint8_t module, uint8_t level, const char *fmt, ...)
+{
+    static int verbose = -1;
+    char *line = g_fakeLog[g_fakeLogCount % FAKE_LOG_LINES];
+    va_list args;
+
+    (void)module;
+
+    va_start(args, fmt);
+    (void)vsnprintf(line, FAKE_LOG_LINE_MAX, fmt, args);
+    va_end(args);
+    g_fakeLogCount++;
+
+    if (verbose < 0) {
+        verbose = getenv("HOST_LOG") != NULL;
+    }
+    if (verbose) {
+        printf("[%c] %s\n", "??DIWEF"[level % 7], line);
+    }
+}
+
+void FakeLogClear(void)
+{
+    g_fakeLogCount = 0;
+}
+
+unsigned FakeLogCount(const char *needle)
+{
+    unsigned first = (g_fakeLogCount > FAKE_LOG_LINES) ? g_fakeLogCount - FAKE_LOG_LINES : 0;
+    unsigned count = 0;
+
+    for (unsigned i = first; i < g_fakeLogCount; i++) {
+        count += strstr(g_fakeLog[i % FAKE_LOG_LINES], needle) != NULL;
+    }
+
+    return count;
+}
+
+const char *FakeLogFind(const char *needle)
+{
+    unsigned first = (g_fakeLogCount > FAKE_LOG_LINES) ? g_fakeLogCount - FAKE_LOG_LINES : 0;
+
+    for (unsigned i = g_fakeLogCount; i > first; i--) {
+        if (strstr(g_fakeLog[(i - 1) % FAKE_LOG_LINES], needle) != NULL) {
+            return g_fakeLog[(i - 1) % FAKE_LOG_LINES];
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <drivers.h>
+
+#include <los_event.h>
+#include <los_swtmr.h>
+#include <los_task.h>
+#include <los_tick.h>
+
+#define FAKE_SWTMR_MAX  8
+
+TSK_INIT_PARAM_S g_fakeTasks[FAKE_TASK_MAX];
+UINT32 g_fakeTaskCount;
+
+UINT32 LOS_TaskCreate(UINT32 *taskID, TSK_INIT_PARAM_S *taskInitParam)
+{
+    if (g_fakeTaskCount >= FAKE_TASK_MAX) {
+        return LOS_NOK;
+    }
+
+    g_fakeTasks[g_fakeTaskCount] = *taskInitParam;
+    *taskID = g_fakeTaskCount++;
+
+    return LOS_OK;
+}
+
+UINT32 LOS_TaskDelay(UINT32 tick)
+{
+    FakeClockAdvanceUs(tick * (1000000 / LOSCFG_BASE_CORE_TICK_PER_SECOND));
+
+    return LOS_OK;
+}
+
+UINT32 LOS_Msleep(UINT32 msecs)
+{
+    return LOS_TaskDelay(LOS_MS2Tick(msecs));
+}
+
+VOID LOS_TaskLock(VOID)
+{
+}
+
+VOID LOS_TaskUnlock(VOID)
+{
+}
+
+UINT32 LOS_EventInit(EVENT_CB_S *eventCB)
+{
+    eventCB->uwEventID = 0;
+    eventCB->writes = 0;
+
+    return LOS_OK;
+}
+
+UINT32 g_fakeEventWrites;
+
+UINT32 LOS_EventWrite(EVENT_CB_S *eventCB, UINT32 events)
+{
+    eventCB->uwEventID |= events;
+    eventCB->writes++;
+    g_fakeEventWrites++;
+
+    return LOS_OK;
+}
+
+UINT32 LOS_EventRead(EVENT_CB_S *eventCB, UINT32 eventMask, UINT32 mode, UINT32 timeout)
+{
+    UINT32 events = eventCB->uwEventID & eventMask;
+
+    if ((mode & LOS_WAITMODE_AND) && events != eventMask) {
+        events = 0;
+    }
+    if (events != 0 && (mode & LOS_WAITMODE_CLR)) {
+        eventCB->uwEventID &= ~events;
+    }
+    if (events == 0) {
+        /* nobody else runs on the host, a blocking read just lets the time pass */
+        (void)LOS_TaskDelay(timeout);
+    }
+
+    return events;
+}
+
+UINT64 LOS_TickCountGet(VOID)
+{
+    return g_fakeSysTick / (SYSTEM_TIMER_TICK_1S / LOSCFG_BASE_CORE_TICK_PER_SECOND);
+}
+
+UINT32 LOS_MS2Tick(UINT32 millisec)
+{
+    return (UINT32)((UINT64)millisec * LOSCFG_BASE_CORE_TICK_PER_SECOND / 1000);
+}
+
+static struct {
+    UINT8 used;
+    UINT8 active;
+    UINT8 mode;
+    UINT32 interval;
+    UINT64 expiry;
+    SWTMR_PROC_FUNC handler;
+    UINTPTR arg;
+} g_fakeSwtmr[FAKE_SWTMR_MAX];
+
+UINT32 LOS_SwtmrCreate(UINT32 interval, UINT8 mode, SWTMR_PROC_FUNC handler, UINT32 *swtmrID, UINTPTR arg)
+{
+    if (interval == 0 || handler == NULL) {
+        return LOS_NOK;
+    }
+
+    for (UINT32 i = 0; i < FAKE_SWTMR_MAX; i++) {
+        if (!g_fakeSwtmr[i].used) {
+            memset(&g_fakeSwtmr[i], 0, sizeof(g_fakeSwtmr[i]));
+            g_fakeSwtmr[i].used = 1;
+            g_fakeSwtmr[i].mode = mode;
+            g_fakeSwtmr[i].interval = interval;
+            g_fakeSwtmr[i].handler = handler;
+            g_fakeSwtmr[i].arg = arg;
+            *swtmrID = i;
+            return LOS_OK;
+        }
+    }
+
+    return LOS_NOK;
+}
+
+UINT32 LOS_SwtmrStart(UINT32 swtmrID)
+{
+    if (swtmrID >= FAKE_SWTMR_MAX || !g_fakeSwtmr[swtmrID].used) {
+        return LOS_ERRNO_SWTMR_ID_INVALID;
+    }
+
+    g_fakeSwtmr[swtmrID].active = 1;
+    g_fakeSwtmr[swtmrID].expiry = LOS_TickCountGet() + g_fakeSwtmr[swtmrID].interval;
+
+    return LOS_OK;
+}
+
+UINT32 LOS_SwtmrStop(UINT32 swtmrID)
+{
+    if (swtmrID >= FAKE_SWTMR_MAX || !g_fakeSwtmr[swtmrID].used) {
+        return LOS_ERRNO_SWTMR_ID_INVALID;
+    }
+
+    g_fakeSwtmr[swtmrID].active = 0;
+
+    return LOS_OK;
+}
+
+UINT32 LOS_SwtmrDelete(UINT32 swtmrID)
+{
+    if (swtmrID >= FAKE_SWTMR_MAX || !g_fakeSwtmr[swtmrID].used) {
+        return LOS_ERRNO_SWTMR_ID_INVALID;
+    }
+
+    g_fakeSwtmr[swtmrID].used = 0;
+    g_fakeSwtmr[swtmrID].active = 0;
+
+    return LOS_OK;
+}
+
+UINT32 FakeSwtmrRun(VOID)
+{
+    UINT64 now = LOS_TickCountGet();
+    UINT32 runs = 0;
+
+    for (UINT32 i = 0; i < FAKE_SWTMR_MAX; i++) {
+        /* the handler may stop or delete its own timer */
+        while (g_fakeSwtmr[i].active && g_fakeSwtmr[i].expiry <= now) {
+            g_fakeSwtmr[i].expiry += g_fakeSwtmr[i].interval;
+            if (g_fakeSwtmr[i].mode == LOS_SWTMR_MODE_ONCE) {
+                g_fakeSwtmr[i].active = 0;
+            }
+            g_fakeSwtmr[i].handler(g_fakeSwtmr[i].arg);
+            runs++;
+        }
+    }
+
+    return runs;
+}
+
+int FakeSwtmrActive(UINT32 swtmrID)
+{
+    return swtmrID < FAKE_SWTMR_MAX && g_fakeSwtmr[swtmrID].active;
+}
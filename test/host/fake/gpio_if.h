@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Host stand-in for the HDF GPIO interface. fake_hdf.c maps the HDF indexes of board_config.h to the
+ * simulated port registers of B91/gpio.h, the way the B91 GPIO driver does on the device.
+ */
+
+#ifndef HOST_FAKE_GPIO_IF_H
+#define HOST_FAKE_GPIO_IF_H
+
+#include <stdint.h>
+
+enum GpioValue {
+    GPIO_VAL_LOW = 0,
+    GPIO_VAL_HIGH = 1,
+    GPIO_VAL_ERR,
+};
+
+enum GpioDirType {
+    GPIO_DIR_IN = 0,
+    GPIO_DIR_OUT = 1,
+    GPIO_DIR_ERR,
+};
+
+#define GPIO_IRQ_TRIGGER_RISING     1
+#define GPIO_IRQ_TRIGGER_FALLING    2
+
+typedef int32_t (*GpioIrqFunc)(uint16_t gpio, void *data);
+
+int32_t GpioRead(uint16_t gpio, uint16_t *val);
+int32_t GpioWrite(uint16_t gpio, uint16_t val);
+int32_t GpioSetDir(uint16_t gpio, uint16_t dir);
+int32_t GpioGetDir(uint16_t gpio, uint16_t *dir);
+int32_t GpioSetIrq(uint16_t gpio, uint16_t mode, GpioIrqFunc func, void *arg);
+int32_t GpioUnsetIrq(uint16_t gpio, void *arg);
+int32_t GpioEnableIrq(uint16_t gpio);
+int32_t GpioDisableIrq(uint16_t gpio);
+
+/**
+ * @brief      Drive an input pin from outside, as a button would; the IRQ handler runs on a matching edge
+ * @param[in]  gpio  HDF GPIO index
+ * @param[in]  val   new level
+ */
+void FakeGpioSetInput(uint16_t gpio, uint16_t val);
+
+/* HDF calls made so far, host only */
+extern uint32_t g_fakeHdfGpioCalls;
+
+#endif /* HOST_FAKE_GPIO_IF_H */
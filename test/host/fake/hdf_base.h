@@ -0,0 +1,28 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Host stand-in for hdf_base.h of the HDF */
+
+#ifndef HOST_FAKE_HDF_BASE_H
+#define HOST_FAKE_HDF_BASE_H
+
+#define HDF_SUCCESS         0
+#define HDF_FAILURE         (-1)
+#define HDF_ERR_NOT_SUPPORT (-2)
+
+#endif /* HOST_FAKE_HDF_BASE_H */
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Host stand-in for hiview_log.h. Lines are kept in memory so tests can look for them, and printed
+ * when HOST_LOG is set in the environment. HiLogPrintf() is format checked, as the macros of the
+ * device build are.
+ */
+
+#ifndef HOST_FAKE_HIVIEW_LOG_H
+#define HOST_FAKE_HIVIEW_LOG_H
+
+#include <stdint.h>
+
+typedef enum {
+    HILOG_MODULE_HIVIEW = 0,
+    HILOG_MODULE_SAMGR,
+    HILOG_MODULE_APP,
+    HILOG_MODULE_MAX,
+} HiLogModuleType;
+
+typedef enum {
+    HILOG_LV_DEBUG = 2,
+    HILOG_LV_INFO,
+    HILOG_LV_WARN,
+    HILOG_LV_ERROR,
+    HILOG_LV_FATAL,
+} HiLogLevel;
+
+void HiLogPrintf(uint8_t module, uint8_t level, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#define HILOG_DEBUG(mod, fmt, ...)  HiLogPrintf(mod, HILOG_LV_DEBUG, fmt, ##__VA_ARGS__)
+#define HILOG_INFO(mod, fmt, ...)   HiLogPrintf(mod, HILOG_LV_INFO, fmt, ##__VA_ARGS__)
+#define HILOG_WARN(mod, fmt, ...)   HiLogPrintf(mod, HILOG_LV_WARN, fmt, ##__VA_ARGS__)
+#define HILOG_ERROR(mod, fmt, ...)  HiLogPrintf(mod, HILOG_LV_ERROR, fmt, ##__VA_ARGS__)
+#define HILOG_FATAL(mod, fmt, ...)  HiLogPrintf(mod, HILOG_LV_FATAL, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief      Forget the lines logged so far
+ */
+void FakeLogClear(void);
+
+/**
+ * @brief      Number of lines logged since FakeLogClear() that contain needle
+ */
+unsigned FakeLogCount(const char *needle);
+
+/**
+ * @brief      Last line logged since FakeLogClear() that contains needle, NULL if none
+ */
+const char *FakeLogFind(const char *needle);
+
+#endif /* HOST_FAKE_HIVIEW_LOG_H */
@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Host stand-in for los_compiler.h of LiteOS-M */
+
+#ifndef HOST_FAKE_LOS_COMPILER_H
+#define HOST_FAKE_LOS_COMPILER_H
+
+#include <stdint.h>
+
+typedef unsigned char UINT8;
+typedef unsigned short UINT16;
+typedef unsigned int UINT32;
+typedef unsigned long long UINT64;
+typedef signed int INT32;
+typedef char CHAR;
+typedef void VOID;
+typedef uintptr_t UINTPTR;
+
+#define STATIC  static
+#define INLINE  static inline
+
+#define LOS_OK  0U
+#define LOS_NOK 1U
+#define LOS_WAIT_FOREVER    0xFFFFFFFFU
+
+#ifndef UNUSED
+#ifndef UNUSED
+#define UNUSED(var) do { (void)(var); } while (0)
+#endif
+#endif
+
+#endif /* HOST_FAKE_LOS_COMPILER_H */
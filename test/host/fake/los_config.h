@@ -0,0 +1,32 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Host stand-in for los_config.h of LiteOS-M */
+
+#ifndef HOST_FAKE_LOS_CONFIG_H
+#define HOST_FAKE_LOS_CONFIG_H
+
+#include <los_compiler.h>
+
+#define LOSCFG_BASE_CORE_TICK_PER_SECOND            1000
+#define LOSCFG_BASE_CORE_TSK_DEFAULT_STACK_SIZE     0x800
+#define LOSCFG_BASE_CORE_TSK_MIN_STACK_SIZE         0x200
+#define LOSCFG_BASE_CORE_TSK_DEFAULT_PRIO           10
+#define OS_TASK_PRIORITY_LOWEST                     31
+
+#endif /* HOST_FAKE_LOS_CONFIG_H */
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Host stand-in for los_event.h of LiteOS-M, events are recorded and never block */
+
+#ifndef HOST_FAKE_LOS_EVENT_H
+#define HOST_FAKE_LOS_EVENT_H
+
+#include <los_config.h>
+
+#define LOS_WAITMODE_AND    4U
+#define LOS_WAITMODE_OR     2U
+#define LOS_WAITMODE_CLR    1U
+
+typedef struct {
+    UINT32 uwEventID;
+    /* Number of LOS_EventWrite() calls, host only */
+    UINT32 writes;
+} EVENT_CB_S;
+
+/* LOS_EventWrite() calls on any event, host only */
+extern UINT32 g_fakeEventWrites;
+
+UINT32 LOS_EventInit(EVENT_CB_S *eventCB);
+UINT32 LOS_EventWrite(EVENT_CB_S *eventCB, UINT32 events);
+UINT32 LOS_EventRead(EVENT_CB_S *eventCB, UINT32 eventMask, UINT32 mode, UINT32 timeout);
+
+#endif /* HOST_FAKE_LOS_EVENT_H */
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Host stand-in for los_swtmr.h of LiteOS-M. Timers never fire on their own, tests call
+ * FakeSwtmrRun() to run due timers after moving the simulated clock.
+ */
+
+#ifndef HOST_FAKE_LOS_SWTMR_H
+#define HOST_FAKE_LOS_SWTMR_H
+
+#include <los_config.h>
+
+#define LOS_SWTMR_MODE_ONCE     0
+#define LOS_SWTMR_MODE_PERIOD   1
+
+#define LOS_ERRNO_SWTMR_ID_INVALID  0x02000301U
+
+typedef VOID (*SWTMR_PROC_FUNC)(UINTPTR arg);
+
+UINT32 LOS_SwtmrCreate(UINT32 interval, UINT8 mode, SWTMR_PROC_FUNC handler, UINT32 *swtmrID, UINTPTR arg);
+UINT32 LOS_SwtmrStart(UINT32 swtmrID);
+UINT32 LOS_SwtmrStop(UINT32 swtmrID);
+UINT32 LOS_SwtmrDelete(UINT32 swtmrID);
+
+/**
+ * @brief      Run the handlers of started timers that are due at the current tick
+ * @return     number of handlers run
+ */
+UINT32 FakeSwtmrRun(VOID);
+
+/**
+ * @brief      Whether a timer is started, host only
+ */
+int FakeSwtmrActive(UINT32 swtmrID);
+
+#endif /* HOST_FAKE_LOS_SWTMR_H */
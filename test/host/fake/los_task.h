@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Host stand-in for los_task.h of LiteOS-M. Tasks are recorded but never scheduled: host tests
+ * call the work functions of a task directly.
+ */
+
+#ifndef HOST_FAKE_LOS_TASK_H
+#define HOST_FAKE_LOS_TASK_H
+
+#include <los_config.h>
+
+typedef VOID *(*TSK_ENTRY_FUNC)(UINT32 arg);
+
+typedef struct {
+    TSK_ENTRY_FUNC pfnTaskEntry;
+    UINT16 usTaskPrio;
+    UINT32 uwArg;
+    UINT32 uwStackSize;
+    CHAR *pcName;
+    UINT32 uwResved;
+} TSK_INIT_PARAM_S;
+
+#define FAKE_TASK_MAX 16
+
+/* Tasks created so far, in creation order */
+extern TSK_INIT_PARAM_S g_fakeTasks[FAKE_TASK_MAX];
+extern UINT32 g_fakeTaskCount;
+
+UINT32 LOS_TaskCreate(UINT32 *taskID, TSK_INIT_PARAM_S *taskInitParam);
+UINT32 LOS_TaskDelay(UINT32 tick);
+UINT32 LOS_Msleep(UINT32 msecs);
+VOID LOS_TaskLock(VOID);
+VOID LOS_TaskUnlock(VOID);
+
+#endif /* HOST_FAKE_LOS_TASK_H */
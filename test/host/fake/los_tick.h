@@ -0,0 +1,31 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Host stand-in for los_tick.h of LiteOS-M, the tick follows the simulated system timer */
+
+#ifndef HOST_FAKE_LOS_TICK_H
+#define HOST_FAKE_LOS_TICK_H
+
+#include <los_config.h>
+
+#define OS_SYS_MS_PER_SECOND    1000
+
+UINT64 LOS_TickCountGet(VOID);
+UINT32 LOS_MS2Tick(UINT32 millisec);
+
+#endif /* HOST_FAKE_LOS_TICK_H */
@@ -0,0 +1,507 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "sim_controller.h"
+
+#define SIM_CONN_UNIT_US        1250
+#define SIM_ADV_UNIT_US         625
+#define SIM_ADV_DELAY_AVG_US    5000
+#define SIM_ADV_CHANNELS        3
+#define SIM_ADV_PDU_OVERHEAD    16
+#define SIM_ADV_RX_WINDOW_US    250
+
+typedef enum {
+    SIM_EVT_CONNECT,
+    SIM_EVT_DISCONNECT,
+    SIM_EVT_CONN_UPDATE,
+    SIM_EVT_PHY_UPDATE,
+} SimEvtType;
+
+typedef struct {
+    u8 type;
+    u8 reason;
+    u8 phy;
+    u16 connHandle;
+    u16 interval;
+    u16 latency;
+    u16 timeout;
+} SimEvt;
+
+SimController g_sim;
+
+static struct {
+    SimEvt evt[SIM_MAX_PENDING];
+    u32 count;
+} g_simPending;
+
+void SimInit(void)
+{
+    memset(&g_sim, 0, sizeof(g_sim));
+    memset(&g_simPending, 0, sizeof(g_simPending));
+
+    g_sim.packetsPerEvent = 4;
+    g_sim.peerMtu = 247;
+    g_sim.rxMtu = 23;
+    g_sim.acceptParamReq = 1;
+    g_sim.acceptPhyReq = 1;
+    g_sim.startTick = clock_time();
+}
+
+SimConn *SimGetConn(u16 connHandle)
+{
+    for (int i = 0; i < SIM_MAX_CONN; i++) {
+        if (g_sim.conn[i].used && g_sim.conn[i].connHandle == connHandle) {
+            return &g_sim.conn[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void SimQueue(const SimEvt *evt)
+{
+    if (g_simPending.count < SIM_MAX_PENDING) {
+        g_simPending.evt[g_simPending.count++] = *evt;
+    }
+}
+
+u16 SimConnect(u16 interval, u16 latency, u16 timeout)
+{
+    for (int i = 0; i < SIM_MAX_CONN; i++) {
+        SimConn *conn = &g_sim.conn[i];
+        if (conn->used) {
+            continue;
+        }
+
+        memset(conn, 0, sizeof(*conn));
+        conn->used = 1;
+#if TELINK_SDK_B91_BLE_SINGLE
+        conn->connHandle = BLS_CONN_HANDLE;
+#else
+        conn->connHandle = 0x80 + i;
+#endif
+        conn->interval = interval;
+        conn->latency = latency;
+        conn->timeout = timeout;
+        conn->mtu = 23;
+        conn->txPhy = BLE_PHY_1M;
+        conn->rssi = -60;
+        conn->nextEventTick = clock_time() + interval * SIM_CONN_UNIT_US * SYSTEM_TIMER_TICK_1US;
+
+        SimEvt evt = {.type = SIM_EVT_CONNECT, .connHandle = conn->connHandle};
+        SimQueue(&evt);
+
+        return conn->connHandle;
+    }
+
+    return 0xFFFF;
+}
+
+void SimQueueDisconnect(u16 connHandle, u8 reason)
+{
+    SimEvt evt = {.type = SIM_EVT_DISCONNECT, .connHandle = connHandle, .reason = reason};
+
+    SimQueue(&evt);
+}
+
+void SimDisconnect(u16 connHandle, u8 reason)
+{
+    SimQueueDisconnect(connHandle, reason);
+}
+
+void SimQueueConnUpdate(u16 connHandle, u16 interval, u16 latency, u16 timeout)
+{
+    SimEvt evt = {
+        .type = SIM_EVT_CONN_UPDATE,
+        .connHandle = connHandle,
+        .interval = interval,
+        .latency = latency,
+        .timeout = timeout,
+    };
+
+    SimQueue(&evt);
+}
+
+void SimConnUpdate(u16 connHandle, u16 interval, u16 latency, u16 timeout)
+{
+    SimQueueConnUpdate(connHandle, interval, latency, timeout);
+}
+
+void SimQueuePhyUpdate(u16 connHandle, u8 phy)
+{
+    SimEvt evt = {.type = SIM_EVT_PHY_UPDATE, .connHandle = connHandle, .phy = phy};
+
+    SimQueue(&evt);
+}
+
+void SimPhyUpdate(u16 connHandle, u8 phy)
+{
+    SimQueuePhyUpdate(connHandle, phy);
+}
+
+void SimSetRssi(u16 connHandle, s8 dbm)
+{
+    SimConn *conn = SimGetConn(connHandle);
+
+    if (conn != NULL) {
+        conn->rssi = dbm;
+    }
+}
+
+static void SimHciEvent(u32 mask, u32 event, void *param, int len)
+{
+    if (g_sim.hciHandler != NULL && (g_sim.hciEventMask & mask)) {
+        g_sim.hciHandler(event, (u8 *)param, len);
+    }
+}
+
+static void SimDeliverConnect(SimConn *conn)
+{
+    conn->up = 1;
+
+#if TELINK_SDK_B91_BLE_SINGLE
+    /* the single connection controller stops advertising once connected */
+    g_sim.advEnabled = 0;
+
+    rf_packet_connect_t pkt = {0};
+    pkt.interval = conn->interval;
+    pkt.latency = conn->latency;
+    pkt.timeout = conn->timeout;
+    pkt.initA[0] = (u8)conn->connHandle;
+    if (g_sim.evtCb[BLT_EV_FLAG_CONNECT] != NULL) {
+        g_sim.evtCb[BLT_EV_FLAG_CONNECT](BLT_EV_FLAG_CONNECT, (u8 *)&pkt, sizeof(pkt));
+    }
+#else
+    hci_le_connectionCompleteEvt_t evt = {
+        .subEventCode = HCI_SUB_EVT_LE_CONNECTION_COMPLETE,
+        .status = BLE_SUCCESS,
+        .connHandle = conn->connHandle,
+        .role = LL_ROLE_SLAVE,
+        .connInterval = conn->interval,
+        .slaveLatency = conn->latency,
+        .supervisionTimeout = conn->timeout,
+    };
+    evt.peerAddr[0] = (u8)conn->connHandle;
+    SimHciEvent(HCI_LE_EVT_MASK_CONNECTION_COMPLETE, HCI_FLAG_EVENT_BT_STD | HCI_EVT_LE_META, &evt, sizeof(evt));
+#endif
+}
+
+static void SimDeliverDisconnect(SimConn *conn, u8 reason)
+{
+    int up = conn->up;
+
+    conn->used = 0;
+    conn->up = 0;
+    if (!up) {
+        return;
+    }
+
+#if TELINK_SDK_B91_BLE_SINGLE
+    if (g_sim.evtCb[BLT_EV_FLAG_TERMINATE] != NULL) {
+        g_sim.evtCb[BLT_EV_FLAG_TERMINATE](BLT_EV_FLAG_TERMINATE, &reason, 1);
+    }
+#else
+    event_disconnection_t evt = {
+        .status = BLE_SUCCESS,
+        .connHandle = conn->connHandle,
+        .reason = reason,
+    };
+    SimHciEvent(HCI_EVT_MASK_DISCONNECTION_COMPLETE, HCI_FLAG_EVENT_BT_STD | HCI_EVT_DISCONNECTION_COMPLETE, &evt,
+                sizeof(evt));
+#endif
+}
+
+static void SimDeliverConnUpdate(SimConn *conn, const SimEvt *e)
+{
+    conn->interval = e->interval;
+    conn->latency = e->latency;
+    conn->timeout = e->timeout;
+
+#if TELINK_SDK_B91_BLE_SINGLE
+    u8 param[6] = {
+        U16_LO(e->interval), U16_HI(e->interval), U16_LO(e->latency), U16_HI(e->latency),
+        U16_LO(e->timeout), U16_HI(e->timeout),
+    };
+    if (g_sim.evtCb[BLT_EV_FLAG_CONN_PARA_UPDATE] != NULL) {
+        g_sim.evtCb[BLT_EV_FLAG_CONN_PARA_UPDATE](BLT_EV_FLAG_CONN_PARA_UPDATE, param, sizeof(param));
+    }
+#else
+    hci_le_connectionUpdateCompleteEvt_t evt = {
+        .subEventCode = HCI_SUB_EVT_LE_CONNECTION_UPDATE_COMPLETE,
+        .status = BLE_SUCCESS,
+        .connHandle = conn->connHandle,
+        .connInterval = e->interval,
+        .connLatency = e->latency,
+        .supervisionTimeout = e->timeout,
+    };
+    SimHciEvent(HCI_LE_EVT_MASK_CONNECTION_UPDATE_COMPLETE, HCI_FLAG_EVENT_BT_STD | HCI_EVT_LE_META, &evt,
+                sizeof(evt));
+#endif
+}
+
+static void SimDeliverPhyUpdate(SimConn *conn, u8 phy)
+{
+    conn->txPhy = phy;
+
+    hci_le_phyUpdateCompleteEvt_t evt = {
+        .subEventCode = HCI_SUB_EVT_LE_PHY_UPDATE_COMPLETE,
+        .status = BLE_SUCCESS,
+        .connHandle = conn->connHandle,
+        .tx_phy = phy,
+        .rx_phy = phy,
+    };
+    SimHciEvent(HCI_LE_EVT_MASK_PHY_UPDATE_COMPLETE, HCI_FLAG_EVENT_BT_STD | HCI_EVT_LE_META, &evt, sizeof(evt));
+}
+
+static void SimDeliverEvents(void)
+{
+    /* callbacks may queue further events, they are delivered by the next pass */
+    u32 count = g_simPending.count;
+    SimEvt evts[SIM_MAX_PENDING];
+
+    memcpy(evts, g_simPending.evt, count * sizeof(SimEvt));
+    g_simPending.count = 0;
+
+    for (u32 i = 0; i < count; i++) {
+        const SimEvt *e = &evts[i];
+        SimConn *conn = SimGetConn(e->connHandle);
+        if (conn == NULL) {
+            continue;
+        }
+
+        if (e->type == SIM_EVT_CONNECT) {
+            SimDeliverConnect(conn);
+        } else if (!conn->up) {
+            continue;
+        } else if (e->type == SIM_EVT_DISCONNECT) {
+            SimDeliverDisconnect(conn, e->reason);
+        } else if (e->type == SIM_EVT_CONN_UPDATE) {
+            SimDeliverConnUpdate(conn, e);
+        } else if (e->type == SIM_EVT_PHY_UPDATE) {
+            SimDeliverPhyUpdate(conn, e->phy);
+        }
+    }
+}
+
+/**
+ * @brief      Run the connection events that are due: each acknowledges up to packetsPerEvent packets
+ */
+static void SimRunConnEvents(u32 now)
+{
+    for (int i = 0; i < SIM_MAX_CONN; i++) {
+        SimConn *conn = &g_sim.conn[i];
+        if (!conn->up || conn->interval == 0) {
+            continue;
+        }
+
+        u32 period = conn->interval * SIM_CONN_UNIT_US * SYSTEM_TIMER_TICK_1US;
+        if ((s32)(now - conn->nextEventTick) < 0) {
+            continue;
+        }
+
+        u32 events = (now - conn->nextEventTick) / period + 1;
+        u32 acked = events * g_sim.packetsPerEvent;
+        conn->txFifo = (acked >= conn->txFifo) ? 0 : (u8)(conn->txFifo - acked);
+        conn->connEvents += events;
+        conn->nextEventTick += events * period;
+    }
+}
+
+static int SimAdvertising(void)
+{
+    int up = 0;
+
+    for (int i = 0; i < SIM_MAX_CONN; i++) {
+        up += g_sim.conn[i].up;
+    }
+
+#if TELINK_SDK_B91_BLE_SINGLE
+    return g_sim.advEnabled && up == 0;
+#else
+    return g_sim.advEnabled && (g_sim.maxSlaves == 0 || up < g_sim.maxSlaves);
+#endif
+}
+
+/**
+ * @brief      Run the advertising events that are due and account their radio on-time
+ */
+static void SimRunAdvEvents(u32 now)
+{
+    if (!SimAdvertising() || g_sim.advIntervalMin == 0) {
+        return;
+    }
+
+    u32 eventUs = SIM_ADV_CHANNELS * ((SIM_ADV_PDU_OVERHEAD + g_sim.advDataLen) * 8 + SIM_ADV_RX_WINDOW_US);
+    u32 period = (g_sim.advIntervalMin * SIM_ADV_UNIT_US + SIM_ADV_DELAY_AVG_US) * SYSTEM_TIMER_TICK_1US;
+
+    if ((s32)(now - g_sim.nextAdvTick) < 0) {
+        return;
+    }
+
+    u32 events = (now - g_sim.nextAdvTick) / period + 1;
+    g_sim.advEvents += events;
+    g_sim.advRadioUs += (u64)events * eventUs;
+    g_sim.nextAdvTick += events * period;
+}
+
+void SimMainLoop(void)
+{
+    u32 now = clock_time();
+
+    g_sim.mainLoops++;
+    SimRunConnEvents(now);
+    SimRunAdvEvents(now);
+    SimDeliverEvents();
+}
+
+void SimIrq(void)
+{
+    g_sim.irqs++;
+}
+
+u32 SimAdvDutyPermille(void)
+{
+    u64 elapsedUs = (clock_time() - g_sim.startTick) / SYSTEM_TIMER_TICK_1US;
+
+    return (elapsedUs == 0) ? 0 : (u32)(g_sim.advRadioUs * 1000 / elapsedUs);
+}
+
+static const attribute_t *SimAttFind(u16 attHandle)
+{
+    if (g_sim.attTable == NULL || attHandle == 0 || attHandle > g_sim.attTable[0].attNum) {
+        return NULL;
+    }
+
+    return &g_sim.attTable[attHandle];
+}
+
+static int SimAttCall(att_readwrite_callback_t cb, u16 connHandle, u8 *pkt)
+{
+#if TELINK_SDK_B91_BLE_MULTI
+    return cb(connHandle, pkt);
+#else
+    UNUSED(connHandle);
+    return cb(pkt);
+#endif
+}
+
+int SimAttServe(u16 connHandle, u8 *pkt)
+{
+    rf_packet_att_read_t *req = (rf_packet_att_read_t *)pkt;
+    u16 attHandle = MAKE_U16(req->handle1, req->handle);
+    const attribute_t *att = SimAttFind(attHandle);
+
+    if (req->chanId != L2CAP_CID_ATTR_PROTOCOL || att == NULL) {
+        return -1;
+    }
+
+    if (req->opcode == ATT_OP_WRITE_REQ || req->opcode == ATT_OP_WRITE_CMD) {
+        if (!(att->perm & ATT_PERMISSIONS_WRITE)) {
+            return -1;
+        }
+
+        /* the stack stores the value itself only for attributes without a write callback */
+        if (att->w != NULL) {
+            return SimAttCall(att->w, connHandle, pkt);
+        }
+
+        rf_packet_att_write_t *wr = (rf_packet_att_write_t *)pkt;
+        u32 len = min((u32)(wr->l2capLen - 3), att->attrLen);
+        memcpy(att->pAttrValue, &wr->value, len);
+        return 0;
+    }
+
+    if (req->opcode == ATT_OP_READ_REQ) {
+        if (!(att->perm & ATT_PERMISSIONS_READ)) {
+            return -1;
+        }
+
+        int ret = 0;
+        if (att->r != NULL) {
+            ret = SimAttCall(att->r, connHandle, pkt);
+        }
+
+        g_sim.readLen = (u16)min(att->attrLen, (u32)sizeof(g_sim.readBuf));
+        memcpy(g_sim.readBuf, att->pAttrValue, g_sim.readLen);
+        return ret;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief      Hand a request to the host the way the controller does, through the registered data handler
+ */
+static int SimL2capDeliver(u16 connHandle, u8 *pkt)
+{
+    if (g_sim.dataHandler == NULL) {
+        return -1;
+    }
+
+    return g_sim.dataHandler(connHandle, pkt);
+}
+
+int SimL2capRx(u16 connHandle, u8 *pkt)
+{
+    return SimL2capDeliver(connHandle, pkt);
+}
+
+int SimAttWrite(u16 connHandle, u16 attHandle, const u8 *data, u16 len)
+{
+    u8 buf[sizeof(rf_packet_att_write_t) + 512];
+    rf_packet_att_write_t *pkt = (rf_packet_att_write_t *)buf;
+
+    if (len > 512) {
+        return -1;
+    }
+
+    memset(buf, 0, sizeof(buf));
+    pkt->rf_len = (u8)(len + 7);
+    pkt->l2capLen = len + 3;
+    pkt->chanId = L2CAP_CID_ATTR_PROTOCOL;
+    pkt->opcode = ATT_OP_WRITE_REQ;
+    pkt->handle = U16_LO(attHandle);
+    pkt->handle1 = U16_HI(attHandle);
+    memcpy(&pkt->value, data, len);
+
+    return SimL2capDeliver(connHandle, buf);
+}
+
+int SimAttRead(u16 connHandle, u16 attHandle, u8 *buf, u16 size)
+{
+    rf_packet_att_read_t pkt = {
+        .rf_len = 7,
+        .l2capLen = 3,
+        .chanId = L2CAP_CID_ATTR_PROTOCOL,
+        .opcode = ATT_OP_READ_REQ,
+        .handle = U16_LO(attHandle),
+        .handle1 = U16_HI(attHandle),
+    };
+
+    g_sim.readLen = 0;
+    if (SimAttFind(attHandle) == NULL || SimL2capDeliver(connHandle, (u8 *)&pkt) < 0) {
+        return -1;
+    }
+
+    u16 len = min(g_sim.readLen, size);
+    memcpy(buf, g_sim.readBuf, len);
+
+    return len;
+}
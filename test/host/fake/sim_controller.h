@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Simulated BLE controller behind the fake SDK of stack/ble/ble.h.
+ *
+ * Tests inject link events (connect, disconnect, parameter and PHY updates, ATT requests). As on the
+ * device, link events reach the host layers from the SDK main loop, so they are queued here and
+ * delivered by the next blt_sdk_main_loop()/blc_sdk_main_loop() call. The main loop also runs the
+ * connection events that are due on the simulated clock: each one acknowledges up to
+ * packetsPerEvent packets of the TX FIFO of the link.
+ */
+
+#ifndef HOST_FAKE_SIM_CONTROLLER_H
+#define HOST_FAKE_SIM_CONTROLLER_H
+
+#include <stack/ble/ble.h>
+
+#define SIM_MAX_CONN        8
+#define SIM_MAX_PENDING     16
+
+typedef struct {
+    u8 used;
+    /** connect event delivered to the host */
+    u8 up;
+    u16 connHandle;
+    u16 interval;
+    u16 latency;
+    u16 timeout;
+    u16 mtu;
+    u8 txPhy;
+    s8 rssi;
+    /** packets waiting in the ACL TX FIFO */
+    u8 txFifo;
+    u32 nextEventTick;
+    u32 connEvents;
+    /** notifications accepted into and refused by the TX FIFO */
+    u32 notifyOk;
+    u32 notifyRefused;
+    /** notifications pushed while the client characteristic configuration had them disabled */
+    u32 notifyNoCcc;
+    u32 notifyBytes;
+    u16 lastNotifyHandle;
+    u16 lastNotifyLen;
+    /** head of the last notification */
+    u8 lastNotifyData[8];
+    /** last L2CAP connection parameter update request */
+    u32 paramReqs;
+    u16 paramReqMin;
+    u16 paramReqMax;
+    u16 paramReqLatency;
+    u16 paramReqTimeout;
+    /** last LL PHY request */
+    u32 phyReqs;
+    u8 phyReq;
+    /** local disconnect request, 0 if none */
+    u8 terminateReason;
+} SimConn;
+
+typedef struct {
+    /* advertising */
+    u8 advEnabled;
+    u16 advIntervalMin;
+    u16 advIntervalMax;
+    u8 advDataLen;
+    u8 scanRspLen;
+    u32 advParamCalls;
+    u32 advEnableCalls;
+    /** fail the next uni_ble_ll_setAdvParam() with this status, 0 for none */
+    ble_sts_t advParamFail;
+    /** advertising events run so far and their radio on-time, see SimAdvDutyPermille() */
+    u32 advEvents;
+    u64 advRadioUs;
+    u32 nextAdvTick;
+    u32 startTick;
+
+    /* buffers and configuration */
+    u8 txFifoNum;
+    u8 rxFifoNum;
+    u8 maxRxOctets;
+    u8 maxTxOctets;
+    u16 rxMtu;
+    u8 maxSlaves;
+    u32 hciEventMask;
+    u32 appBufferChecks;
+    const attribute_t *attTable;
+    /** wake-up the stack scheduled before deepSleep retention */
+    u32 pmWakeupTick;
+
+    /* host callbacks registered with the SDK */
+#if TELINK_SDK_B91_BLE_SINGLE
+    blt_event_callback_t evtCb[BLT_EV_MAX_NUM];
+    int (*dataHandler)(u16 connHandle, u8 *p);
+#else
+    blc_hci_data_handler_t dataHandler;
+#endif
+    hci_event_handler_t hciHandler;
+
+    /* link */
+    /** peer behaviour: packets acknowledged per connection event, ATT MTU, automatic acceptance */
+    u8 packetsPerEvent;
+    u16 peerMtu;
+    u8 acceptParamReq;
+    u8 acceptPhyReq;
+    /** called for every notification accepted into a TX FIFO, NULL for none */
+    void (*notifyHook)(u16 connHandle, u16 attHandle, const u8 *p, u16 len);
+    /** value of the last ATT read */
+    u8 readBuf[512];
+    u16 readLen;
+    SimConn conn[SIM_MAX_CONN];
+    u32 terminateRequests;
+    u32 irqs;
+    u32 mainLoops;
+} SimController;
+
+extern SimController g_sim;
+
+/**
+ * @brief      Reset the controller and the SDK callbacks, the simulated clock keeps running
+ * @return     none
+ */
+void SimInit(void);
+
+/**
+ * @brief      Queue a connection from a central
+ * @param[in]  interval  connection interval (1.25 ms units)
+ * @param[in]  latency   peripheral latency
+ * @param[in]  timeout   supervision timeout (10 ms units)
+ * @return     connection handle
+ */
+u16 SimConnect(u16 interval, u16 latency, u16 timeout);
+
+void SimDisconnect(u16 connHandle, u8 reason);
+
+void SimConnUpdate(u16 connHandle, u16 interval, u16 latency, u16 timeout);
+
+void SimPhyUpdate(u16 connHandle, u8 phy);
+
+void SimSetRssi(u16 connHandle, s8 dbm);
+
+/**
+ * @brief      Write an attribute value as a central would, the handler runs immediately
+ * @return     value returned by the write callback, or 0
+ */
+int SimAttWrite(u16 connHandle, u16 attHandle, const u8 *data, u16 len);
+
+/**
+ * @brief      Read an attribute value as a central would
+ * @return     value length copied to buf, -1 for an unknown handle
+ */
+int SimAttRead(u16 connHandle, u16 attHandle, u8 *buf, u16 size);
+
+/**
+ * @brief      Hand an L2CAP packet to the registered data handler
+ */
+int SimL2capRx(u16 connHandle, u8 *pkt);
+
+SimConn *SimGetConn(u16 connHandle);
+
+/**
+ * @brief      Advertising duty cycle since SimInit(), in permille of the simulated time
+ */
+u32 SimAdvDutyPermille(void);
+
+/* Used by fake_ble.c */
+void SimMainLoop(void);
+
+void SimIrq(void);
+
+void SimQueueDisconnect(u16 connHandle, u8 reason);
+
+void SimQueueConnUpdate(u16 connHandle, u16 interval, u16 latency, u16 timeout);
+
+void SimQueuePhyUpdate(u16 connHandle, u8 phy);
+
+/**
+ * @brief      ATT server of the fake SDK, runs the requests handed back by the L2CAP data handler
+ */
+int SimAttServe(u16 connHandle, u8 *pkt);
+
+#endif /* HOST_FAKE_SIM_CONTROLLER_H */
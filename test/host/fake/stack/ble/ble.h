@@ -0,0 +1,358 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Host stand-in for stack/ble/ble.h of the Telink B91 BLE SDKs. Declares the subset of the single
+ * connection (TELINK_SDK_B91_BLE_SINGLE) and multi connection (TELINK_SDK_B91_BLE_MULTI) APIs that the
+ * vendor code uses. fake_ble.c implements them on top of the simulated controller of sim_controller.h.
+ */
+
+#ifndef HOST_FAKE_STACK_BLE_BLE_H
+#define HOST_FAKE_STACK_BLE_BLE_H
+
+#include <tl_common.h>
+#include <drivers.h>
+
+#if !(TELINK_SDK_B91_BLE_SINGLE) == !(TELINK_SDK_B91_BLE_MULTI)
+#error "define exactly one of TELINK_SDK_B91_BLE_SINGLE and TELINK_SDK_B91_BLE_MULTI"
+#endif
+
+typedef u8 ble_sts_t;
+
+#define BLE_SUCCESS                             0x00
+#define HCI_ERR_UNKNOWN_CONN_ID                 0x02
+#define HCI_ERR_CONN_REJ_LIMITED_RESOURCES      0x0D
+#define HCI_ERR_REMOTE_USER_TERM_CONN           0x13
+#define HCI_ERR_CONN_TERM_BY_LOCAL_HOST         0x16
+#define HCI_ERR_CONTROLLER_BUSY                 0x3A
+#define LL_ERR_TX_FIFO_NOT_ENOUGH               0x40
+#define LL_ERR_INVALID_PARAMETER                0x41
+
+/* Buffer sizes, see the DLE section of the SDK handbook */
+#define CAL_LL_ACL_RX_FIFO_SIZE(maxRxOct)       ((((maxRxOct) + 22) + 15) / 16 * 16)
+#define CAL_LL_ACL_TX_FIFO_SIZE(maxTxOct)       ((((maxTxOct) + 10) + 15) / 16 * 16)
+#define CAL_MTU_BUFF_SIZE(n)                    ((((n) + 6) + 3) / 4 * 4)
+
+/* Advertising */
+typedef enum {
+    ADV_TYPE_CONNECTABLE_UNDIRECTED = 0x00,
+    ADV_TYPE_NONCONNECTABLE_UNDIRECTED = 0x03,
+} adv_type_t;
+
+typedef enum {
+    OWN_ADDRESS_PUBLIC = 0,
+    OWN_ADDRESS_RANDOM = 1,
+} own_addr_type_t;
+
+typedef enum {
+    BLT_ENABLE_ADV_37 = BIT(0),
+    BLT_ENABLE_ADV_38 = BIT(1),
+    BLT_ENABLE_ADV_39 = BIT(2),
+    BLT_ENABLE_ADV_ALL = BLT_ENABLE_ADV_37 | BLT_ENABLE_ADV_38 | BLT_ENABLE_ADV_39,
+} adv_chn_map_t;
+
+typedef enum {
+    ADV_FP_NONE = 0,
+} adv_fp_type_t;
+
+#define BLC_ADV_DISABLE                         0x00
+#define BLC_ADV_ENABLE                          0x01
+
+#define ADV_INTERVAL_30MS                       48
+#define ADV_INTERVAL_35MS                       56
+
+/* Link layer */
+#define LL_ROLE_MASTER                          0
+#define LL_ROLE_SLAVE                           1
+#define LL_LENGTH_REQ                           0x14
+
+#define BLE_PHY_1M                              0x01
+#define BLE_PHY_2M                              0x02
+#define BLE_PHY_CODED                           0x03
+
+#define PHY_PREFER_1M                           BIT(0)
+#define PHY_PREFER_2M                           BIT(1)
+#define PHY_PREFER_CODED                        BIT(2)
+#define PHY_TRX_PREFER                          0
+
+typedef enum {
+    CODED_PHY_PREFER_NONE = 0,
+    CODED_PHY_PREFER_S2 = 1,
+    CODED_PHY_PREFER_S8 = 2,
+} le_ci_prefer_t;
+
+/* Power management */
+#define SUSPEND_ADV                             BIT(0)
+#define SUSPEND_CONN                            BIT(1)
+#define DEEPSLEEP_RETENTION_ADV                 BIT(2)
+#define DEEPSLEEP_RETENTION_CONN                BIT(3)
+
+/* HCI events */
+#define HCI_FLAG_EVENT_TLK_MODULE               BIT(24)
+#define HCI_FLAG_EVENT_BT_STD                   BIT(25)
+
+#define HCI_EVT_DISCONNECTION_COMPLETE          0x05
+#define HCI_EVT_LE_META                         0x3E
+
+#define HCI_SUB_EVT_LE_CONNECTION_COMPLETE          0x01
+#define HCI_SUB_EVT_LE_CONNECTION_UPDATE_COMPLETE   0x03
+#define HCI_SUB_EVT_LE_PHY_UPDATE_COMPLETE          0x0C
+
+#define HCI_EVT_MASK_DISCONNECTION_COMPLETE         BIT(4)
+#define HCI_LE_EVT_MASK_CONNECTION_COMPLETE         BIT(0)
+#define HCI_LE_EVT_MASK_CONNECTION_UPDATE_COMPLETE  BIT(2)
+#define HCI_LE_EVT_MASK_PHY_UPDATE_COMPLETE         BIT(11)
+
+typedef struct __attribute__((packed)) {
+    u8 status;
+    u16 connHandle;
+    u8 reason;
+} event_disconnection_t;
+
+typedef struct __attribute__((packed)) {
+    u8 subEventCode;
+    u8 status;
+    u16 connHandle;
+    u8 role;
+    u8 peerAddrType;
+    u8 peerAddr[6];
+    u16 connInterval;
+    u16 slaveLatency;
+    u16 supervisionTimeout;
+    u8 masterClkAccuracy;
+} hci_le_connectionCompleteEvt_t;
+
+typedef struct __attribute__((packed)) {
+    u8 subEventCode;
+    u8 status;
+    u16 connHandle;
+    u16 connInterval;
+    u16 connLatency;
+    u16 supervisionTimeout;
+} hci_le_connectionUpdateCompleteEvt_t;
+
+typedef struct __attribute__((packed)) {
+    u8 subEventCode;
+    u8 status;
+    u16 connHandle;
+    u8 tx_phy;
+    u8 rx_phy;
+} hci_le_phyUpdateCompleteEvt_t;
+
+typedef int (*hci_event_handler_t)(u32 h, u8 *para, int n);
+
+/* RF packets as seen by the host layers */
+typedef struct __attribute__((packed)) {
+    u8 type;
+    u8 rf_len;
+    u8 initA[6];
+    u8 advA[6];
+    u8 accessCode[4];
+    u8 crcinit[3];
+    u8 winSize;
+    u16 winOffset;
+    u16 interval;
+    u16 latency;
+    u16 timeout;
+    u8 chm[5];
+    u8 hop;
+    u8 txAddr;
+} rf_packet_connect_t;
+
+typedef struct __attribute__((packed)) {
+    u8 type;
+    u8 rf_len;
+    u16 l2capLen;
+    u16 chanId;
+    u8 opcode;
+    u8 data[1];
+} rf_packet_l2cap_t;
+
+typedef struct __attribute__((packed)) {
+    u8 type;
+    u8 rf_len;
+    u16 l2capLen;
+    u16 chanId;
+    u8 opcode;
+    u8 handle;
+    u8 handle1;
+    u8 value;
+} rf_packet_att_write_t;
+
+typedef struct __attribute__((packed)) {
+    u8 type;
+    u8 rf_len;
+    u16 l2capLen;
+    u16 chanId;
+    u8 opcode;
+    u8 handle;
+    u8 handle1;
+} rf_packet_att_read_t;
+
+#define ATT_OP_READ_REQ                         0x0A
+#define ATT_OP_WRITE_REQ                        0x12
+#define ATT_OP_WRITE_CMD                        0x52
+#define ATT_ERR_INVALID_PDU                     0x04
+#define L2CAP_CID_ATTR_PROTOCOL                 0x0004
+
+/* GATT */
+#define GATT_UUID_PRIMARY_SERVICE               0x2800
+#define GATT_UUID_CHARACTER                     0x2803
+#define GATT_UUID_CLIENT_CHAR_CFG               0x2902
+#define GATT_UUID_DEVICE_NAME                   0x2A00
+#define GATT_UUID_APPEARANCE                    0x2A01
+#define GATT_UUID_PERI_CONN_PARAM               0x2A04
+#define GATT_UUID_SERVICE_CHANGE                0x2A05
+
+#define SERVICE_UUID_GENERIC_ACCESS             0x1800
+#define SERVICE_UUID_GENERIC_ATTRIBUTE          0x1801
+#define SERVICE_UUID_DEVICE_INFORMATION         0x180A
+
+#define CHARACTERISTIC_UUID_MODEL_NUM_STRING    0x2A24
+#define CHARACTERISTIC_UUID_SERIAL_NUM_STRING   0x2A25
+#define CHARACTERISTIC_UUID_FW_REVISION_STRING  0x2A26
+#define CHARACTERISTIC_UUID_HW_REVISION_STRING  0x2A27
+#define CHARACTERISTIC_UUID_SW_REVISION_STRING  0x2A28
+#define CHARACTERISTIC_UUID_MANU_NAME_STRING    0x2A29
+#define CHARACTERISTIC_UUID_PNP_ID              0x2A50
+
+#define GAP_APPEARE_UNKNOWN                     0x0000
+
+#define CHAR_PROP_READ                          0x02
+#define CHAR_PROP_WRITE_WITHOUT_RSP             0x04
+#define CHAR_PROP_WRITE                         0x08
+#define CHAR_PROP_NOTIFY                        0x10
+#define CHAR_PROP_INDICATE                      0x20
+
+#define ATT_PERMISSIONS_READ                    0x01
+#define ATT_PERMISSIONS_WRITE                   0x02
+#define ATT_PERMISSIONS_RDWR                    (ATT_PERMISSIONS_READ | ATT_PERMISSIONS_WRITE)
+
+#if TELINK_SDK_B91_BLE_MULTI
+typedef int (*att_readwrite_callback_t)(u16 connHandle, void *p);
+#else
+typedef int (*att_readwrite_callback_t)(void *p);
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+
+typedef struct attribute {
+    u16 attNum;
+    u8 perm;
+    u8 uuidLen;
+    u32 attrLen;
+    u8 *uuid;
+    u8 *pAttrValue;
+    att_readwrite_callback_t w;
+    att_readwrite_callback_t r;
+} attribute_t;
+
+/* Common to both SDKs */
+extern u32 flash_sector_mac_address;
+
+void blc_initMacAddress(int flash_addr, u8 *mac_public, u8 *mac_random_static);
+void blc_app_loadCustomizedParameters(void);
+void blc_ll_initBasicMCU(void);
+void blc_ll_initStandby_module(u8 *public_adr);
+ble_sts_t blc_ll_initAclConnRxFifo(u8 *pRxbuf, int fifo_size, int fifo_number);
+ble_sts_t blc_controller_check_appBufferInitialization(void);
+ble_sts_t blc_att_requestMtuSizeExchange(u16 connHandle, u16 mtu_size);
+u16 blc_att_getEffectiveMtuSize(u16 connHandle);
+void blc_ll_init2MPhyCodedPhy_feature(void);
+ble_sts_t blc_ll_setPhy(u16 connHandle, u8 all_phys, u8 tx_phys, u8 rx_phys, le_ci_prefer_t phy_options);
+ble_sts_t blc_hci_le_setEventMask_cmd(u32 evtMask);
+void blc_hci_registerControllerEventHandler(hci_event_handler_t handler);
+void bls_att_setAttributeTable(u8 *p);
+
+#if TELINK_SDK_B91_BLE_SINGLE
+
+#define BLS_CONN_HANDLE                         0x0080
+
+typedef enum {
+    BLT_EV_FLAG_ADV = 0,
+    BLT_EV_FLAG_CONNECT,
+    BLT_EV_FLAG_TERMINATE,
+    BLT_EV_FLAG_CONN_PARA_UPDATE,
+    BLT_EV_MAX_NUM,
+} blt_ev_flag_t;
+
+typedef void (*blt_event_callback_t)(u8 e, u8 *p, int n);
+
+ble_sts_t bls_ll_setAdvParam(u16 intervalMin, u16 intervalMax, adv_type_t advType, own_addr_type_t ownAddrType,
+                             u8 peerAddrType, u8 *peerAddr, adv_chn_map_t adv_channelMap,
+                             adv_fp_type_t advFilterPolicy);
+ble_sts_t bls_ll_setAdvData(u8 *data, u8 len);
+ble_sts_t bls_ll_setScanRspData(u8 *data, u8 len);
+ble_sts_t bls_ll_setAdvEnable(int adv_enable);
+ble_sts_t bls_ll_terminateConnection(u8 reason);
+u16 bls_ll_getConnectionInterval(void);
+ble_sts_t blc_ll_initAclConnTxFifo(u8 *pTxbuf, int fifo_size, int fifo_number);
+ble_sts_t blc_ll_setAclConnMaxOctetsNumber(u8 maxRxOct, u8 maxTxOct);
+ble_sts_t blc_ll_exchangeDataLength(u8 opcode, u16 maxTxOct);
+u8 blc_ll_getTxFifoNumber(void);
+u8 blc_ll_getLatestAvgRSSI(void);
+ble_sts_t blc_att_setRxMtuSize(u16 mtu_size);
+void blc_l2cap_initMtuBuffer(u8 *pMTU_rx_buff, u16 mtu_rx_size, u8 *pMTU_tx_buff, u16 mtu_tx_size);
+ble_sts_t bls_att_pushNotifyData(u16 attHandle, u8 *p, int len);
+void blc_gap_peripheral_init(void);
+void blc_l2cap_register_handler(void *p);
+int blc_l2cap_packet_receive(u16 connHandle, u8 *p);
+void blc_ll_initAdvertising_module(void);
+void blc_ll_initConnection_module(void);
+void blc_ll_initSlaveRole_module(void);
+void blc_ll_initPowerManagement_module(void);
+void bls_pm_setSuspendMask(u8 mask);
+u32 bls_pm_getSystemWakeupTick(void);
+void blc_ll_recoverDeepRetention(void);
+void bls_app_registerEventCallback(u8 e, blt_event_callback_t p);
+void bls_l2cap_requestConnParamUpdate(u16 min_interval, u16 max_interval, u16 latency, u16 timeout);
+void blt_sdk_main_loop(void);
+void irq_blt_sdk_handler(void);
+
+#else
+
+typedef int (*blc_hci_data_handler_t)(u16 connHandle, u8 *p);
+
+ble_sts_t blc_ll_setAdvParam(u16 intervalMin, u16 intervalMax, adv_type_t advType, own_addr_type_t ownAddrType,
+                             u8 peerAddrType, u8 *peerAddr, adv_chn_map_t adv_channelMap,
+                             adv_fp_type_t advFilterPolicy);
+ble_sts_t blc_ll_setAdvData(u8 *data, u8 len);
+ble_sts_t blc_ll_setScanRspData(u8 *data, u8 len);
+ble_sts_t blc_ll_setAdvEnable(int adv_enable);
+ble_sts_t blc_ll_disconnect(u16 connHandle, u8 reason);
+u16 blc_ll_getAclConnectionInterval(u16 connHandle);
+ble_sts_t blc_ll_initAclConnSlaveTxFifo(u8 *pTxbuf, int fifo_size, int fifo_number, int conn_number);
+ble_sts_t blc_ll_setAclConnMaxOctetsNumber(u8 maxRxOct, u8 maxTxOct_master, u8 maxTxOct_slave);
+ble_sts_t blc_ll_sendDateLengthExtendReq(u16 connHandle, u16 maxTxOct);
+ble_sts_t blc_ll_setMaxConnectionNumber(int max_master_num, int max_slave_num);
+u8 blc_ll_getTxFifoNumber(u16 connHandle);
+u8 blc_ll_getLatestAvgRSSI(u16 connHandle);
+ble_sts_t blc_att_setSlaveRxMTUSize(u16 mtu_size);
+void blc_l2cap_initAclConnSlaveMtuBuffer(u8 *pMTU_rx_buff, u16 mtu_rx_size, u8 *pMTU_tx_buff, u16 mtu_tx_size);
+ble_sts_t blc_gatt_pushHandleValueNotify(u16 connHandle, u16 attHandle, u8 *p, int len);
+void blc_gap_init(void);
+void blc_hci_registerControllerDataHandler(blc_hci_data_handler_t handler);
+int blc_l2cap_pktHandler(u16 connHandle, u8 *raw_pkt);
+void blc_ll_initLegacyAdvertising_module(void);
+void blc_ll_initAclConnection_module(void);
+void blc_ll_initAclSlaveRole_module(void);
+void blc_l2cap_sendConnParamUpdateReq(u16 connHandle, u16 min_interval, u16 max_interval, u16 latency, u16 timeout);
+void blc_sdk_main_loop(void);
+void blc_sdk_irq_handler(void);
+
+#endif /* TELINK_SDK_B91_BLE_SINGLE */
+
+#endif /* HOST_FAKE_STACK_BLE_BLE_H */
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Host stand-in for tl_common.h of the Telink B91 SDK: basic types and helper macros */
+
+#ifndef HOST_FAKE_TL_COMMON_H
+#define HOST_FAKE_TL_COMMON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef unsigned char u8;
+typedef signed char s8;
+typedef unsigned short u16;
+typedef signed short s16;
+typedef unsigned int u32;
+typedef signed int s32;
+typedef unsigned long long u64;
+typedef signed long long s64;
+
+#define U8_MAX          ((u8)0xff)
+#define U16_MAX         ((u16)0xffff)
+#define U32_MAX         ((u32)0xffffffff)
+
+#define U16_LO(x)       ((u8)((x) & 0xff))
+#define U16_HI(x)       ((u8)(((x) >> 8) & 0xff))
+#define U32_BYTE0(x)    ((u8)((x) & 0xff))
+#define U32_BYTE1(x)    ((u8)(((x) >> 8) & 0xff))
+#define U32_BYTE2(x)    ((u8)(((x) >> 16) & 0xff))
+#define U32_BYTE3(x)    ((u8)(((x) >> 24) & 0xff))
+#define MAKE_U16(h, l)  ((u16)(((h) << 8) | (l)))
+
+#ifndef min
+#define min(a, b)       ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b)       ((a) > (b) ? (a) : (b))
+#endif
+
+#define ARRAY_SIZE(a)   (sizeof(a) / sizeof((a)[0]))
+#define BIT(n)          (1u << (n))
+
+#ifndef UNUSED
+#define UNUSED(var)     do { (void)(var); } while (0)
+#endif
+
+/* Linker section placement has no meaning on the host */
+#define _attribute_ram_code_
+#define _attribute_ram_code_sec_noinline_
+#define _attribute_data_retention_
+#define _attribute_no_inline_        __attribute__((noinline))
+
+#endif /* HOST_FAKE_TL_COMMON_H */
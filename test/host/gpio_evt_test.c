@@ -0,0 +1,268 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Debouncer scenarios of common/gpio_evt: GpioDebounce on its own, then the whole capture path from a
+ * simulated button through the HDF interrupt, the edge ring and the consumer to the subscribers.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <board_config.h>
+#include <drivers.h>
+#include <gpio_if.h>
+#include <los_event.h>
+
+#include "gpio_debounce.h"
+#include "gpio_evt.h"
+
+#include "host_test.h"
+
+#define TICKS_PER_MS    SYSTEM_TIMER_TICK_1MS
+#define WINDOW_MS       20
+
+static void TestBounceBurst(void)
+{
+    GpioDebounce db;
+    uint8_t level = 0xff;
+    uint32_t timestamp = 0;
+    uint32_t t = 1000;
+
+    GpioDebounceInit(&db, GPIO_VAL_HIGH, WINDOW_MS * TICKS_PER_MS);
+    HOST_CHECK_EQ(GpioDebounceRemaining(&db, t), UINT32_MAX);
+
+    /* a press bouncing for 5 ms, 1 ms apart, settles low */
+    for (int i = 0; i < 6; i++) {
+        GpioDebounceEdge(&db, (i & 1) ? GPIO_VAL_HIGH : GPIO_VAL_LOW, t + i * TICKS_PER_MS);
+    }
+    uint32_t lastEdge = t + 5 * TICKS_PER_MS;
+    HOST_CHECK_EQ(db.level, GPIO_VAL_HIGH);
+    GpioDebounceEdge(&db, GPIO_VAL_LOW, lastEdge + TICKS_PER_MS);
+    lastEdge += TICKS_PER_MS;
+
+    /* nothing until the line was quiet for the whole window */
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, lastEdge + WINDOW_MS * TICKS_PER_MS - 1, &level, &timestamp), 0);
+    HOST_CHECK_EQ(GpioDebounceRemaining(&db, lastEdge + WINDOW_MS * TICKS_PER_MS - 1), 1);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, lastEdge + WINDOW_MS * TICKS_PER_MS, &level, &timestamp), 1);
+    HOST_CHECK_EQ(level, GPIO_VAL_LOW);
+    /* the change is dated at the first edge of the burst */
+    HOST_CHECK_EQ(timestamp, t);
+
+    /* reported once */
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, lastEdge + 2 * WINDOW_MS * TICKS_PER_MS, &level, &timestamp), 0);
+    HOST_CHECK_EQ(GpioDebounceRemaining(&db, lastEdge + 2 * WINDOW_MS * TICKS_PER_MS), UINT32_MAX);
+}
+
+static void TestGlitch(void)
+{
+    GpioDebounce db;
+    uint8_t level;
+    uint32_t timestamp;
+
+    GpioDebounceInit(&db, GPIO_VAL_LOW, WINDOW_MS * TICKS_PER_MS);
+
+    /* a spike shorter than the window that ends on the stable level is no change */
+    GpioDebounceEdge(&db, GPIO_VAL_HIGH, 100);
+    GpioDebounceEdge(&db, GPIO_VAL_LOW, 100 + TICKS_PER_MS);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, 100 + (WINDOW_MS + 1) * TICKS_PER_MS, &level, &timestamp), 0);
+    HOST_CHECK_EQ(GpioDebounceRemaining(&db, 100 + (WINDOW_MS + 1) * TICKS_PER_MS), UINT32_MAX);
+}
+
+static void TestTimerWrap(void)
+{
+    GpioDebounce db;
+    uint8_t level;
+    uint32_t timestamp;
+    uint32_t t = UINT32_MAX - 5 * TICKS_PER_MS;
+
+    GpioDebounceInit(&db, GPIO_VAL_LOW, WINDOW_MS * TICKS_PER_MS);
+
+    /* the window closes after the 32-bit tick counter wrapped */
+    GpioDebounceEdge(&db, GPIO_VAL_HIGH, t);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, t + 10 * TICKS_PER_MS, &level, &timestamp), 0);
+    HOST_CHECK_EQ(GpioDebounceRemaining(&db, t + 10 * TICKS_PER_MS), (WINDOW_MS - 10) * TICKS_PER_MS);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, t + WINDOW_MS * TICKS_PER_MS, &level, &timestamp), 1);
+    HOST_CHECK_EQ(level, GPIO_VAL_HIGH);
+    HOST_CHECK_EQ(timestamp, t);
+}
+
+static void TestEdgeAfterNow(void)
+{
+    GpioDebounce db;
+    uint8_t level;
+    uint32_t timestamp;
+
+    GpioDebounceInit(&db, GPIO_VAL_LOW, WINDOW_MS * TICKS_PER_MS);
+
+    /* the consumer sampled now, then took an edge the ISR stamped a little later: the window is still open */
+    GpioDebounceEdge(&db, GPIO_VAL_HIGH, 1005);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, 1000, &level, &timestamp), 0);
+    HOST_CHECK_EQ(GpioDebounceRemaining(&db, 1000), WINDOW_MS * TICKS_PER_MS + 5);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, 1005 + WINDOW_MS * TICKS_PER_MS - 1, &level, &timestamp), 0);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, 1005 + WINDOW_MS * TICKS_PER_MS, &level, &timestamp), 1);
+    HOST_CHECK_EQ(level, GPIO_VAL_HIGH);
+}
+
+static void TestNoWindow(void)
+{
+    GpioDebounce db;
+    uint8_t level;
+    uint32_t timestamp;
+
+    /* window 0 reports every change at the next poll */
+    GpioDebounceInit(&db, GPIO_VAL_LOW, 0);
+    GpioDebounceEdge(&db, GPIO_VAL_HIGH, 50);
+    HOST_CHECK_EQ(GpioDebounceRemaining(&db, 50), 0);
+    HOST_CHECK_EQ(GpioDebouncePoll(&db, 50, &level, &timestamp), 1);
+    HOST_CHECK_EQ(level, GPIO_VAL_HIGH);
+}
+
+static struct {
+    GpioEvt evt[8];
+    int count;
+    int anyCount;
+} g_received;
+
+static void OnPin(const GpioEvt *evt, void *ctx)
+{
+    (void)ctx;
+
+    if (g_received.count < 8) {
+        g_received.evt[g_received.count] = *evt;
+    }
+    g_received.count++;
+}
+
+static void OnAnyPin(const GpioEvt *evt, void *ctx)
+{
+    (void)evt;
+
+    (*(int *)ctx)++;
+}
+
+/**
+ * @brief      A bouncing button on SW1_2 through HDF, the ring and GpioEvtProcess(), as the consumer task runs it
+ */
+static void TestButtonPress(void)
+{
+    GpioEvtStats stats;
+
+    memset(&g_received, 0, sizeof(g_received));
+    FakeGpioSetInput(SW1_2_GPIO_HDF, GPIO_VAL_HIGH);
+    FakeGpioSetInput(SW1_3_GPIO_HDF, GPIO_VAL_HIGH);
+
+    GpioEvtInit();
+    HOST_CHECK_EQ(GpioEvtAddPin(SW1_2_GPIO_HDF, WINDOW_MS), 0);
+    HOST_CHECK_EQ(GpioEvtAddPin(SW1_3_GPIO_HDF, WINDOW_MS), 0);
+    HOST_CHECK_EQ(GpioEvtAddPin(SW1_2_GPIO_HDF, WINDOW_MS), -1);
+    HOST_CHECK_EQ(GpioEvtSubscribe(SW1_2_GPIO_HDF, OnPin, NULL), 0);
+    HOST_CHECK_EQ(GpioEvtSubscribe(GPIO_EVT_ANY_PIN, OnAnyPin, &g_received.anyCount), 0);
+    HOST_CHECK_EQ(GpioEvtStart(1, 0x400), LOS_OK);
+
+    /* press: 4 bounces 500 us apart, the ISR wakes the consumer on every edge */
+    uint32_t pressTick = stimer_get_tick();
+    UINT32 wakes = g_fakeEventWrites;
+    for (int i = 0; i < 5; i++) {
+        FakeGpioSetInput(SW1_2_GPIO_HDF, (i & 1) ? GPIO_VAL_HIGH : GPIO_VAL_LOW);
+        FakeClockAdvanceUs(500);
+    }
+    HOST_CHECK_EQ(g_fakeEventWrites - wakes, 5);
+
+    uint32_t next = GpioEvtProcess(stimer_get_tick());
+    HOST_CHECK_EQ(g_received.count, 0);
+    HOST_CHECK_EQ(next, WINDOW_MS * TICKS_PER_MS - 500 * SYSTEM_TIMER_TICK_1US);
+
+    /* the consumer sleeps for the returned ticks, then delivers */
+    FakeClockAdvanceUs(next / SYSTEM_TIMER_TICK_1US);
+    HOST_CHECK_EQ(GpioEvtProcess(stimer_get_tick()), UINT32_MAX);
+    HOST_CHECK_EQ(g_received.count, 1);
+    HOST_CHECK_EQ(g_received.evt[0].hdfIndex, SW1_2_GPIO_HDF);
+    HOST_CHECK_EQ(g_received.evt[0].level, GPIO_VAL_LOW);
+    HOST_CHECK_EQ(g_received.evt[0].timestamp, pressTick);
+
+    /* an edge after the consumer sampled its time is debounced like any other */
+    uint32_t now = stimer_get_tick();
+    FakeClockAdvanceUs(100);
+    FakeGpioSetInput(SW1_2_GPIO_HDF, GPIO_VAL_HIGH);
+    HOST_CHECK_EQ(GpioEvtProcess(now), WINDOW_MS * TICKS_PER_MS + 100 * SYSTEM_TIMER_TICK_1US);
+    HOST_CHECK_EQ(g_received.count, 1);
+    FakeClockAdvanceUs(WINDOW_MS * 1000);
+    HOST_CHECK_EQ(GpioEvtProcess(stimer_get_tick()), UINT32_MAX);
+    HOST_CHECK_EQ(g_received.count, 2);
+    HOST_CHECK_EQ(g_received.evt[1].level, GPIO_VAL_HIGH);
+
+    /* the other button only reaches the any-pin subscriber */
+    FakeGpioSetInput(SW1_3_GPIO_HDF, GPIO_VAL_LOW);
+    FakeClockAdvanceUs(WINDOW_MS * 1000);
+    (void)GpioEvtProcess(stimer_get_tick());
+    HOST_CHECK_EQ(g_received.count, 2);
+    HOST_CHECK_EQ(g_received.anyCount, 3);
+
+    GpioEvtGetStats(&stats);
+    HOST_CHECK_EQ(stats.edges, 7);
+    HOST_CHECK_EQ(stats.events, 3);
+    HOST_CHECK_EQ(stats.drops, 0);
+}
+
+/**
+ * @brief      Edges beyond the ring are dropped and counted, the level is read from the pin when the window closes
+ */
+static void TestRingOverflow(void)
+{
+    GpioEvtStats stats;
+
+    memset(&g_received, 0, sizeof(g_received));
+    FakeGpioSetInput(SW1_2_GPIO_HDF, GPIO_VAL_HIGH);
+
+    /* not started: the edges are only queued, nobody is woken */
+    GpioEvtInit();
+    HOST_CHECK_EQ(GpioEvtAddPin(SW1_2_GPIO_HDF, WINDOW_MS), 0);
+    HOST_CHECK_EQ(GpioEvtSubscribe(SW1_2_GPIO_HDF, OnPin, NULL), 0);
+
+    UINT32 wakes = g_fakeEventWrites;
+    for (int i = 0; i < GPIO_EVT_RING_LEN + 11; i++) {
+        FakeGpioSetInput(SW1_2_GPIO_HDF, (i & 1) ? GPIO_VAL_HIGH : GPIO_VAL_LOW);
+        FakeClockAdvanceUs(10);
+    }
+
+    FakeClockAdvanceUs(WINDOW_MS * 1000);
+    (void)GpioEvtProcess(stimer_get_tick());
+
+    GpioEvtGetStats(&stats);
+    HOST_CHECK_EQ(stats.edges, GPIO_EVT_RING_LEN);
+    HOST_CHECK_EQ(stats.drops, 11);
+    HOST_CHECK_EQ(stats.highWater, GPIO_EVT_RING_LEN);
+    HOST_CHECK_EQ(g_fakeEventWrites, wakes);
+    /* the last stored edge was a rising one, the dropped ones left the line low */
+    HOST_CHECK_EQ(g_received.count, 1);
+    HOST_CHECK_EQ(g_received.evt[0].level, GPIO_VAL_LOW);
+}
+
+int main(void)
+{
+    HOST_RUN(TestBounceBurst);
+    HOST_RUN(TestGlitch);
+    HOST_RUN(TestTimerWrap);
+    HOST_RUN(TestEdgeAfterNow);
+    HOST_RUN(TestNoWindow);
+    HOST_RUN(TestButtonPress);
+    HOST_RUN(TestRingOverflow);
+
+    return HOST_RESULT("gpio_evt_test");
+}
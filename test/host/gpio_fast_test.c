@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Pin resolution of common/gpio_fast through the HCS pin map, and the HDF fallback */
+
+#include <stdint.h>
+
+#include <board_config.h>
+#include <drivers.h>
+#include <gpio_if.h>
+
+#include "gpio_fast.h"
+
+#include "host_test.h"
+
+static uint16_t HdfLevel(uint16_t hdfIndex)
+{
+    uint16_t val = GPIO_VAL_ERR;
+
+    (void)GpioRead(hdfIndex, &val);
+    return val;
+}
+
+static void TestResolve(void)
+{
+    GpioFast led;
+
+    /* every pin of the pin map takes the register path, not only the ones an app happens to use */
+    for (uint16_t i = LED_BLUE_HDF; i <= SW1_3_GPIO_HDF; i++) {
+        HOST_CHECK(GpioFastInit(&led, i));
+        HOST_CHECK(led.out != NULL);
+    }
+
+    HOST_CHECK_EQ(GpioSetDir(LED_GREEN_HDF, GPIO_DIR_OUT), 0);
+    HOST_CHECK(GpioFastInit(&led, LED_GREEN_HDF));
+    HOST_CHECK_EQ(led.mask, GPIO_PB5 & 0xff);
+
+    uint32_t calls = g_fakeHdfGpioCalls;
+    GpioFastWrite(&led, GPIO_VAL_HIGH);
+    HOST_CHECK_EQ(g_fakeHdfGpioCalls, calls);
+    HOST_CHECK_EQ(HdfLevel(LED_GREEN_HDF), GPIO_VAL_HIGH);
+
+    GpioFastToggle(&led);
+    HOST_CHECK_EQ(HdfLevel(LED_GREEN_HDF), GPIO_VAL_LOW);
+    HOST_CHECK_EQ(GpioFastRead(&led), GPIO_VAL_LOW);
+
+    /* the read-modify-write leaves the other pins of the port and the interrupt mask alone */
+    HOST_CHECK_EQ(GpioSetDir(LED_BLUE_HDF, GPIO_DIR_OUT), 0);
+    HOST_CHECK_EQ(GpioWrite(LED_BLUE_HDF, GPIO_VAL_HIGH), 0);
+    GpioFastWrite(&led, GPIO_VAL_HIGH);
+    GpioFastWrite(&led, GPIO_VAL_LOW);
+    HOST_CHECK_EQ(HdfLevel(LED_BLUE_HDF), GPIO_VAL_HIGH);
+    HOST_CHECK_EQ(g_fakeIrqDisabled, 0);
+}
+
+static void TestFallback(void)
+{
+    GpioFast io;
+
+    /* an index the pin map does not know keeps going through HDF */
+    HOST_CHECK(!GpioFastInit(&io, SW1_3_GPIO_HDF + 1));
+    HOST_CHECK(io.out == NULL);
+
+    uint32_t calls = g_fakeHdfGpioCalls;
+    GpioFastWrite(&io, GPIO_VAL_HIGH);
+    HOST_CHECK_EQ(g_fakeHdfGpioCalls, calls + 1);
+}
+
+int main(void)
+{
+    HOST_RUN(TestResolve);
+    HOST_RUN(TestFallback);
+
+    return HOST_RESULT("gpio_fast_test");
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Minimal check macros shared by the host tests, a failed check is reported and the test goes on */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int g_hostTestFailures;
+
+#define HOST_CHECK(cond)                                                                \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);             \
+            g_hostTestFailures++;                                                       \
+        }                                                                               \
+    } while (0)
+
+#define HOST_CHECK_EQ(a, b)                                                             \
+    do {                                                                                \
+        long long hostA_ = (long long)(a);                                              \
+        long long hostB_ = (long long)(b);                                              \
+        if (hostA_ != hostB_) {                                                         \
+            printf("%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, \
+                   #a, #b, hostA_, hostB_);                                             \
+            g_hostTestFailures++;                                                       \
+        }                                                                               \
+    } while (0)
+
+#define HOST_RUN(test)                                                                  \
+    do {                                                                                \
+        printf("  %s\n", #test);                                                        \
+        test();                                                                         \
+    } while (0)
+
+/* Exit status of a test binary */
+#define HOST_RESULT(name)                                                               \
+    (printf("%s: %s\n", (name), g_hostTestFailures ? "FAILED" : "passed"), g_hostTestFailures != 0)
+
+#endif /* HOST_TEST_H */
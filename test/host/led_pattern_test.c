@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/* Timers and PWM of common/led_pattern, run on the fake software timers */
+
+#include <stdint.h>
+
+#include <board_config.h>
+#include <drivers.h>
+#include <gpio_if.h>
+#include <los_swtmr.h>
+
+#include "led_pattern.h"
+
+#include "host_test.h"
+
+#define TEST_TICK_MS    10
+#define TEST_TIMERS     8
+
+static const LedPatternDesc g_breathe[] = {
+    {.hdfIndex = LED_BLUE_HDF, .type = LED_PATTERN_BLINK, .periodMs = 2000, .onMs = 1000},
+    {.hdfIndex = LED_WHITE_HDF, .type = LED_PATTERN_BREATHE, .periodMs = 1000},
+};
+
+static const LedPatternDesc g_blink[] = {
+    {.hdfIndex = LED_BLUE_HDF, .type = LED_PATTERN_BLINK, .periodMs = 2000, .onMs = 1000},
+};
+
+static LedPatternLed g_leds[2];
+
+static uint16_t HdfLevel(uint16_t hdfIndex)
+{
+    uint16_t val = GPIO_VAL_ERR;
+
+    (void)GpioRead(hdfIndex, &val);
+    return val;
+}
+
+/**
+ * @brief      Let the simulated time pass in 1 ms steps
+ * @return     timer callbacks run
+ */
+static uint32_t RunMs(uint32_t ms)
+{
+    uint32_t runs = 0;
+
+    for (uint32_t i = 0; i < ms; i++) {
+        FakeClockAdvanceUs(1000);
+        runs += FakeSwtmrRun();
+    }
+    return runs;
+}
+
+static int ActiveTimers(void)
+{
+    int active = 0;
+
+    for (UINT32 i = 0; i < TEST_TIMERS; i++) {
+        active += FakeSwtmrActive(i);
+    }
+    return active;
+}
+
+static void TestBreathePwm(void)
+{
+    uint32_t run = 0;
+    uint32_t maxRun = 0;
+    uint32_t edges = 0;
+    uint16_t last = GPIO_VAL_LOW;
+
+    HOST_CHECK_EQ(LedPatternStart(g_breathe, g_leds, 2, TEST_TICK_MS), LOS_OK);
+    /* one timer at the kernel tick drives both the PWM and the patterns */
+    HOST_CHECK_EQ(ActiveTimers(), 1);
+
+    /* while the LED is neither off nor fully on, no level lasts a whole PWM period */
+    for (uint32_t ms = 0; ms < 2000; ms++) {
+        (void)RunMs(1);
+        uint16_t level = HdfLevel(LED_WHITE_HDF);
+        uint8_t duty = g_leds[1].duty;
+        edges += (level != last);
+        run = (level == last) ? run + 1 : 1;
+        last = level;
+        if (duty == 0 || duty == LED_PATTERN_PWM_FRAME) {
+            run = 0;
+        } else if (run > maxRun) {
+            maxRun = run;
+        }
+    }
+    HOST_CHECK(maxRun > 0);
+    HOST_CHECK(maxRun <= LED_PATTERN_PWM_FRAME);
+    HOST_CHECK(edges > 2000 / LED_PATTERN_PWM_FRAME / 2);
+
+    /* the blink LED stays on the pattern timer, the cycle restarts with the 200th engine tick */
+    (void)RunMs(TEST_TICK_MS);
+    HOST_CHECK_EQ(HdfLevel(LED_BLUE_HDF), GPIO_VAL_HIGH);
+    (void)RunMs(1000);
+    HOST_CHECK_EQ(HdfLevel(LED_BLUE_HDF), GPIO_VAL_LOW);
+
+    LedPatternStop();
+    HOST_CHECK_EQ(ActiveTimers(), 0);
+}
+
+static void TestNoBreathe(void)
+{
+    /* the timer only runs at the kernel tick for tables that breathe */
+    HOST_CHECK_EQ(LedPatternStart(g_blink, g_leds, 1, TEST_TICK_MS), LOS_OK);
+    HOST_CHECK_EQ(ActiveTimers(), 1);
+    HOST_CHECK_EQ(RunMs(10 * TEST_TICK_MS), 10);
+
+    LedPatternStop();
+    HOST_CHECK_EQ(ActiveTimers(), 0);
+}
+
+static void TestProbePeriod(void)
+{
+    CycleProfPoint point = {.name = "led_interval"};
+
+    /* samples are taken at the probe period, not at every engine tick */
+    LedPatternSetProbe(&point, 1000);
+    HOST_CHECK_EQ(LedPatternStart(g_blink, g_leds, 1, TEST_TICK_MS), LOS_OK);
+    (void)RunMs(5000);
+    HOST_CHECK_EQ(point.count, 4);
+
+    LedPatternSetProbe(NULL, 0);
+    LedPatternStop();
+}
+
+int main(void)
+{
+    HOST_RUN(TestBreathePwm);
+    HOST_RUN(TestNoBreathe);
+    HOST_RUN(TestProbePeriod);
+
+    return HOST_RESULT("led_pattern_test");
+}
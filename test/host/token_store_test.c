@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Power loss sweep of common/token_store on the file-backed flash stand-in: a commit is cut after
+ * every single byte it erases or programs, and the record committed before must always survive.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "token_flash_file.h"
+#include "token_store.h"
+
+#include "host_test.h"
+
+/* Smallest sector that holds a record keeps the sweep short, erase costs a byte per byte of it */
+#define SECTOR_SIZE     512
+
+_Static_assert(sizeof(TokenRecord) <= SECTOR_SIZE, "record does not fit in the test sector");
+
+#define TOKEN_LEN       sizeof(((TokenRecord *)0)->data_TOKEN)
+
+/* Erase of the target sector plus the body and head of the record */
+#define COMMIT_BYTES    (SECTOR_SIZE + sizeof(TokenRecord))
+
+static char g_path[64];
+
+static void FreshFlash(TokenFlashFile *ff)
+{
+    (void)unlink(g_path);
+    HOST_CHECK_EQ(TokenFlashFileOpen(ff, g_path, SECTOR_SIZE), 0);
+}
+
+static void TokenValue(char *buf, uint32_t len, char tag)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = (char)(tag + i % 7);
+    }
+}
+
+/**
+ * @brief      Token as a fresh boot loads it
+ */
+static int LoadToken(TokenFlashFile *ff, char *buf, uint32_t len, uint32_t *seq)
+{
+    TokenStore store;
+
+    TokenFlashFileSetBudget(ff, UINT32_MAX);
+    HOST_CHECK_EQ(TokenStoreInit(&store, &ff->flash), TOKEN_STORE_OK);
+    int ret = TokenStoreRead(&store, TOKEN_SLOT_TOKEN, buf, len);
+    *seq = TokenStoreSeq(&store);
+
+    return ret;
+}
+
+static void TestRoundTrip(void)
+{
+    TokenFlashFile ff;
+    TokenStore store;
+    char in[32];
+    char out[32];
+    uint32_t seq;
+
+    FreshFlash(&ff);
+    HOST_CHECK_EQ(TokenStoreInit(&store, &ff.flash), TOKEN_STORE_OK);
+    HOST_CHECK_EQ(TokenStoreRead(&store, TOKEN_SLOT_TOKEN, out, sizeof(out)), TOKEN_STORE_ERR_EMPTY);
+
+    for (char tag = 'a'; tag <= 'e'; tag++) {
+        TokenValue(in, sizeof(in), tag);
+        HOST_CHECK_EQ(TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, in, sizeof(in)), TOKEN_STORE_OK);
+    }
+    /* one erase per commit, always of the sector not holding the current record */
+    HOST_CHECK_EQ(ff.erases, 5);
+    HOST_CHECK_EQ(TokenStoreSeq(&store), 5);
+
+    HOST_CHECK_EQ(LoadToken(&ff, out, sizeof(out), &seq), TOKEN_STORE_OK);
+    HOST_CHECK_EQ(memcmp(out, in, sizeof(in)), 0);
+    HOST_CHECK_EQ(seq, 5);
+
+    TokenFlashFileClose(&ff);
+}
+
+/**
+ * @brief      Cut the commit of "new" over "old" after every byte; with prior set, both sectors hold
+ *             a record and the commit overwrites the older one, otherwise it goes to an erased sector
+ */
+static void PowerLossSweep(int prior)
+{
+    TokenFlashFile ff;
+    char oldToken[TOKEN_LEN];
+    char newToken[TOKEN_LEN];
+    char out[TOKEN_LEN];
+    uint32_t oldSeq = prior ? 2 : 1;
+    uint32_t seq;
+    int failures = 0;
+
+    TokenValue(oldToken, sizeof(oldToken), 'o');
+    TokenValue(newToken, sizeof(newToken), 'N');
+
+    for (uint32_t budget = 0; budget <= COMMIT_BYTES && failures < 5; budget++) {
+        TokenStore store;
+
+        FreshFlash(&ff);
+        HOST_CHECK_EQ(TokenStoreInit(&store, &ff.flash), TOKEN_STORE_OK);
+        if (prior) {
+            HOST_CHECK_EQ(TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, "older", 5), TOKEN_STORE_OK);
+        }
+        HOST_CHECK_EQ(TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, oldToken, sizeof(oldToken)), TOKEN_STORE_OK);
+
+        TokenFlashFileSetBudget(&ff, budget);
+        int ret = TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, newToken, sizeof(newToken));
+        int complete = (budget == COMMIT_BYTES);
+        HOST_CHECK_EQ(ret, complete ? TOKEN_STORE_OK : TOKEN_STORE_ERR_FLASH);
+
+        /* the same store reloads the surviving record after a failed commit */
+        TokenFlashFileSetBudget(&ff, UINT32_MAX);
+        HOST_CHECK_EQ(TokenStoreRead(&store, TOKEN_SLOT_TOKEN, out, sizeof(out)), TOKEN_STORE_OK);
+        HOST_CHECK_EQ(memcmp(out, complete ? newToken : oldToken, sizeof(out)), 0);
+
+        /* and so does the next boot */
+        HOST_CHECK_EQ(LoadToken(&ff, out, sizeof(out), &seq), TOKEN_STORE_OK);
+        if (memcmp(out, complete ? newToken : oldToken, sizeof(out)) != 0 || seq != oldSeq + complete) {
+            printf("budget %u of %u: lost the %s record, seq %u\n", (unsigned)budget, (unsigned)COMMIT_BYTES,
+                   complete ? "new" : "previous", (unsigned)seq);
+            g_hostTestFailures++;
+            failures++;
+        }
+
+        TokenFlashFileClose(&ff);
+    }
+}
+
+static void TestPowerLossToErasedSector(void)
+{
+    PowerLossSweep(0);
+}
+
+static void TestPowerLossOverOlderRecord(void)
+{
+    PowerLossSweep(1);
+}
+
+/**
+ * @brief      A commit that fails leaves the next one free to succeed
+ */
+static void TestRecoveryAfterPowerLoss(void)
+{
+    TokenFlashFile ff;
+    TokenStore store;
+    char out[8];
+    uint32_t seq;
+
+    FreshFlash(&ff);
+    HOST_CHECK_EQ(TokenStoreInit(&store, &ff.flash), TOKEN_STORE_OK);
+    HOST_CHECK_EQ(TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, "first", 5), TOKEN_STORE_OK);
+
+    /* cut in the middle of the erase, then in the middle of the body */
+    TokenFlashFileSetBudget(&ff, SECTOR_SIZE / 2);
+    HOST_CHECK_EQ(TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, "second", 6), TOKEN_STORE_ERR_FLASH);
+    TokenFlashFileSetBudget(&ff, SECTOR_SIZE + 20);
+    HOST_CHECK_EQ(TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, "second", 6), TOKEN_STORE_ERR_FLASH);
+
+    TokenFlashFileSetBudget(&ff, UINT32_MAX);
+    HOST_CHECK_EQ(TokenStoreWrite(&store, TOKEN_SLOT_TOKEN, "third", 5), TOKEN_STORE_OK);
+    HOST_CHECK_EQ(LoadToken(&ff, out, sizeof(out), &seq), TOKEN_STORE_OK);
+    HOST_CHECK_EQ(memcmp(out, "third\0\0\0", sizeof(out)), 0);
+    HOST_CHECK_EQ(seq, 2);
+
+    TokenFlashFileClose(&ff);
+}
+
+int main(void)
+{
+    snprintf(g_path, sizeof(g_path), "/tmp/token_store_test.%d", (int)getpid());
+
+    HOST_RUN(TestRoundTrip);
+    HOST_RUN(TestPowerLossToErasedSector);
+    HOST_RUN(TestPowerLossOverOlderRecord);
+    HOST_RUN(TestRecoveryAfterPowerLoss);
+
+    (void)unlink(g_path);
+
+    return HOST_RESULT("token_store_test");
+}
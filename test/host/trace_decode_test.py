@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+# All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Decode the dump printed by "trace_ring_test dump" with ble_demo/tools/trace_decode.py and check the timeline.
+
+    python3 trace_decode_test.py build/trace_ring_test
+"""
+
+import json
+import os
+import subprocess
+import sys
+import unittest
+
+DECODER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "ble_demo", "tools", "trace_decode.py")
+
+# Timeline of PrintTimeline() in trace_ring_test.c
+RECORDS = 64
+OVERWRITTEN = 16
+PERIOD_US = 1000.0
+WAKE_LATENCY_US = 20.0
+LOOP_BEGIN_US = 25.0
+LOOP_END_US = 100.0
+
+DUMP_BINARY = None
+
+
+def decode(log):
+    result = subprocess.run([sys.executable, DECODER], input=log, capture_output=True, text=True, check=True)
+    return json.loads(result.stdout), result.stderr
+
+
+class TraceDecodeTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.log = subprocess.run([DUMP_BINARY, "dump"], capture_output=True, text=True, check=True).stdout
+        cls.trace, cls.summary = decode(cls.log)
+        cls.events = [e for e in cls.trace["traceEvents"] if e["ph"] != "M"]
+
+    def test_summary(self):
+        self.assertIn("%d records, %d overwritten" % (RECORDS, OVERWRITTEN), self.summary)
+        self.assertIn("n %d, min %.1f us" % (RECORDS // 4, WAKE_LATENCY_US), self.summary)
+        self.assertIn("max %.1f us" % WAKE_LATENCY_US, self.summary)
+
+    def test_names_from_header(self):
+        names = {e["name"] for e in self.events}
+        self.assertTrue({"RF_IRQ", "TASK_WAKE", "MAIN_LOOP", "RF_IRQ -> TASK_WAKE"} <= names)
+
+    def test_timer_wrap(self):
+        # the dump crosses 0xffffffff, timestamps stay monotonic and keep the 1 ms period
+        irqs = [e["ts"] for e in self.events if e["name"] == "RF_IRQ"]
+        self.assertEqual(len(irqs), RECORDS // 4)
+        self.assertEqual(irqs[0], 0)
+        for previous, current in zip(irqs, irqs[1:]):
+            self.assertAlmostEqual(current - previous, PERIOD_US)
+
+    def test_main_loop_slices(self):
+        begins = [e["ts"] for e in self.events if e["name"] == "MAIN_LOOP" and e["ph"] == "B"]
+        ends = [e["ts"] for e in self.events if e["name"] == "MAIN_LOOP" and e["ph"] == "E"]
+        self.assertEqual(len(begins), len(ends))
+        for begin, end in zip(begins, ends):
+            self.assertAlmostEqual(end - begin, LOOP_END_US - LOOP_BEGIN_US)
+
+    def test_last_dump_wins(self):
+        stale = "TRACE BEGIN 16 1 0\r\nTRACE 00000010 0001 0000\r\nTRACE END\r\n"
+        _, summary = decode(stale + self.log)
+        self.assertIn("%d records" % RECORDS, summary)
+
+    def test_incomplete_dump_rejected(self):
+        result = subprocess.run([sys.executable, DECODER], input="TRACE BEGIN 16 1 0\nTRACE 00000010 0001 0000\n",
+                                capture_output=True, text=True)
+        self.assertNotEqual(result.returncode, 0)
+
+
+if __name__ == "__main__":
+    DUMP_BINARY = os.path.abspath(sys.argv.pop(1))
+    unittest.main()
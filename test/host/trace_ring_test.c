@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Unit test of common/trace_ring. "trace_ring_test" runs the checks, "trace_ring_test dump" prints the dump
+ * of a known BleTask timeline for trace_decode_test.py.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "trace_ring.h"
+
+#include "host_test.h"
+
+#define RING_LEN            16
+#define TICKS_PER_US        16
+#define WRITER_THREADS      4
+#define WRITES_PER_THREAD   100000
+
+/* ble_trace.h IDs, the decoder reads them from there */
+#define ID_RF_IRQ           1
+#define ID_TASK_WAKE        3
+#define ID_MAIN_LOOP_BEGIN  4
+#define ID_MAIN_LOOP_END    5
+
+static TraceRing g_ring;
+static TraceRecord g_ringBuff[RING_LEN];
+
+/* Dump lines collected by CollectLine() */
+static char g_lines[RING_LEN + 2][64];
+static int g_lineCount;
+
+static void CollectLine(const char *line, void *ctx)
+{
+    (void)ctx;
+
+    if (g_lineCount < (int)(sizeof(g_lines) / sizeof(g_lines[0]))) {
+        (void)snprintf(g_lines[g_lineCount], sizeof(g_lines[0]), "%s", line);
+    }
+    g_lineCount++;
+}
+
+static void Dump(void)
+{
+    g_lineCount = 0;
+    TraceRingDump(&g_ring, TICKS_PER_US, CollectLine, NULL);
+}
+
+static void TestInit(void)
+{
+    HOST_CHECK_EQ(TraceRingInit(&g_ring, g_ringBuff, 12), -1);
+    HOST_CHECK_EQ(TraceRingInit(&g_ring, NULL, RING_LEN), -1);
+    HOST_CHECK_EQ(TraceRingInit(&g_ring, g_ringBuff, RING_LEN), 0);
+    HOST_CHECK(g_ring.enabled);
+
+    Dump();
+    HOST_CHECK_EQ(g_lineCount, 2);
+    HOST_CHECK(strcmp(g_lines[0], "TRACE BEGIN 16 0 0") == 0);
+    HOST_CHECK(strcmp(g_lines[1], "TRACE END") == 0);
+}
+
+static void TestPartial(void)
+{
+    (void)TraceRingInit(&g_ring, g_ringBuff, RING_LEN);
+
+    TraceRingWrite(&g_ring, 0x100, ID_RF_IRQ, 0);
+    TraceRingWrite(&g_ring, 0x200, ID_TASK_WAKE, 1);
+    TraceRingWrite(&g_ring, 0xffffffff, 0xabcd, 0xffff);
+
+    Dump();
+    HOST_CHECK_EQ(g_lineCount, 5);
+    HOST_CHECK(strcmp(g_lines[0], "TRACE BEGIN 16 3 0") == 0);
+    HOST_CHECK(strcmp(g_lines[1], "TRACE 00000100 0001 0000") == 0);
+    HOST_CHECK(strcmp(g_lines[2], "TRACE 00000200 0003 0001") == 0);
+    HOST_CHECK(strcmp(g_lines[3], "TRACE ffffffff abcd ffff") == 0);
+    HOST_CHECK(strcmp(g_lines[4], "TRACE END") == 0);
+
+    /* the dump clears the ring and recording goes on */
+    HOST_CHECK_EQ(g_ring.head, 0);
+    HOST_CHECK(g_ring.enabled);
+}
+
+static void TestOverwrite(void)
+{
+    unsigned ts;
+    unsigned id;
+    unsigned arg;
+
+    (void)TraceRingInit(&g_ring, g_ringBuff, RING_LEN);
+
+    for (uint32_t i = 0; i < RING_LEN + 5; i++) {
+        TraceRingWrite(&g_ring, i, ID_TASK_WAKE, (uint16_t)i);
+    }
+
+    /* the newest RING_LEN records, oldest first */
+    Dump();
+    HOST_CHECK_EQ(g_lineCount, RING_LEN + 2);
+    HOST_CHECK(strcmp(g_lines[0], "TRACE BEGIN 16 16 5") == 0);
+    for (int i = 0; i < RING_LEN; i++) {
+        HOST_CHECK_EQ(sscanf(g_lines[i + 1], "TRACE %x %x %x", &ts, &id, &arg), 3);
+        HOST_CHECK_EQ(ts, i + 5);
+        HOST_CHECK_EQ(arg, i + 5);
+    }
+
+    /* nothing is recorded while disabled */
+    g_ring.enabled = 0;
+    TraceRingWrite(&g_ring, 1, ID_TASK_WAKE, 1);
+    HOST_CHECK_EQ(g_ring.head, 0);
+}
+
+static void *WriterThread(void *arg)
+{
+    uint16_t writer = (uint16_t)(uintptr_t)arg;
+
+    for (uint32_t i = 0; i < WRITES_PER_THREAD; i++) {
+        /* the timestamp is derived from id and arg so torn records can be spotted */
+        uint16_t seq = (uint16_t)i;
+        TraceRingWrite(&g_ring, ((uint32_t)writer << 16) | seq, writer, seq);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief      Concurrent writers never lose a slot claim; every surviving record is a complete write
+ */
+static void TestConcurrentWriters(void)
+{
+    pthread_t threads[WRITER_THREADS];
+    unsigned ts;
+    unsigned id;
+    unsigned arg;
+
+    (void)TraceRingInit(&g_ring, g_ringBuff, RING_LEN);
+
+    for (uintptr_t i = 0; i < WRITER_THREADS; i++) {
+        HOST_CHECK_EQ(pthread_create(&threads[i], NULL, WriterThread, (void *)(i + 1)), 0);
+    }
+    for (int i = 0; i < WRITER_THREADS; i++) {
+        (void)pthread_join(threads[i], NULL);
+    }
+
+    HOST_CHECK_EQ(g_ring.head, WRITER_THREADS * WRITES_PER_THREAD);
+
+    Dump();
+    HOST_CHECK_EQ(g_lineCount, RING_LEN + 2);
+    for (int i = 0; i < RING_LEN; i++) {
+        HOST_CHECK_EQ(sscanf(g_lines[i + 1], "TRACE %x %x %x", &ts, &id, &arg), 3);
+        HOST_CHECK(id >= 1 && id <= WRITER_THREADS);
+        HOST_CHECK_EQ(ts, (id << 16) | arg);
+    }
+}
+
+static void PrintLine(const char *line, void *ctx)
+{
+    (void)ctx;
+
+    printf("boot log noise\r\n%s\r\n", line);
+}
+
+/**
+ * @brief      BleTask timeline for the decoder: an RF IRQ every 1000 us, the task wakes 20 us later and runs
+ *             the main loop for 75 us. Starts right below the 32-bit timer wrap and overflows the ring.
+ */
+static void PrintTimeline(void)
+{
+    static TraceRecord buff[64];
+    uint32_t t = 0xffffffffu - 3000 * TICKS_PER_US;
+
+    (void)TraceRingInit(&g_ring, buff, 64);
+
+    for (int i = 0; i < 20; i++) {
+        TraceRingWrite(&g_ring, t, ID_RF_IRQ, 0);
+        TraceRingWrite(&g_ring, t + 20 * TICKS_PER_US, ID_TASK_WAKE, 1);
+        TraceRingWrite(&g_ring, t + 25 * TICKS_PER_US, ID_MAIN_LOOP_BEGIN, 0);
+        TraceRingWrite(&g_ring, t + 100 * TICKS_PER_US, ID_MAIN_LOOP_END, 0);
+        t += 1000 * TICKS_PER_US;
+    }
+
+    TraceRingDump(&g_ring, TICKS_PER_US, PrintLine, NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "dump") == 0) {
+        PrintTimeline();
+        return 0;
+    }
+
+    HOST_RUN(TestInit);
+    HOST_RUN(TestPartial);
+    HOST_RUN(TestOverwrite);
+    HOST_RUN(TestConcurrentWriters);
+
+    return HOST_RESULT("trace_ring_test");
+}
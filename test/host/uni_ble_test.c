@@ -0,0 +1,1141 @@
+/******************************************************************************
+ * Copyright (c) 2022 Telink Semiconductor (Shanghai) Co., Ltd. ("TELINK")
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************/
+
+/*
+ * Runs the GATT sample (app.c and the uni_ble layer) on the host against the simulated controller.
+ * "uni_ble_test" runs the scenario tests, "uni_ble_test bench" the throughput benchmark.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <drivers.h>
+#include <gpio_if.h>
+#include <hiview_log.h>
+#include <los_swtmr.h>
+#include <los_task.h>
+
+#include "sim_controller.h"
+
+#include "app.h"
+#include "app_adv.h"
+#include "app_att.h"
+#include "app_buffer.h"
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+#include "app_bench.h"
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+#include "ble_log.h"
+#include "ble_trace.h"
+#include "uni_ble.h"
+#if TELINK_BLE_DIAG_ENABLE
+#include "uni_ble_diag.h"
+#endif /* TELINK_BLE_DIAG_ENABLE */
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+#include "uni_ble_notify.h"
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+#include "host_test.h"
+
+/* Connection interval of the simulated central, 30 ms */
+#define TEST_CONN_INTERVAL  24
+#define TEST_CONN_TIMEOUT   400
+
+/* White LED of the devkit, see the pin map of fake_hdf.c */
+#define TEST_LED_WHITE_ON() ((reg_gpio_out(GPIO_PB6) & (GPIO_PB6 & 0xff)) != 0)
+
+/**
+ * @brief      Let the simulated time pass in 1 ms steps, the BLE task runs its loop once per step
+ */
+static void RunMs(u32 ms)
+{
+    for (u32 i = 0; i < ms; i++) {
+        FakeClockAdvanceUs(1000);
+        MainLoop();
+        (void)FakeSwtmrRun();
+    }
+}
+
+#if TELINK_BIN_LOG_ENABLE
+static u32 g_logConnects;
+
+static void CountConnectLines(const char *line, void *ctx)
+{
+    char prefix[16];
+
+    (void)ctx;
+    (void)snprintf(prefix, sizeof(prefix), " %04x ", BLE_LOG_CONNECT);
+    if (strncmp(line, "BLOG ", 5) == 0 && strncmp(line + 13, prefix, strlen(prefix)) == 0) {
+        g_logConnects++;
+    }
+}
+#endif /* TELINK_BIN_LOG_ENABLE */
+
+static void Boot(void)
+{
+#if TELINK_BIN_LOG_ENABLE
+    static int logStarted;
+    if (!logStarted) {
+        BleLogInit();
+        logStarted = 1;
+    }
+    while (BinLogDrain(&g_bleLog, CountConnectLines, NULL, TELINK_BIN_LOG_LEN) != 0) {
+    }
+    g_logConnects = 0;
+#endif /* TELINK_BIN_LOG_ENABLE */
+    SimInit();
+    FakeLogClear();
+    UserInitNormal();
+    MainLoop();
+}
+
+static u16 Connect(void)
+{
+    u16 connHandle = SimConnect(TEST_CONN_INTERVAL, 0, TEST_CONN_TIMEOUT);
+
+    MainLoop();
+
+    return connHandle;
+}
+
+static void Disconnect(u16 connHandle)
+{
+    SimDisconnect(connHandle, HCI_ERR_REMOTE_USER_TERM_CONN);
+    MainLoop();
+}
+
+/**
+ * @brief      Latency of the last "wake-to-advertising" line, 0 if there is none
+ */
+static u32 WakeLatencyUs(void)
+{
+    const char *line = FakeLogFind("wake-to-advertising");
+    const char *value = (line != NULL) ? strstr(line, "): ") : NULL;
+    unsigned us = 0;
+
+    if (value == NULL || sscanf(value + 3, "%u", &us) != 1) {
+        return 0;
+    }
+    return us;
+}
+
+static void TestBoot(void)
+{
+    Boot();
+
+    HOST_CHECK(g_sim.advEnabled);
+    HOST_CHECK_EQ(g_sim.advIntervalMin, ADV_INTERVAL_30MS);
+    HOST_CHECK_EQ(g_sim.appBufferChecks, 1);
+    HOST_CHECK_EQ(g_sim.maxRxOctets, ACL_CONN_MAX_RX_OCTETS);
+    HOST_CHECK_EQ(g_sim.txFifoNum, ACL_TX_FIFO_NUM);
+    HOST_CHECK_EQ(g_sim.rxMtu, ATT_MTU_SLAVE_RX_MAX_SIZE);
+    HOST_CHECK(g_sim.attTable != NULL);
+    HOST_CHECK_EQ(FakeLogCount("wake-to-advertising"), 1);
+    /* measured from reset, where the system timer starts, not from user initialization */
+    HOST_CHECK_EQ(WakeLatencyUs(), clock_time() / SYSTEM_TIMER_TICK_1US);
+#if TELINK_SDK_B91_BLE_MULTI
+    HOST_CHECK_EQ(g_sim.maxSlaves, UNI_BLE_MAX_CONN);
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+#if TELINK_BIN_LOG_ENABLE
+    /* the log is formatted below every application task, BleTask included */
+    const TSK_INIT_PARAM_S *logTask = NULL;
+    for (UINT32 i = 0; i < g_fakeTaskCount; i++) {
+        if (strcmp(g_fakeTasks[i].pcName, "BinLogTask") == 0) {
+            logTask = &g_fakeTasks[i];
+        }
+    }
+    HOST_CHECK(logTask != NULL && logTask->usTaskPrio == OS_TASK_PRIORITY_LOWEST);
+#endif /* TELINK_BIN_LOG_ENABLE */
+}
+
+#if TELINK_BLE_DEEP_RETENTION_ENABLE
+static void TestRetentionWake(void)
+{
+    Boot();
+
+    u16 connHandle = Connect();
+    u8 ccc[2] = {1, 0};
+    (void)SimAttWrite(connHandle, GenericAttribute_ServiceChanged_CCB_H, ccc, sizeof(ccc));
+
+    /* the stack woke the MCU 500 us before user initialization ran */
+    g_sim.pmWakeupTick = clock_time() - 500 * SYSTEM_TIMER_TICK_1US;
+    FakeLogClear();
+    UserInitDeepRetention();
+    MainLoop();
+
+    HOST_CHECK(FakeLogFind("wake-to-advertising (retention)") != NULL);
+    HOST_CHECK_EQ(WakeLatencyUs(), 500);
+    /* the link and its client configuration are kept across retention */
+    HOST_CHECK(AppAttNotifyEnabled(GenericAttribute_ServiceChanged_CCB_H));
+}
+#endif /* TELINK_BLE_DEEP_RETENTION_ENABLE */
+
+static void TestConnectDisconnect(void)
+{
+    Boot();
+
+    u16 connHandle = Connect();
+    const uni_ble_conn_info_t *conn = uni_ble_get_conn(connHandle);
+
+    HOST_CHECK_EQ(uni_ble_get_conn_count(), 1);
+    HOST_CHECK(conn != NULL);
+    HOST_CHECK_EQ(conn ? conn->interval : 0, TEST_CONN_INTERVAL);
+    HOST_CHECK(TEST_LED_WHITE_ON());
+#if TELINK_BIN_LOG_ENABLE
+    /* only the ID and the arguments are recorded, nothing goes through HiLog */
+    (void)BinLogDrain(&g_bleLog, CountConnectLines, NULL, TELINK_BIN_LOG_LEN);
+    HOST_CHECK_EQ(g_logConnects, 1);
+    HOST_CHECK_EQ(FakeLogCount("connect: handle"), 0);
+#else
+    HOST_CHECK_EQ(FakeLogCount("connect: handle"), 1);
+#endif /* TELINK_BIN_LOG_ENABLE */
+#if TELINK_BLE_HIGH_THROUGHPUT_ENABLE
+    HOST_CHECK_EQ(uni_ble_att_getEffectiveMtuSize(connHandle), ATT_MTU_SLAVE_RX_MAX_SIZE);
+#endif /* TELINK_BLE_HIGH_THROUGHPUT_ENABLE */
+
+    Disconnect(connHandle);
+
+    HOST_CHECK_EQ(uni_ble_get_conn_count(), 0);
+    HOST_CHECK(uni_ble_get_conn(connHandle) == NULL);
+    HOST_CHECK(!TEST_LED_WHITE_ON());
+    HOST_CHECK(g_sim.advEnabled);
+#if !TELINK_BIN_LOG_ENABLE
+    HOST_CHECK_EQ(FakeLogCount("disconnect: handle"), 1);
+#endif /* !TELINK_BIN_LOG_ENABLE */
+}
+
+#if TELINK_SDK_B91_BLE_MULTI
+static void TestMultiLink(void)
+{
+    u16 connHandle[UNI_BLE_MAX_CONN];
+
+    Boot();
+
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        connHandle[i] = Connect();
+        /* advertising goes on while slave slots are free */
+        HOST_CHECK(g_sim.advEnabled || i == UNI_BLE_MAX_CONN - 1);
+    }
+    HOST_CHECK_EQ(uni_ble_get_conn_count(), UNI_BLE_MAX_CONN);
+
+    /* the LED stays on until the last link is gone */
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        HOST_CHECK(TEST_LED_WHITE_ON());
+        Disconnect(connHandle[i]);
+    }
+    HOST_CHECK(!TEST_LED_WHITE_ON());
+    HOST_CHECK_EQ(uni_ble_get_conn_count(), 0);
+}
+
+static void TestConnTableFull(void)
+{
+    Boot();
+
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        (void)Connect();
+    }
+    u32 rejects = uni_ble_get_conn_rejects();
+
+    /* a link beyond the table is terminated instead of being left without a server */
+    u16 connHandle = Connect();
+    SimConn *sim = SimGetConn(connHandle);
+    HOST_CHECK(sim != NULL && sim->terminateReason == HCI_ERR_CONN_REJ_LIMITED_RESOURCES);
+    HOST_CHECK_EQ(uni_ble_get_conn_rejects(), rejects + 1);
+    HOST_CHECK_EQ(uni_ble_get_conn_count(), UNI_BLE_MAX_CONN);
+#if !TELINK_BIN_LOG_ENABLE
+    HOST_CHECK_EQ(FakeLogCount("connection table full"), 1);
+#endif /* !TELINK_BIN_LOG_ENABLE */
+
+    /* its disconnect event leaves the links in the table alone */
+    MainLoop();
+    HOST_CHECK(SimGetConn(connHandle) == NULL);
+    HOST_CHECK_EQ(uni_ble_get_conn_count(), UNI_BLE_MAX_CONN);
+#if !TELINK_BIN_LOG_ENABLE
+    HOST_CHECK_EQ(FakeLogCount("disconnect: handle"), 0);
+#endif /* !TELINK_BIN_LOG_ENABLE */
+}
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+
+#if TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE
+static void TestAdvBudgetChurn(void)
+{
+    int held = 0;
+    int resumed = 0;
+    u32 holdLogs = 0;
+
+    Boot();
+
+    /* every restart runs an advertising event at once, churn alone would exceed the budget */
+    for (int i = 0; i < 1000; i++) {
+        Disconnect(Connect());
+        held |= !g_sim.advEnabled;
+        resumed |= held && g_sim.advEnabled;
+        RunMs(20);
+        holdLogs += FakeLogCount("adv held");
+        FakeLogClear();
+    }
+
+    /* allow one advertising event of overshoot per budget window */
+    HOST_CHECK(SimAdvDutyPermille() <= TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE + 5);
+    HOST_CHECK(held);
+    HOST_CHECK(resumed);
+#if !TELINK_BIN_LOG_ENABLE
+    HOST_CHECK(holdLogs >= 1);
+#else
+    UNUSED(holdLogs);
+#endif /* !TELINK_BIN_LOG_ENABLE */
+}
+#endif /* TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE */
+
+static void TestAdvParamFail(void)
+{
+    Boot();
+
+    u16 connHandle = Connect();
+    g_sim.advParamFail = HCI_ERR_CONTROLLER_BUSY;
+    Disconnect(connHandle);
+    HOST_CHECK(!g_sim.advEnabled);
+
+    /* retried after a second */
+    RunMs(900);
+    HOST_CHECK(!g_sim.advEnabled);
+    RunMs(200);
+    HOST_CHECK(g_sim.advEnabled);
+    HOST_CHECK_EQ(g_sim.advIntervalMin, ADV_INTERVAL_30MS);
+
+    /* a retry still pending when the table fills up must not restart advertising */
+    connHandle = Connect();
+    g_sim.advParamFail = HCI_ERR_CONTROLLER_BUSY;
+    Disconnect(connHandle);
+    HOST_CHECK(!g_sim.advEnabled);
+    for (int i = 0; i < UNI_BLE_MAX_CONN; i++) {
+        (void)Connect();
+    }
+    RunMs(2000);
+    HOST_CHECK(!g_sim.advEnabled);
+}
+
+#if TELINK_BLE_ADV_SCHEDULER_ENABLE
+/**
+ * @brief      Time-to-connect is measured from the start of fast advertising, a fast request keeps that reference
+ */
+static void TestAdvRequestFast(void)
+{
+    AppAdvStats stats;
+
+    Boot();
+    HOST_CHECK_EQ(g_sim.advIntervalMin, ADV_INTERVAL_30MS);
+
+    RunMs(100);
+    u16 connHandle = Connect();
+    Disconnect(connHandle);
+
+    /* fast, then slow once the fast phase is over, then fast again on request */
+    RunMs(TELINK_BLE_ADV_FAST_MS + 500);
+    HOST_CHECK(g_sim.advIntervalMin > ADV_INTERVAL_35MS);
+    AppAdvRequestFast();
+    HOST_CHECK(g_sim.advEnabled);
+    HOST_CHECK_EQ(g_sim.advIntervalMin, ADV_INTERVAL_30MS);
+    RunMs(200);
+    connHandle = Connect();
+    Disconnect(connHandle);
+
+    /* a connection in the slow phase */
+    RunMs(TELINK_BLE_ADV_FAST_MS + 300);
+    connHandle = Connect();
+
+    AppAdvGetStats(&stats);
+    HOST_CHECK_EQ(stats.connects, 3);
+    HOST_CHECK_EQ(stats.ttcMinMs, 100);
+    HOST_CHECK_EQ(stats.ttcMaxMs, TELINK_BLE_ADV_FAST_MS + 700);
+    HOST_CHECK_EQ(stats.ttcSumMs, 100 + (TELINK_BLE_ADV_FAST_MS + 700) + (TELINK_BLE_ADV_FAST_MS + 300));
+    HOST_CHECK_EQ(stats.phaseConnects[0], 2);
+    HOST_CHECK_EQ(stats.phaseConnects[1], 1);
+
+#if TELINK_BLE_DIAG_ENABLE
+    AppAdvStats read;
+    memset(&read, 0, sizeof(read));
+    HOST_CHECK_EQ(SimAttRead(connHandle, Diag_Adv_DP_H, (u8 *)&read, sizeof(read)), sizeof(read));
+    HOST_CHECK(memcmp(&read, &stats, sizeof(stats)) == 0);
+#endif /* TELINK_BLE_DIAG_ENABLE */
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_ADV_SCHEDULER_ENABLE */
+
+#if TELINK_BLE_CONN_POLICY_ENABLE
+static void TestConnPolicy(void)
+{
+    Boot();
+
+    u16 connHandle = Connect();
+    RunMs(10);
+
+    /* active parameters right after connecting, the central accepts them */
+    SimConn *sim = SimGetConn(connHandle);
+    HOST_CHECK(sim != NULL && sim->paramReqs == 1);
+    HOST_CHECK_EQ(uni_ble_get_conn(connHandle)->interval, 12);
+
+    /* idle parameters once the link has been quiet for TELINK_BLE_CONN_IDLE_AFTER_MS */
+    RunMs(TELINK_BLE_CONN_IDLE_AFTER_MS + 10);
+    HOST_CHECK(sim != NULL && sim->paramReqs == 2);
+    HOST_CHECK_EQ(uni_ble_get_conn(connHandle)->interval, 100);
+    HOST_CHECK_EQ(uni_ble_get_conn(connHandle)->latency, 4);
+
+    /* a write from the central makes the link active again */
+    u8 val = 0;
+    (void)SimAttWrite(connHandle, GenericAttribute_ServiceChanged_CCB_H, &val, sizeof(val));
+    RunMs(10);
+    HOST_CHECK_EQ(uni_ble_get_conn(connHandle)->interval, 12);
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_CONN_POLICY_ENABLE */
+
+#if TELINK_BLE_PHY_POLICY_ENABLE
+static void TestPhyPolicy(void)
+{
+    Boot();
+
+    u16 connHandle = Connect();
+    /* the RSSI average needs a few 500 ms samples to cross the thresholds */
+    SimSetRssi(connHandle, -90);
+    RunMs(4000);
+    HOST_CHECK_EQ(uni_ble_get_conn(connHandle)->txPhy, BLE_PHY_CODED);
+
+    SimSetRssi(connHandle, -50);
+    RunMs(2000);
+    HOST_CHECK(uni_ble_get_conn(connHandle)->txPhy != BLE_PHY_CODED);
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_PHY_POLICY_ENABLE */
+
+static void TestDeviceInformation(void)
+{
+    u8 buf[64];
+
+    Boot();
+
+    u16 connHandle = Connect();
+    int len = SimAttRead(connHandle, DeviceInformation_Manufacturer_DP_H, buf, sizeof(buf));
+    HOST_CHECK_EQ(len, 6);
+    HOST_CHECK(len == 6 && memcmp(buf, "Telink", 6) == 0);
+
+    len = SimAttRead(connHandle, GenericAccess_DeviceName_DP_H, buf, sizeof(buf));
+    HOST_CHECK(len == 7 && memcmp(buf, "eSample", 7) == 0);
+
+    Disconnect(connHandle);
+}
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+static void BenchCtrl(u16 connHandle, u8 op, u8 arg)
+{
+    u8 cmd[2] = {op, arg};
+
+    (void)SimAttWrite(connHandle, Bench_Ctrl_DP_H, cmd, sizeof(cmd));
+}
+
+static void BenchResult(u16 connHandle, AppBenchResult *result)
+{
+    memset(result, 0, sizeof(*result));
+    (void)SimAttRead(connHandle, Bench_Ctrl_DP_H, (u8 *)result, sizeof(*result));
+}
+
+/**
+ * @brief      The stream only notifies while the client has subscribed through the CCC descriptor
+ */
+static void TestBenchCcc(void)
+{
+    u8 ccc[2] = {1, 0};
+    u8 ping = APP_BENCH_OP_PING;
+
+    Boot();
+
+    u16 connHandle = Connect();
+    SimConn *sim = SimGetConn(connHandle);
+    BenchCtrl(connHandle, APP_BENCH_OP_START_TX, 0);
+    (void)SimAttWrite(connHandle, Bench_Ctrl_DP_H, &ping, sizeof(ping));
+    RunMs(100);
+    HOST_CHECK(sim != NULL && sim->notifyOk == 0);
+
+    (void)SimAttWrite(connHandle, Bench_Tx_CCB_H, ccc, sizeof(ccc));
+    RunMs(100);
+    HOST_CHECK(sim != NULL && sim->notifyOk > 0);
+    HOST_CHECK(sim != NULL && sim->notifyNoCcc == 0);
+
+    /* unsubscribing stops the stream again */
+    ccc[0] = 0;
+    (void)SimAttWrite(connHandle, Bench_Tx_CCB_H, ccc, sizeof(ccc));
+    u32 notifyOk = sim ? sim->notifyOk : 0;
+    RunMs(100);
+    HOST_CHECK(sim != NULL && sim->notifyOk == notifyOk);
+
+    BenchCtrl(connHandle, APP_BENCH_OP_STOP_TX, 0);
+    Disconnect(connHandle);
+}
+
+/**
+ * @brief      Bytes/s, packets per connection event and round-trip time against what the simulated controller saw
+ */
+static void TestBenchAccounting(void)
+{
+    AppBenchResult result;
+    u8 ccc[2] = {1, 0};
+    u8 sink[20] = {0};
+    u8 ping = APP_BENCH_OP_PING;
+
+    Boot();
+
+    /* 7.5 ms interval kept by the central, 6 packets per connection event */
+    g_sim.acceptParamReq = 0;
+    u16 connHandle = SimConnect(6, 0, TEST_CONN_TIMEOUT);
+    MainLoop();
+    g_sim.packetsPerEvent = 6;
+    SimConn *sim = SimGetConn(connHandle);
+    (void)SimAttWrite(connHandle, Bench_Tx_CCB_H, ccc, sizeof(ccc));
+    (void)SimAttWrite(connHandle, Bench_Ctrl_CCB_H, ccc, sizeof(ccc));
+
+    BenchCtrl(connHandle, APP_BENCH_OP_START_TX, 0);
+    u32 notifyBytes = sim ? sim->notifyBytes : 0;
+    for (int i = 0; i < 50; i++) {
+        (void)SimAttWrite(connHandle, Bench_Rx_DP_H, sink, sizeof(sink));
+    }
+    RunMs(1000);
+    BenchCtrl(connHandle, APP_BENCH_OP_STOP_TX, 0);
+    BenchResult(connHandle, &result);
+
+    /* the window restarts at the switch to 2M PHY the stream asks for */
+    HOST_CHECK(result.elapsedMs >= 990 && result.elapsedMs <= 1000);
+    HOST_CHECK_EQ(result.rxBytesPerSec, 50 * sizeof(sink));
+    HOST_CHECK_EQ(result.txBytesPerSec, sim ? sim->notifyBytes - notifyBytes : 0);
+    /* fixed point x100, the FIFO is primed before the first connection event */
+    HOST_CHECK(result.txPacketsPerConnEvt >= 600 && result.txPacketsPerConnEvt <= 615);
+    HOST_CHECK(sim != NULL && sim->notifyNoCcc == 0);
+
+    /* the device pings on a 1-byte write, the host echoes the sequence number 5 ms later */
+    RunMs(10);
+    BenchCtrl(connHandle, APP_BENCH_OP_RESET, 0);
+    (void)SimAttWrite(connHandle, Bench_Ctrl_DP_H, &ping, sizeof(ping));
+    HOST_CHECK(sim != NULL && sim->lastNotifyHandle == Bench_Ctrl_DP_H);
+    RunMs(5);
+    BenchCtrl(connHandle, APP_BENCH_OP_PING, sim ? sim->lastNotifyData[1] : 0);
+    BenchResult(connHandle, &result);
+    HOST_CHECK_EQ(result.rttAvgUs, 5000);
+    HOST_CHECK_EQ(result.rttMinUs, 5000);
+    HOST_CHECK_EQ(result.rttMaxUs, 5000);
+
+    Disconnect(connHandle);
+}
+
+/**
+ * @brief      The app restarts the bench window when the central changes the connection interval
+ */
+static void TestBenchConnUpdate(void)
+{
+    AppBenchResult result;
+    u8 ccc[2] = {1, 0};
+
+    Boot();
+
+    g_sim.acceptParamReq = 0;
+    u16 connHandle = SimConnect(6, 0, TEST_CONN_TIMEOUT);
+    MainLoop();
+    (void)SimAttWrite(connHandle, Bench_Tx_CCB_H, ccc, sizeof(ccc));
+    BenchCtrl(connHandle, APP_BENCH_OP_START_TX, 0);
+    RunMs(500);
+
+    SimConnUpdate(connHandle, 24, 0, TEST_CONN_TIMEOUT);
+    RunMs(300);
+    BenchCtrl(connHandle, APP_BENCH_OP_STOP_TX, 0);
+    BenchResult(connHandle, &result);
+
+    /* only the time since the update counts, at 30 ms instead of 7.5 ms per connection event */
+    HOST_CHECK(result.elapsedMs >= 295 && result.elapsedMs <= 300);
+
+    Disconnect(connHandle);
+}
+
+static void TestBenchStream(void)
+{
+    AppBenchResult result;
+    u8 ccc[2] = {1, 0};
+
+    Boot();
+
+    u16 connHandle = Connect();
+    (void)SimAttWrite(connHandle, Bench_Tx_CCB_H, ccc, sizeof(ccc));
+    BenchCtrl(connHandle, APP_BENCH_OP_START_TX, 0);
+    RunMs(1000);
+    BenchCtrl(connHandle, APP_BENCH_OP_STOP_TX, 0);
+    BenchResult(connHandle, &result);
+
+    SimConn *sim = SimGetConn(connHandle);
+    HOST_CHECK(sim != NULL && sim->notifyOk > 0);
+    HOST_CHECK(sim != NULL && sim->lastNotifyHandle == Bench_Tx_DP_H);
+    HOST_CHECK(result.txBytesPerSec > 0);
+    /* the window restarts at the switch to 2M PHY the stream asks for */
+    HOST_CHECK(result.elapsedMs >= 990 && result.elapsedMs <= 1000);
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+#define NOTIFY_TEST_RECORD_HDR_LEN  4
+#define NOTIFY_TEST_MAX_PKTS        64
+
+/* Notifications accepted by the simulated TX FIFO and the notify queue callbacks */
+static struct {
+    u16 attHandle[NOTIFY_TEST_MAX_PKTS];
+    u16 len[NOTIFY_TEST_MAX_PKTS];
+    u8 data[NOTIFY_TEST_MAX_PKTS][244];
+    int count;
+    int congested;
+    int released;
+    int sent;
+} g_notify;
+
+static void NotifyRecord(u16 connHandle, u16 attHandle, const u8 *p, u16 len)
+{
+    UNUSED(connHandle);
+
+    if (g_notify.count < NOTIFY_TEST_MAX_PKTS) {
+        g_notify.attHandle[g_notify.count] = attHandle;
+        g_notify.len[g_notify.count] = len;
+        memcpy(g_notify.data[g_notify.count], p, len);
+    }
+    g_notify.count++;
+}
+
+static void NotifyBackpressure(u16 connHandle, bool congested)
+{
+    UNUSED(connHandle);
+
+    if (congested) {
+        g_notify.congested++;
+    } else {
+        g_notify.released++;
+    }
+}
+
+static void NotifySent(u16 connHandle, u16 attHandle, u16 len)
+{
+    UNUSED(connHandle);
+    UNUSED(attHandle);
+    UNUSED(len);
+
+    g_notify.sent++;
+}
+
+/**
+ * @brief      Connect and replace the application's notify queue callbacks by the recorders above
+ * @param[in]  batching  coalesce writes to the same attribute
+ * @param[in]  mtu       ATT MTU of the link
+ * @return     connection handle
+ */
+static u16 NotifySetup(bool batching, u16 mtu)
+{
+    uni_ble_notify_cfg_t cfg = {
+        .batching = batching,
+        .backpressure = NotifyBackpressure,
+        .sent = NotifySent,
+    };
+
+    Boot();
+    u16 connHandle = Connect();
+    SimGetConn(connHandle)->mtu = mtu;
+    uni_ble_notify_init(&cfg);
+    memset(&g_notify, 0, sizeof(g_notify));
+    g_sim.notifyHook = NotifyRecord;
+
+    return connHandle;
+}
+
+static void NotifyFill(u8 *data, u16 len, u32 seed)
+{
+    for (u16 i = 0; i < len; i++) {
+        data[i] = (u8)(seed * 31 + i);
+    }
+}
+
+/**
+ * @brief      Records wrap around the end of the ring, headers included, and are split at the MTU
+ */
+static void TestNotifyWrapSplit(void)
+{
+    u16 connHandle = NotifySetup(false, 23);
+    SimConn *sim = SimGetConn(connHandle);
+    u8 data[80];
+    u8 expect[80];
+    u32 pos = 0;
+    int hdrWrapped = 0;
+    int dataWrapped = 0;
+
+    for (u32 r = 0; r < 200; r++) {
+        u16 len = (u16)(r * 37 % 80) + 1;
+        u16 handle = (r & 1) ? GenericAttribute_ServiceChanged_DP_H : DeviceInformation_Manufacturer_DP_H;
+        NotifyFill(data, len, r);
+        HOST_CHECK(uni_ble_notify_queue(connHandle, handle, data, len));
+
+        u32 offset = pos % TELINK_BLE_NOTIFY_QUEUE_SIZE;
+        hdrWrapped |= offset + NOTIFY_TEST_RECORD_HDR_LEN > TELINK_BLE_NOTIFY_QUEUE_SIZE;
+        dataWrapped |= offset + NOTIFY_TEST_RECORD_HDR_LEN < TELINK_BLE_NOTIFY_QUEUE_SIZE &&
+                       offset + NOTIFY_TEST_RECORD_HDR_LEN + len > TELINK_BLE_NOTIFY_QUEUE_SIZE;
+        pos += NOTIFY_TEST_RECORD_HDR_LEN + len;
+
+        /* every write goes out on its own, in MTU - 3 sized pieces */
+        g_notify.count = 0;
+        while (uni_ble_notify_pending(connHandle) != 0 && g_notify.count < NOTIFY_TEST_MAX_PKTS) {
+            sim->txFifo = 0;
+            uni_ble_notify_tick();
+        }
+        HOST_CHECK_EQ(g_notify.count, (len + 19) / 20);
+
+        u16 got = 0;
+        for (int i = 0; i < g_notify.count && i < NOTIFY_TEST_MAX_PKTS; i++) {
+            HOST_CHECK_EQ(g_notify.attHandle[i], handle);
+            HOST_CHECK_EQ(g_notify.len[i], min(len - got, 20));
+            memcpy(expect + got, g_notify.data[i], g_notify.len[i]);
+            got += g_notify.len[i];
+        }
+        HOST_CHECK(got == len && memcmp(expect, data, len) == 0);
+    }
+
+    /* the scenario crossed the end of the ring inside a header and inside the data */
+    HOST_CHECK(hdrWrapped);
+    HOST_CHECK(dataWrapped);
+
+    Disconnect(connHandle);
+}
+
+/**
+ * @brief      Batching packs consecutive writes to one attribute up to MTU - 3, another attribute starts a new packet
+ */
+static void TestNotifyBatching(void)
+{
+    u16 connHandle = NotifySetup(true, 23);
+    SimConn *sim = SimGetConn(connHandle);
+    u16 h1 = DeviceInformation_Manufacturer_DP_H;
+    u16 h2 = GenericAttribute_ServiceChanged_DP_H;
+    u8 stream[40];
+
+    NotifyFill(stream, sizeof(stream), 7);
+    HOST_CHECK(uni_ble_notify_queue(connHandle, h1, stream, 5));
+    HOST_CHECK(uni_ble_notify_queue(connHandle, h1, stream + 5, 5));
+    HOST_CHECK(uni_ble_notify_queue(connHandle, h1, stream + 10, 15));
+    HOST_CHECK(uni_ble_notify_queue(connHandle, h2, stream + 25, 4));
+    HOST_CHECK(uni_ble_notify_queue(connHandle, h1, stream + 29, 3));
+
+    sim->txFifo = 0;
+    uni_ble_notify_tick();
+
+    /* three writes fill one packet, the rest of the third is cut at the next attribute */
+    HOST_CHECK(g_notify.count >= 2);
+    HOST_CHECK(g_notify.attHandle[0] == h1 && g_notify.len[0] == 20 && memcmp(g_notify.data[0], stream, 20) == 0);
+    HOST_CHECK(g_notify.attHandle[1] == h1 && g_notify.len[1] == 5 && memcmp(g_notify.data[1], stream + 20, 5) == 0);
+
+    /* the short packets behind it wait for the TX FIFO to drain */
+    HOST_CHECK_EQ(g_notify.count, 2);
+    sim->txFifo = 0;
+    uni_ble_notify_tick();
+    HOST_CHECK_EQ(g_notify.count, 4);
+    HOST_CHECK(g_notify.attHandle[2] == h2 && g_notify.len[2] == 4 && memcmp(g_notify.data[2], stream + 25, 4) == 0);
+    HOST_CHECK(g_notify.attHandle[3] == h1 && g_notify.len[3] == 3 && memcmp(g_notify.data[3], stream + 29, 3) == 0);
+    HOST_CHECK_EQ(g_notify.sent, 4);
+    HOST_CHECK_EQ(uni_ble_notify_pending(connHandle), 0);
+
+    Disconnect(connHandle);
+}
+
+/**
+ * @brief      With batching a short packet is held while NOTIFY_HOLD_FIFO_NUM packets are in the TX FIFO
+ */
+static void TestNotifyNagle(void)
+{
+    u16 connHandle = NotifySetup(true, 23);
+    SimConn *sim = SimGetConn(connHandle);
+    u16 handle = DeviceInformation_Manufacturer_DP_H;
+    u8 data[20];
+
+    NotifyFill(data, sizeof(data), 3);
+
+    /* two packets in flight: 10 bytes wait for more */
+    sim->txFifo = 2;
+    HOST_CHECK(uni_ble_notify_queue(connHandle, handle, data, 10));
+    uni_ble_notify_tick();
+    HOST_CHECK_EQ(g_notify.count, 0);
+
+    /* a full packet goes out regardless */
+    HOST_CHECK(uni_ble_notify_queue(connHandle, handle, data + 10, 10));
+    uni_ble_notify_tick();
+    HOST_CHECK_EQ(g_notify.count, 1);
+    HOST_CHECK(g_notify.len[0] == 20 && memcmp(g_notify.data[0], data, 20) == 0);
+
+    /* one packet in flight: a short one is sent at once */
+    sim->txFifo = 1;
+    HOST_CHECK(uni_ble_notify_queue(connHandle, handle, data, 5));
+    uni_ble_notify_tick();
+    HOST_CHECK_EQ(g_notify.count, 2);
+    HOST_CHECK_EQ(g_notify.len[1], 5);
+
+    /* without batching nothing is held */
+    uni_ble_notify_set_batching(false);
+    sim->txFifo = 3;
+    HOST_CHECK(uni_ble_notify_queue(connHandle, handle, data, 5));
+    uni_ble_notify_tick();
+    HOST_CHECK_EQ(g_notify.count, 3);
+
+    Disconnect(connHandle);
+}
+
+/**
+ * @brief      The backpressure callback fires when a write does not fit and releases at half the queue size
+ */
+static void TestNotifyBackpressure(void)
+{
+    u16 connHandle = NotifySetup(false, 247);
+    SimConn *sim = SimGetConn(connHandle);
+    u16 handle = DeviceInformation_Manufacturer_DP_H;
+    u8 capacity = g_sim.txFifoNum - 1;
+    u8 data[100];
+    int queued = 0;
+
+    NotifyFill(data, sizeof(data), 5);
+
+    /* TX FIFO full: nothing drains */
+    sim->txFifo = capacity;
+    while (uni_ble_notify_queue(connHandle, handle, data, sizeof(data))) {
+        queued++;
+        uni_ble_notify_tick();
+    }
+    HOST_CHECK_EQ(queued, TELINK_BLE_NOTIFY_QUEUE_SIZE / (NOTIFY_TEST_RECORD_HDR_LEN + sizeof(data)));
+    HOST_CHECK_EQ(g_notify.congested, 1);
+    HOST_CHECK_EQ(g_notify.released, 0);
+    HOST_CHECK_EQ(g_notify.count, 0);
+
+    /* released once no more than half of the queue is in use */
+    int sentRecords = 0;
+    while (g_notify.released == 0 && sentRecords < queued) {
+        sim->txFifo = capacity - 1;
+        uni_ble_notify_tick();
+        sentRecords++;
+        u16 pending = uni_ble_notify_pending(connHandle);
+        HOST_CHECK_EQ(g_notify.released, pending <= TELINK_BLE_NOTIFY_QUEUE_SIZE / 2);
+    }
+    HOST_CHECK_EQ(g_notify.released, 1);
+    HOST_CHECK_EQ(g_notify.count, sentRecords);
+    HOST_CHECK_EQ(uni_ble_notify_pending(connHandle),
+                  (queued - sentRecords) * (NOTIFY_TEST_RECORD_HDR_LEN + sizeof(data)));
+    HOST_CHECK(uni_ble_notify_queue(connHandle, handle, data, sizeof(data)));
+    HOST_CHECK_EQ(g_notify.congested, 1);
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+#if TELINK_BLE_DIAG_ENABLE
+/* LLIDs of LL data PDUs: continuation and start of an L2CAP SDU */
+#define TEST_LLID_CONTINUE  0x01
+#define TEST_LLID_START     0x02
+
+static void DiagRx(u16 connHandle, u8 llid, u16 l2capLen)
+{
+    rf_packet_l2cap_t pkt;
+
+    memset(&pkt, 0, sizeof(pkt));
+    pkt.type = llid;
+    pkt.l2capLen = l2capLen;
+    (void)SimL2capRx(connHandle, (u8 *)&pkt);
+}
+
+/**
+ * @brief      Buffer counters with the FIFOs filled by the simulated controller, and their diagnostics read
+ */
+static void TestDiagBuffers(void)
+{
+    uni_ble_diag_t diag;
+    uni_ble_diag_t read;
+
+    Boot();
+    /* keep the 30 ms interval of the central */
+    g_sim.acceptParamReq = 0;
+    u16 connHandle = Connect();
+    SimConn *sim = SimGetConn(connHandle);
+
+    /* TX FIFO filled and nothing acknowledged: a stall per connection interval without progress */
+    g_sim.packetsPerEvent = 0;
+    sim->txFifo = ACL_TX_FIFO_NUM - 1;
+    RunMs(TEST_CONN_INTERVAL * 1250 / 1000 * 3 + 5);
+    HOST_CHECK(uni_ble_diag_get(connHandle, &diag));
+    HOST_CHECK_EQ(diag.txFifoPeak, ACL_TX_FIFO_NUM - 1);
+    HOST_CHECK_EQ(diag.txStalls, 3);
+
+    /* draining again counts no more stalls */
+    g_sim.packetsPerEvent = 1;
+    RunMs(TEST_CONN_INTERVAL * 1250 / 1000 * 3);
+    HOST_CHECK_EQ(sim->txFifo, ACL_TX_FIFO_NUM - 4);
+    HOST_CHECK(uni_ble_diag_get(connHandle, &diag));
+    HOST_CHECK_EQ(diag.txStalls, 3);
+
+    /* every RX FIFO entry used between two main loop passes, then one less */
+    for (int i = 0; i < ACL_RX_FIFO_NUM; i++) {
+        DiagRx(connHandle, TEST_LLID_START, 7);
+    }
+    MainLoop();
+    for (int i = 0; i < ACL_RX_FIFO_NUM - 1; i++) {
+        DiagRx(connHandle, TEST_LLID_START, 7);
+    }
+    MainLoop();
+    HOST_CHECK(uni_ble_diag_get(connHandle, &diag));
+    HOST_CHECK_EQ(diag.rxFifoPeak, ACL_RX_FIFO_NUM);
+    HOST_CHECK_EQ(diag.rxFifoFull, 1);
+
+    /* an SDU split over a start and two continuation fragments */
+    DiagRx(connHandle, TEST_LLID_START, 100);
+    DiagRx(connHandle, TEST_LLID_CONTINUE, 0);
+    DiagRx(connHandle, TEST_LLID_CONTINUE, 0);
+    MainLoop();
+    HOST_CHECK(uni_ble_diag_get(connHandle, &diag));
+    HOST_CHECK_EQ(diag.rxFragments, 2);
+    HOST_CHECK_EQ(diag.rxSduPeak, 100);
+    HOST_CHECK_EQ(diag.rxPackets, ACL_RX_FIFO_NUM * 2 - 1 + 3);
+
+    /* the characteristic serves the same counters, plus the read request itself */
+    HOST_CHECK_EQ(SimAttRead(connHandle, Diag_Buffers_DP_H, (u8 *)&read, sizeof(read)), sizeof(read));
+    diag.rxPackets++;
+    HOST_CHECK(memcmp(&read, &diag, sizeof(diag)) == 0);
+
+    /* once the link is gone the read is all zeros, not the counters of the last read */
+    Disconnect(connHandle);
+    HOST_CHECK(!uni_ble_diag_get(connHandle, &diag));
+    memset(&read, 0xff, sizeof(read));
+    HOST_CHECK_EQ(SimAttRead(connHandle, Diag_Buffers_DP_H, (u8 *)&read, sizeof(read)), sizeof(read));
+    memset(&diag, 0, sizeof(diag));
+    HOST_CHECK(memcmp(&read, &diag, sizeof(diag)) == 0);
+}
+
+/**
+ * @brief      A write PDU too short for its opcode and handle is refused before any handler runs
+ */
+static void TestAttShortWrite(void)
+{
+    u8 buf[sizeof(rf_packet_att_write_t) + 4];
+    rf_packet_att_write_t *pkt = (rf_packet_att_write_t *)buf;
+    u8 op = 0x04;
+
+    Boot();
+    u16 connHandle = Connect();
+
+    memset(buf, 0, sizeof(buf));
+    pkt->rf_len = 6;
+    pkt->l2capLen = 2;
+    pkt->chanId = L2CAP_CID_ATTR_PROTOCOL;
+    pkt->opcode = ATT_OP_WRITE_REQ;
+    pkt->handle = U16_LO(Diag_Ctrl_DP_H);
+    pkt->handle1 = U16_HI(Diag_Ctrl_DP_H);
+    HOST_CHECK_EQ(SimL2capRx(connHandle, buf), ATT_ERR_INVALID_PDU);
+
+    /* a complete write still reaches the handler */
+    HOST_CHECK_EQ(SimAttWrite(connHandle, Diag_Ctrl_DP_H, &op, sizeof(op)), 0);
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_DIAG_ENABLE */
+
+#if TELINK_BLE_DIAG_ENABLE && TELINK_BLE_TRACE_ENABLE
+/**
+ * @brief      The dump requested over the diagnostics control point runs from MainLoop, not in the ATT callback
+ */
+static void TestTraceDumpDeferred(void)
+{
+    u8 op = 0x03;
+
+    BleTraceInit();
+    Boot();
+
+    u16 connHandle = Connect();
+    RunMs(10);
+    (void)SimAttWrite(connHandle, Diag_Ctrl_DP_H, &op, sizeof(op));
+    HOST_CHECK(g_bleTrace.head != 0);
+
+    MainLoop();
+    HOST_CHECK_EQ(g_bleTrace.head, 0);
+    HOST_CHECK(g_bleTrace.enabled);
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_DIAG_ENABLE && TELINK_BLE_TRACE_ENABLE */
+
+#if TELINK_BLE_DIAG_ENABLE && CYCLE_PROF_ENABLE
+static void TestProfDump(void)
+{
+    u8 op = 0x01;
+
+    Boot();
+
+    u16 connHandle = Connect();
+    RunMs(100);
+    FakeLogClear();
+    (void)SimAttWrite(connHandle, Diag_Ctrl_DP_H, &op, sizeof(op));
+
+    /* a summary line per point and PROF_HIST_PER_LINE buckets per histogram line */
+    HOST_CHECK_EQ(FakeLogCount("prof sdk_main_loop: n "), 1);
+    const char *line = FakeLogFind("prof sdk_main_loop 2^");
+    HOST_CHECK(line != NULL);
+    int fields = 0;
+    for (const char *p = line ? strchr(line, ':') : NULL; p != NULL; p = strchr(p + 1, ' ')) {
+        fields++;
+    }
+    HOST_CHECK_EQ(fields, 4 + 1);
+
+    Disconnect(connHandle);
+}
+#endif /* TELINK_BLE_DIAG_ENABLE && CYCLE_PROF_ENABLE */
+
+static void RunTests(void)
+{
+    HOST_RUN(TestBoot);
+#if TELINK_BLE_DEEP_RETENTION_ENABLE
+    HOST_RUN(TestRetentionWake);
+#endif /* TELINK_BLE_DEEP_RETENTION_ENABLE */
+    HOST_RUN(TestConnectDisconnect);
+#if TELINK_SDK_B91_BLE_MULTI
+    HOST_RUN(TestMultiLink);
+    HOST_RUN(TestConnTableFull);
+#endif /* TELINK_SDK_B91_BLE_MULTI */
+#if TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE
+    HOST_RUN(TestAdvBudgetChurn);
+#endif /* TELINK_BLE_ADV_DUTY_BUDGET_PERMILLE */
+    HOST_RUN(TestAdvParamFail);
+#if TELINK_BLE_ADV_SCHEDULER_ENABLE
+    HOST_RUN(TestAdvRequestFast);
+#endif /* TELINK_BLE_ADV_SCHEDULER_ENABLE */
+#if TELINK_BLE_CONN_POLICY_ENABLE
+    HOST_RUN(TestConnPolicy);
+#endif /* TELINK_BLE_CONN_POLICY_ENABLE */
+#if TELINK_BLE_PHY_POLICY_ENABLE
+    HOST_RUN(TestPhyPolicy);
+#endif /* TELINK_BLE_PHY_POLICY_ENABLE */
+    HOST_RUN(TestDeviceInformation);
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+    HOST_RUN(TestBenchCcc);
+    HOST_RUN(TestBenchAccounting);
+    HOST_RUN(TestBenchConnUpdate);
+    HOST_RUN(TestBenchStream);
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+    HOST_RUN(TestNotifyWrapSplit);
+    HOST_RUN(TestNotifyBatching);
+    HOST_RUN(TestNotifyNagle);
+    HOST_RUN(TestNotifyBackpressure);
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE
+    HOST_RUN(TestDiagBuffers);
+    HOST_RUN(TestAttShortWrite);
+#endif /* TELINK_BLE_DIAG_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE && TELINK_BLE_TRACE_ENABLE
+    HOST_RUN(TestTraceDumpDeferred);
+#endif /* TELINK_BLE_DIAG_ENABLE && TELINK_BLE_TRACE_ENABLE */
+#if TELINK_BLE_DIAG_ENABLE && CYCLE_PROF_ENABLE
+    HOST_RUN(TestProfDump);
+#endif /* TELINK_BLE_DIAG_ENABLE && CYCLE_PROF_ENABLE */
+}
+
+#define BENCH_SIM_MS        10000
+/* 7.5 ms connection interval of the streaming benchmark */
+#define BENCH_CONN_INTERVAL_US  7500
+#define BENCH_QUEUED_WRITE_LEN  20
+#define BENCH_NS_PER_SEC    1000000000ULL
+
+static u64 NowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec * BENCH_NS_PER_SEC + (u64)ts.tv_nsec;
+}
+
+/**
+ * @brief      Host CPU time of MainLoop() while idle and connected, and the simulated notify throughput
+ */
+static void RunBench(void)
+{
+    Boot();
+
+    u64 start = NowNs();
+    RunMs(BENCH_SIM_MS);
+    u64 idleNs = NowNs() - start;
+    printf("bench: advertising MainLoop %llu ns/iteration\n", (unsigned long long)(idleNs / BENCH_SIM_MS));
+
+#if TELINK_BLE_BENCH_SERVICE_ENABLE
+    AppBenchResult result;
+    u8 ccc[2] = {1, 0};
+
+    /* 7.5 ms interval, 6 packets per connection event */
+    u16 connHandle = SimConnect(BENCH_CONN_INTERVAL_US / 1250, 0, TEST_CONN_TIMEOUT);
+    g_sim.acceptParamReq = 0;
+    g_sim.packetsPerEvent = 6;
+    MainLoop();
+    (void)SimAttWrite(connHandle, Bench_Tx_CCB_H, ccc, sizeof(ccc));
+    BenchCtrl(connHandle, APP_BENCH_OP_START_TX, 0);
+
+    start = NowNs();
+    RunMs(BENCH_SIM_MS);
+    u64 streamNs = NowNs() - start;
+
+    BenchResult(connHandle, &result);
+    printf("bench: streaming MainLoop %llu ns/iteration, %u bytes/s, %u.%02u packets/conn event\n",
+           (unsigned long long)(streamNs / BENCH_SIM_MS), (unsigned)result.txBytesPerSec,
+           (unsigned)(result.txPacketsPerConnEvt / 100), (unsigned)(result.txPacketsPerConnEvt % 100));
+
+#if TELINK_BLE_NOTIFY_QUEUE_ENABLE
+    /* the APP_BENCH_OP_START_QUEUED path: small writes packed into MTU sized notifications or sent one by one */
+    for (int batching = 1; batching >= 0; batching--) {
+        u8 cmd[3] = {APP_BENCH_OP_START_QUEUED, BENCH_QUEUED_WRITE_LEN, (u8)batching};
+
+        (void)SimAttWrite(connHandle, Bench_Ctrl_DP_H, cmd, sizeof(cmd));
+        RunMs(BENCH_SIM_MS);
+        BenchResult(connHandle, &result);
+
+        u32 bytesPerEvt = result.txBytesPerSec * BENCH_CONN_INTERVAL_US / 1000000;
+        u32 bytesPerPacket = result.txPacketsPerConnEvt ? bytesPerEvt * 100 / result.txPacketsPerConnEvt : 0;
+        printf("bench: queued %u byte writes, batching %s: %u bytes/s, %u.%02u packets/conn event, %u bytes/packet\n",
+               BENCH_QUEUED_WRITE_LEN, batching ? "on" : "off", (unsigned)result.txBytesPerSec,
+               (unsigned)(result.txPacketsPerConnEvt / 100), (unsigned)(result.txPacketsPerConnEvt % 100),
+               (unsigned)bytesPerPacket);
+    }
+#endif /* TELINK_BLE_NOTIFY_QUEUE_ENABLE */
+
+    BenchCtrl(connHandle, APP_BENCH_OP_STOP_TX, 0);
+    Disconnect(connHandle);
+#endif /* TELINK_BLE_BENCH_SERVICE_ENABLE */
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        RunBench();
+        return 0;
+    }
+
+    RunTests();
+
+    return HOST_RESULT(argv[0]);
+}